@@ -7,6 +7,67 @@
 // Macros to enable/disable global interrupts
 #define enable_interrupts() asm(" cpsie i ")
 #define disable_interrupts() asm(" cpsid i ")
+// Macros to save & restore the global interrupt mask, Doc: PM0214-2.1.3
+#define save_and_disable_interrupts(primask) asm volatile(" mrs %0, primask \n cpsid i " : "=r" (primask) : : "memory")
+#define restore_interrupts(primask) asm volatile(" msr primask, %0 " : : "r" (primask) : "memory")
+// Macro to order memory accesses across it for the other bus masters & the compiler, Doc: PM0214-3.10.3
+#define memory_barrier() asm volatile(" dmb " : : : "memory")
 // macro for putting the CPU in to sleep mode
 #define cpu_sleep() asm(" wfi ")
 // Some useful bitmasks
+
+
+#include <stdint.h>
+
+// Nested Vectored Interrupt Controller, Doc: PM0214-4.3
+typedef struct {
+	__IOM uint32_t ISER[8U];        // Interrupt Set Enable Register
+	uint32_t RESERVED0[24U];
+	__IOM uint32_t ICER[8U];        // Interrupt Clear Enable Register
+	uint32_t RESERVED1[24U];
+	__IOM uint32_t ISPR[8U];        // Interrupt Set Pending Register
+	uint32_t RESERVED2[24U];
+	__IOM uint32_t ICPR[8U];        // Interrupt Clear Pending Register
+	uint32_t RESERVED3[24U];
+	__IOM uint32_t IABR[8U];        // Interrupt Active bit Register
+	uint32_t RESERVED4[56U];
+	__IOM uint8_t IP[240U];         // Interrupt Priority Register (8Bit wide)
+	uint32_t RESERVED5[644U];
+	__OM uint32_t STIR;             // Software Trigger Interrupt Register
+} NVIC_Type;
+
+#define SCS_BASE (0xE000E000UL)
+#define NVIC_BASE (SCS_BASE + 0x0100UL)
+#define NVIC ((NVIC_Type *) NVIC_BASE)
+
+// Debug exception & monitor control, only DEMCR is used to power the trace blocks, Doc: DDI0403E-C1.6.5
+typedef struct {
+	__IOM uint32_t DHCSR;           // Debug Halting Control and Status Register
+	__OM uint32_t DCRSR;            // Debug Core Register Selector Register
+	__IOM uint32_t DCRDR;           // Debug Core Register Data Register
+	__IOM uint32_t DEMCR;           // Debug Exception and Monitor Control Register
+} CoreDebug_Type;
+
+#define CoreDebug_BASE (0xE000EDF0UL)
+#define CoreDebug ((CoreDebug_Type *) CoreDebug_BASE)
+
+// Data Watchpoint and Trace unit, only the cycle counter is used, Doc: DDI0403E-C1.8.7
+typedef struct {
+	__IOM uint32_t CTRL;            // Control Register
+	__IOM uint32_t CYCCNT;          // Cycle Count Register
+} DWT_Type;
+
+#define DWT_BASE (0xE0001000UL)
+#define DWT ((DWT_Type *) DWT_BASE)
+
+// System Control Block, only the registers up to SCR are used, Doc: PM0214-4.4
+typedef struct {
+	__IM uint32_t CPUID;            // CPUID Base Register
+	__IOM uint32_t ICSR;            // Interrupt Control and State Register
+	__IOM uint32_t VTOR;            // Vector Table Offset Register
+	__IOM uint32_t AIRCR;           // Application Interrupt and Reset Control Register
+	__IOM uint32_t SCR;             // System Control Register
+} SCB_Type;
+
+#define SCB_BASE (SCS_BASE + 0x0D00UL)
+#define SCB ((SCB_Type *) SCB_BASE)
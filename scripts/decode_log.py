@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# Decodes the words Chip::Log::read() copied out, using the CHIP_LOG() format strings in the firmware's ELF
+# Usage: decode_log.py firmware.elf log.bin [--clock HZ]
+#   log.bin is the raw little-endian words, however they were taken off the chip (UART, debugger dump, ...)
+
+import argparse
+import re
+import struct
+import sys
+
+SECTION = '.log_strings'
+ID_MASK = 0x0FFFFFFF
+HEADER_WORDS = 2
+CONVERSION = re.compile(r'%(%|[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z)?[diouxXcfFeEgGp])')
+
+
+def read_section(path, name):
+    with open(path, 'rb') as elf:
+        data = elf.read()
+    if data[:4] != b'\x7fELF':
+        sys.exit(f'{path} is not an ELF file')
+
+    is_64 = data[4] == 2
+    endian = '<' if data[5] == 1 else '>'
+    if is_64:
+        shoff, = struct.unpack_from(endian + 'Q', data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + 'HHH', data, 0x3A)
+        entry = endian + 'IIQQQQIIQQ'
+    else:
+        shoff, = struct.unpack_from(endian + 'I', data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(endian + 'HHH', data, 0x2E)
+        entry = endian + 'IIIIIIIIII'
+
+    sections = [struct.unpack_from(entry, data, shoff + i * shentsize) for i in range(shnum)]
+    names_offset = sections[shstrndx][4]
+    for section in sections:
+        start = names_offset + section[0]
+        if data[start:data.index(b'\0', start)].decode() == name:
+            return data[section[4]:section[4] + section[5]]
+    sys.exit(f'{path} has no {name} section, was it linked with CHIP_LOG() in use?')
+
+
+def read_formats(section):
+    # Each entry is a header word then the format string, 4-byte aligned & possibly padded out with zeros
+    formats = {}
+    offset = 0
+    while offset + 4 <= len(section):
+        header, = struct.unpack_from('<I', section, offset)
+        offset += 4
+        if header == 0:
+            continue
+        end = section.index(b'\0', offset)
+        text = section[offset:end].decode(errors='replace')
+        offset = (end + 4) & ~3
+        if formats.get(header, text) != text:
+            print(f'warning: "{formats[header]}" & "{text}" share ID 0x{header & ID_MASK:07X}', file=sys.stderr)
+        formats[header] = text
+    return formats
+
+
+def convert(specifier, word):
+    if specifier == '%':
+        return '%'
+    kind = specifier[-1]
+    flags = re.sub(r'(hh|h|ll|l|z)', '', specifier[:-1])
+    if kind in 'di':
+        return ('%' + flags + 'd') % struct.unpack('<i', struct.pack('<I', word))[0]
+    if kind in 'fFeEgG':
+        return ('%' + flags + kind) % struct.unpack('<f', struct.pack('<I', word))[0]
+    if kind == 'c':
+        return chr(word & 0xFF)
+    if kind == 'p':
+        return f'0x{word:08X}'
+    return ('%' + flags + kind) % word
+
+
+def decode(formats, words, clock):
+    index = 0
+    while index < len(words):
+        header = words[index]
+        count = header >> 28
+        if index + HEADER_WORDS + count > len(words):
+            print(f'warning: {len(words) - index} words left over', file=sys.stderr)
+            return
+        timestamp = words[index + 1]
+        arguments = iter(words[index + HEADER_WORDS:index + HEADER_WORDS + count])
+        index += HEADER_WORDS + count
+
+        time = f'{timestamp / clock:12.6f}' if clock else f'{timestamp:10d}'
+        if header not in formats:
+            print(f'{time}  <unknown 0x{header & ID_MASK:07X}> ' + ' '.join(f'0x{a:08X}' for a in arguments))
+            continue
+        text = CONVERSION.sub(lambda match: convert(match.group(1), 0 if match.group(1) == '%' else next(arguments)),
+                              formats[header])
+        print(f'{time}  {text}')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decodes CHIP_LOG() records')
+    parser.add_argument('elf')
+    parser.add_argument('log')
+    parser.add_argument('--clock', type=float, default=0, help='core clock in Hz, timestamps in seconds')
+    args = parser.parse_args()
+
+    formats = read_formats(read_section(args.elf, SECTION))
+    with open(args.log, 'rb') as log:
+        data = log.read()
+    words = list(struct.unpack(f'<{len(data) // 4}I', data[:len(data) // 4 * 4]))
+    decode(formats, words, args.clock)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_board.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "stm32g491_chip.hh"
+
+
+
+namespace {
+	// Runs shorter than this are cheaper to store from the CPU than to set up a DMA transfer for
+	const uint16_t MIN_DMA_RUN = 8;
+
+	// Enable bits per bus of the clocks the board holds a reference to
+	uint32_t held_clocks[Chip::Clock::NUM_BUSES] = {};
+
+	// The board holds one reference to every clock in its images, however many times they are applied
+	void acquire_clocks(const uint32_t *const clocks)
+	{
+		for (uint_fast8_t bus = 0; bus < Chip::Clock::NUM_BUSES; bus++) {
+			uint32_t bits = clocks[bus] & ~held_clocks[bus];
+			held_clocks[bus] |= bits;
+			for (uint8_t bit = 0; bits != 0; bit++, bits >>= 1) {
+				if (bits & 1) {
+					Chip::Clock::acquire(static_cast<Chip::Clock::Gate>(
+						Chip::Clock::gate_id(static_cast<Chip::Clock::Bus>(bus), bit)));
+				}
+			}
+		}
+	}
+
+	volatile uint32_t *entry_register(const uint32_t header)
+	{
+		volatile uint32_t *const BASE = Chip::Board::block_address(static_cast<Chip::Board::Block>(header >> 24));
+		return BASE + (header & 0xFFFF) / sizeof(uint32_t);
+	}
+
+	uint16_t entry_count(const uint32_t header)
+	{
+		return static_cast<uint16_t>((header >> 16) & 0xFF);
+	}
+
+	// Applies the masked entry or run starting at words[i], returns the index of the next entry
+	uint32_t apply_entry(const uint32_t *const words, uint32_t i)
+	{
+		const uint32_t HEADER = words[i++];
+		volatile uint32_t *const REGISTER = entry_register(HEADER);
+		const uint16_t COUNT = entry_count(HEADER);
+
+		if (COUNT == 0) {
+			const uint32_t MASK = words[i];
+			const uint32_t VALUE = words[i + 1];
+			Chip::HAL::write_register(REGISTER, (Chip::HAL::read_register(REGISTER) & ~MASK) | VALUE);
+			return i + 2;
+		}
+		for (uint16_t n = 0; n < COUNT; n++) {
+			Chip::HAL::write_register(REGISTER + n, words[i + n]);
+		}
+		return i + COUNT;
+	}
+}
+
+
+
+/*
+ * Board image functions
+ */
+void Chip::Board::apply(const uint32_t *const words, const uint32_t length, const uint32_t *const clocks)
+{
+	acquire_clocks(clocks);
+
+	uint32_t i = 0;
+	while (i < length) {
+		i = apply_entry(words, i);
+	}
+}
+
+
+// Long runs are copied by a memory-to-memory transfer, the CPU applies the short entries of other blocks in the
+// meantime & waits for the run before one of the same block, so a block is still written in address order.
+// A channel something else holds leaves it all to the CPU
+void Chip::Board::apply_dma(const uint32_t *const words, const uint32_t length, const uint32_t *const clocks,
+                            const uint_fast8_t dma_channel)
+{
+	if (!DMA_Class::reserve(dma_channel)) {
+		apply(words, length, clocks);
+		return;
+	}
+	acquire_clocks(clocks);
+
+	// Doc: RM0440-12.4.5 | In memory-to-memory mode the "memory" side is read & the "peripheral" side written
+	const DMA_Class::Transfer_Config_t CONFIG = {
+		.request=DMA_Class::Request::MEM2MEM,
+		.direction=DMA_Class::Direction::MEMORY_TO_PERIPHERAL,
+		.peripheral_width=DMA_Class::Data_Width::WORD,
+		.memory_width=DMA_Class::Data_Width::WORD,
+		.peripheral_increment=true,
+		.memory_increment=true,
+		.mode=DMA_Class::Transfer_Mode::NORMAL,
+		.priority=DMA_Class::Priority::HIGH
+	};
+	DMA_Class::configure(dma_channel, CONFIG);
+
+	bool dma_busy = false;
+	uint32_t dma_block = 0;
+	uint32_t i = 0;
+	while (i < length) {
+		const uint16_t COUNT = entry_count(words[i]);
+		const uint32_t BLOCK = words[i] >> 24;
+		if (COUNT < MIN_DMA_RUN) {
+			while (dma_busy && BLOCK == dma_block && DMA_Class::remaining(dma_channel) != 0) {}
+			i = apply_entry(words, i);
+			continue;
+		}
+
+		while (dma_busy && DMA_Class::remaining(dma_channel) != 0) {}
+		DMA_Class::start(dma_channel, entry_register(words[i]), &words[i + 1], COUNT);
+		dma_busy = true;
+		dma_block = BLOCK;
+		i += 1u + COUNT;
+	}
+
+	while (dma_busy && DMA_Class::remaining(dma_channel) != 0) {}
+	DMA_Class::free(dma_channel);
+}
+
+
+// Drops the board's references, the clocks stop unless a driver still holds them
+void Chip::Board::release_clocks()
+{
+	for (uint_fast8_t bus = 0; bus < Clock::NUM_BUSES; bus++) {
+		uint32_t bits = held_clocks[bus];
+		held_clocks[bus] = 0;
+		for (uint8_t bit = 0; bits != 0; bit++, bits >>= 1) {
+			if (bits & 1) {
+				Clock::release(static_cast<Clock::Gate>(Clock::gate_id(static_cast<Clock::Bus>(bus), bit)));
+			}
+		}
+	}
+}
+
+
+volatile uint32_t *Chip::Board::block_address(const Block block)
+{
+	// Doc: RM0440-2.2.2 | Ports are found by arithmetic, the timers are scattered over both APB buses
+	const uint8_t INDEX = static_cast<uint8_t>(block);
+	if (INDEX <= static_cast<uint8_t>(Block::PORT_G)) {
+		return reinterpret_cast<volatile uint32_t *>(GPIO_Class::port(static_cast<GPIO_Class::Port>(INDEX)));
+	}
+
+	TIM_TypeDef *const TIMERS[] = {TIM1, TIM2, TIM3, TIM4, TIM6, TIM7, TIM8, TIM15, TIM16, TIM17, TIM20};
+	return reinterpret_cast<volatile uint32_t *>(TIMERS[INDEX - static_cast<uint8_t>(Block::TIMER_1)]);
+}
@@ -0,0 +1,261 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_board.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_BOARD_HH
+#define STM32G4_MODULE_LIBRARY_BOARD_HH
+
+#include <cstddef>
+#include <cstdint>
+#include "stm32g491_clock.hh"
+#include "../../peripherals/gpio/gpio.hh"
+
+#ifdef UNIT_TEST
+#include "stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+// Declarative board configuration. A Builder collects pins, clocks & raw register writes at compile time,
+// merges the writes to each register & compiles them into an Image, a flat stream of words replayed by apply().
+//
+// Image stream, one entry after another:
+//     [block:8 | count:8 | offset:16] [value] * count      count consecutive registers written whole
+//     [block:8 |     0:8 | offset:16] [mask] [value]       one register read-modify-written
+//
+// Registers of a block are written in address order, except a port's MODER which comes after the rest of the port so
+// no pin drives before its level, type, pull & alternate function are set. Anything else order dependent (enabling
+// a counter after its prescaler, UG events) belongs in driver code after the image is applied.
+namespace Chip {
+	namespace Board {
+		enum class Block : uint8_t {
+			// Doc: RM0440-2.2.2
+			PORT_A = 0,
+			PORT_B = 1,
+			PORT_C = 2,
+			PORT_D = 3,
+			PORT_E = 4,
+			PORT_F = 5,
+			PORT_G = 6,
+			TIMER_1 = 7,
+			TIMER_2 = 8,
+			TIMER_3 = 9,
+			TIMER_4 = 10,
+			TIMER_6 = 11,
+			TIMER_7 = 12,
+			TIMER_8 = 13,
+			TIMER_15 = 14,
+			TIMER_16 = 15,
+			TIMER_17 = 16,
+			TIMER_20 = 17
+		};
+
+		typedef struct {
+			GPIO_Class::PinId pin;
+			GPIO_Class::Pin_Mode mode;
+			GPIO_Class::Pin_OType otype;
+			GPIO_Class::Pin_OSpeed ospeed;
+			GPIO_Class::Pin_PUPD pupd;
+			GPIO_Class::Pin_AF af;
+			uint8_t level;              // Initial output level, 0 or 1
+		} Pin_Config_t;
+
+		typedef struct {
+			Block block;
+			uint16_t offset;            // Byte offset into the block, e.g. offsetof(TIM_TypeDef, PSC)
+			uint32_t value;
+			uint32_t mask;              // Bits written, the rest keep their value
+		} Register_Write_t;
+
+		template<size_t SIZE>
+		struct Image {
+			uint32_t words[SIZE];
+			uint32_t clocks[Clock::NUM_BUSES];      // Enable bits per bus, acquired before any register is written
+		};
+
+		constexpr uint32_t FULL_MASK = UINT32_MAX;
+		constexpr uint16_t MAX_RUN = UINT8_MAX;
+
+		void apply(const uint32_t *words, uint32_t length, const uint32_t *clocks);
+		void apply_dma(const uint32_t *words, uint32_t length, const uint32_t *clocks, uint_fast8_t dma_channel);
+		void release_clocks();
+		volatile uint32_t *block_address(Block block);
+
+
+		template<size_t MAX_WRITES>
+		class Builder {
+		public:
+			constexpr Builder() : writes{}, num_writes(0), clocks{} {}
+
+			// Doc: RM0440-9.4.1-9.4.10 | A port's first pin writes its whole configuration, so the other pins
+			// are put in their reset state & every GPIO register can be written without a read
+			constexpr Builder &pin(const Pin_Config_t &config)
+			{
+				const Block BLOCK = static_cast<Block>(config.pin.port_index());
+				const uint16_t NUMBER = config.pin.number();
+				if (!contains(BLOCK, offsetof(GPIO_TypeDef, MODER))) {
+					reset_port(BLOCK);
+				}
+				clock(static_cast<Clock::Gate>(static_cast<uint8_t>(Clock::Gate::GPIOAEN) + static_cast<uint8_t>(BLOCK)));
+
+				field(BLOCK, offsetof(GPIO_TypeDef, MODER), NUMBER * 2, 2, static_cast<uint32_t>(config.mode));
+				field(BLOCK, offsetof(GPIO_TypeDef, OTYPER), NUMBER, 1, static_cast<uint32_t>(config.otype));
+				field(BLOCK, offsetof(GPIO_TypeDef, OSPEEDR), NUMBER * 2, 2, static_cast<uint32_t>(config.ospeed));
+				field(BLOCK, offsetof(GPIO_TypeDef, PUPDR), NUMBER * 2, 2, static_cast<uint32_t>(config.pupd));
+				field(BLOCK, offsetof(GPIO_TypeDef, ODR), NUMBER, 1, config.level);
+				field(BLOCK, static_cast<uint16_t>(offsetof(GPIO_TypeDef, AFR) + (NUMBER / 8) * 4), (NUMBER % 8) * 4, 4,
+				      static_cast<uint32_t>(config.af));
+				return *this;
+			}
+
+			constexpr Builder &clock(const Clock::Gate gate)
+			{
+				clocks[static_cast<uint8_t>(Clock::bus(gate))] |= Clock::bit(gate);
+				return *this;
+			}
+
+			// Writes to a register that is already in the image are merged into its entry, later bits win
+			constexpr Builder &write(const Block block, const uint16_t offset, const uint32_t value,
+			                         const uint32_t mask = FULL_MASK)
+			{
+				uint32_t i = 0;
+				while (i < num_writes && key(writes[i]) < key(block, offset)) {
+					i++;
+				}
+				if (i < num_writes && key(writes[i]) == key(block, offset)) {
+					writes[i].value = (writes[i].value & ~mask) | (value & mask);
+					writes[i].mask |= mask;
+					return *this;
+				}
+
+				// Kept sorted by block & offset so neighbouring registers end up in the same run.
+				// Going past MAX_WRITES is an out of bounds write, which fails to compile in a constexpr image.
+				for (uint32_t j = num_writes; j > i; j--) {
+					writes[j] = writes[j - 1];
+				}
+				writes[i] = {.block=block, .offset=offset, .value=value & mask, .mask=mask};
+				num_writes++;
+				return *this;
+			}
+
+			constexpr size_t image_size() const
+			{
+				size_t size = 0;
+				uint16_t run_length = 0;
+				for (uint32_t i = 0; i < num_writes; i++) {
+					if (writes[i].mask != FULL_MASK) {
+						size += 3;
+					} else if (continues_run(i) && run_length < MAX_RUN) {
+						size += 1;
+						run_length++;
+					} else {
+						size += 2;
+						run_length = 1;
+					}
+				}
+				return size;
+			}
+
+			template<size_t SIZE>
+			constexpr Image<SIZE> compile() const
+			{
+				static_assert(SIZE > 0, "An image needs at least one register write");
+				Image<SIZE> image = {};
+				size_t word = 0;
+				size_t header = 0;
+				uint16_t run_length = 0;
+
+				for (uint32_t i = 0; i < num_writes; i++) {
+					const Register_Write_t &WRITE = writes[i];
+					if (WRITE.mask != FULL_MASK) {
+						image.words[word++] = header_word(WRITE.block, 0, WRITE.offset);
+						image.words[word++] = WRITE.mask;
+						image.words[word++] = WRITE.value;
+						continue;
+					}
+					if (!continues_run(i) || run_length == MAX_RUN) {
+						header = word++;
+						image.words[header] = header_word(WRITE.block, 0, WRITE.offset);
+						run_length = 0;
+					}
+					run_length++;
+					image.words[header] += 1u << 16;
+					image.words[word++] = WRITE.value;
+				}
+				for (uint_fast8_t bus = 0; bus < Clock::NUM_BUSES; bus++) {
+					image.clocks[bus] = clocks[bus];
+				}
+				return image;
+			}
+
+		private:
+			Register_Write_t writes[MAX_WRITES];
+			uint32_t num_writes;
+			uint32_t clocks[Clock::NUM_BUSES];
+
+			// Sort order within the image, a port's MODER after every other register of the port
+			static constexpr uint32_t key(const Block block, const uint16_t offset)
+			{
+				const bool PORT_MODE = (block <= Block::PORT_G && offset == offsetof(GPIO_TypeDef, MODER));
+				return (static_cast<uint32_t>(block) << 16) | (PORT_MODE ? UINT16_MAX : offset);
+			}
+
+			static constexpr uint32_t key(const Register_Write_t &write) { return key(write.block, write.offset); }
+
+			static constexpr uint32_t header_word(const Block block, const uint8_t count, const uint16_t offset)
+			{
+				return (static_cast<uint32_t>(block) << 24) | (static_cast<uint32_t>(count) << 16) | offset;
+			}
+
+			constexpr bool contains(const Block block, const uint16_t offset) const
+			{
+				for (uint32_t i = 0; i < num_writes; i++) {
+					if (key(writes[i]) == key(block, offset)) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+			// A whole-register write continues the run of the one before it when it is the next word of the block
+			constexpr bool continues_run(const uint32_t i) const
+			{
+				return i != 0 && writes[i - 1].mask == FULL_MASK && writes[i - 1].block == writes[i].block
+				       && writes[i - 1].offset + 4 == writes[i].offset;
+			}
+
+			constexpr void field(const Block block, const uint16_t offset, const uint16_t position,
+			                     const uint16_t width, const uint32_t value)
+			{
+				const uint32_t MASK = ((1u << width) - 1) << position;
+				write(block, offset, value << position, MASK);
+			}
+
+			constexpr void reset_port(const Block block)
+			{
+				// Doc: RM0440-9.4.1-9.4.4 | Port A & B come out of reset with the debug pins configured
+				const bool IS_PORT_A = (block == Block::PORT_A);
+				const bool IS_PORT_B = (block == Block::PORT_B);
+				write(block, offsetof(GPIO_TypeDef, MODER), IS_PORT_A ? 0xABFFFFFF : (IS_PORT_B ? 0xFFFFFEBF : 0xFFFFFFFF));
+				write(block, offsetof(GPIO_TypeDef, OTYPER), 0);
+				write(block, offsetof(GPIO_TypeDef, OSPEEDR), IS_PORT_A ? 0x0C000000 : 0);
+				write(block, offsetof(GPIO_TypeDef, PUPDR), IS_PORT_A ? 0x64000000 : (IS_PORT_B ? 0x00000100 : 0));
+				write(block, offsetof(GPIO_TypeDef, ODR), 0);
+				write(block, offsetof(GPIO_TypeDef, AFR), 0);
+				write(block, offsetof(GPIO_TypeDef, AFR) + 4, 0);
+			}
+		};
+	}
+}
+
+
+#endif //STM32G4_MODULE_LIBRARY_BOARD_HH
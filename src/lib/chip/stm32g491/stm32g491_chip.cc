@@ -6,7 +6,7 @@
 // License      : MIT
 // Copyright    : (C) 2023, Liam Lawrence
 //
-// Updated      : January 19, 2023
+// Updated      : October 19, 2026
 //------------------------------------------------------------------------------
 
 #include "stm32g491_chip.hh"
@@ -15,5 +15,7 @@
 
 void Chip::init()
 {
-
+	// SystemInit may have left the chip on a different clock tree than the reset one
+	Chip::Clock::update();
+	Chip::HAL::start_cycle_counter();
 }
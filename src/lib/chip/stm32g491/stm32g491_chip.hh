@@ -6,29 +6,79 @@
 // License      : MIT
 // Copyright    : (C) 2023, Liam Lawrence
 //
-// Updated      : February 23, 2023
+// Updated      : October 19, 2026
 //------------------------------------------------------------------------------
 
 #ifndef STM32G4_MODULE_LIBRARY_CHIP_HH
 #define STM32G4_MODULE_LIBRARY_CHIP_HH
 
 
+#include <type_traits>
+#include "stm32g491_clock.hh"
+#include "stm32g491_board.hh"
+#include "stm32g491_power.hh"
+#include "stm32g491_idle.hh"
+#include "stm32g491_log.hh"
+#include "stm32g491_spsc_ring.hh"
+#include "stm32g491_mpsc_queue.hh"
 #include "../../peripherals/gpio/gpio.hh"
+#include "../../peripherals/debounce/debounce.hh"
+#include "../../peripherals/dma/dma.hh"
+#include "../../peripherals/timer/timer.hh"
+#include "../../peripherals/waveform/waveform.hh"
+#include "../../peripherals/capture/capture.hh"
+#include "../../peripherals/encoder/encoder.hh"
+#include "../../peripherals/parallel_bus/parallel_bus.hh"
+#include "../../peripherals/copy/copy.hh"
+#include "../../peripherals/chain/chain.hh"
+#include "../../peripherals/usart/usart.hh"
 
 
 
 namespace Chip {
 	void init();
 
+	// Applies a compiled board image, large images can hand their long register runs to a DMA channel
+	template<size_t SIZE>
+	void init(const Board::Image<SIZE> &board)
+	{
+		init();
+		Board::apply(board.words, SIZE, board.clocks);
+	}
+
+	template<size_t SIZE>
+	void init(const Board::Image<SIZE> &board, const uint_fast8_t dma_channel)
+	{
+		init();
+		Board::apply_dma(board.words, SIZE, board.clocks, dma_channel);
+	}
+
 	namespace HAL {
 		uint32_t read_register(volatile const uint32_t *reg);
+		void write_register(volatile uint32_t *reg, uint32_t val);
 		void set_register(volatile uint32_t *reg, uint32_t val);
 		void clear_register(volatile uint32_t *reg, uint32_t val);
 
+		// DMA address registers, the mock's are wide enough for a host pointer
+		typedef std::remove_volatile<decltype(DMA_Channel_TypeDef::CMAR)>::type Address_t;
+		void write_address(volatile Address_t *reg, volatile const void *address);
+
 		uint32_t read_field(volatile const uint32_t *reg, uint16_t position, uint16_t width);
 		void set_field(volatile uint32_t *reg, uint16_t position, uint16_t width, uint32_t val);
 		void clear_field(volatile uint32_t *reg, uint16_t position, uint16_t width);
 
+		void enable_irq(IRQn_Type irq);
+		void disable_irq(IRQn_Type irq);
+		void set_irq_priority(IRQn_Type irq, uint8_t priority);
+
+		uint32_t enter_critical();
+		void exit_critical(uint32_t primask);
+
+		void start_cycle_counter();
+		uint32_t read_cycle_counter();
+
+		void wait_for_interrupt();
+
 
 		constexpr uint32_t generate_bitmask(const uint32_t n)
 		{
@@ -42,6 +92,19 @@ namespace Chip {
 	};
 
 	class GPIO : public GPIO_Class {};
+	class Debounce : public Debounce_Class {};
+	class DMA : public DMA_Class {};
+	template<Timer_Class::Instance INSTANCE>
+	class Timer : public Timer_Instance_Class<INSTANCE> {};
+	template<Timer_Class::Instance MASTER, Timer_Class::Instance... SLAVES>
+	class Timer_Group : public Timer_Group_Class<MASTER, SLAVES...> {};
+	class Waveform : public Waveform_Class {};
+	class Capture : public Capture_Class {};
+	class Encoder : public Encoder_Class {};
+	class Parallel_Bus : public Parallel_Bus_Class {};
+	class Copy : public Copy_Class {};
+	class Chain : public Chain_Class {};
+	class USART : public USART_Class {};
 }
 
 #endif //STM32G4_MODULE_LIBRARY_CHIP_HH
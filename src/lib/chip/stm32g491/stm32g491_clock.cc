@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_clock.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "stm32g491_chip.hh"
+
+
+
+namespace {
+	using Chip::Clock::Domain;
+	using Chip::Clock::Source;
+
+	uint8_t reference_counts[Chip::Clock::NUM_BUSES * Chip::Clock::GATES_PER_BUS] = {};
+
+	typedef struct {
+		uint32_t hz[Chip::Clock::NUM_DOMAINS];
+	} Frequencies_t;
+
+	typedef struct {
+		Chip::Clock::Listener_t listener;
+		void *context;
+	} Subscription_t;
+
+	constexpr Frequencies_t evaluate(const Chip::Clock::Tree_t &tree)
+	{
+		Frequencies_t frequencies = {};
+		for (uint_fast8_t domain = 0; domain < Chip::Clock::NUM_DOMAINS; domain++) {
+			frequencies.hz[domain] = Chip::Clock::frequency(tree, static_cast<Domain>(domain));
+		}
+		return frequencies;
+	}
+
+	// Doc: RM0440-7.4.3-7.4.4 | The chip starts on HSI16 with every prescaler at 1
+	constexpr Chip::Clock::Tree_t RESET_TREE = {
+		.source=Source::HSI16, .pll_source=Source::HSI16, .hse=HSE_VALUE, .pll_m=1, .pll_n=8, .pll_r=2,
+		.ahb_divider=1, .apb1_divider=1, .apb2_divider=1, .kernel_select=0
+	};
+
+	Frequencies_t frequencies = evaluate(RESET_TREE);
+	Subscription_t subscriptions[Chip::Clock::MAX_LISTENERS] = {};
+
+	volatile uint32_t *enable_register(const Chip::Clock::Bus bus)
+	{
+		// Doc: RM0440-7.4.14-7.4.19 | There is a reserved word after AHB3ENR, so the registers are looked up
+		volatile uint32_t *const REGISTERS[Chip::Clock::NUM_BUSES] = {
+			&RCC->AHB1ENR, &RCC->AHB2ENR, &RCC->AHB3ENR, &RCC->APB1ENR1, &RCC->APB1ENR2, &RCC->APB2ENR
+		};
+		return REGISTERS[static_cast<uint8_t>(bus)];
+	}
+}
+
+
+
+/*
+ * Clock gate functions
+ */
+void Chip::Clock::acquire(const Gate gate)
+{
+	// The count & the read-modify-write of the enable register can't be split by an interrupt using the same bus
+	const uint32_t primask = Chip::HAL::enter_critical();
+	uint8_t &count = reference_counts[static_cast<uint8_t>(gate)];
+
+	if (count == 0) {
+		Chip::HAL::set_register(enable_register(bus(gate)), bit(gate));
+
+		// The peripheral can't be accessed for a couple of bus cycles after its clock is enabled,
+		// reading the enable register back covers them
+		(void) Chip::HAL::read_register(enable_register(bus(gate)));
+	}
+	if (count < UINT8_MAX) {
+		count++;
+	}
+	Chip::HAL::exit_critical(primask);
+}
+
+
+void Chip::Clock::release(const Gate gate)
+{
+	const uint32_t primask = Chip::HAL::enter_critical();
+	uint8_t &count = reference_counts[static_cast<uint8_t>(gate)];
+
+	// A count that saturated is never released, so a leaked reference can only leave a clock on, never off
+	if (count != 0 && count != UINT8_MAX) {
+		count--;
+		if (count == 0) {
+			Chip::HAL::clear_register(enable_register(bus(gate)), bit(gate));
+		}
+	}
+	Chip::HAL::exit_critical(primask);
+}
+
+
+uint8_t Chip::Clock::references(const Gate gate)
+{
+	return reference_counts[static_cast<uint8_t>(gate)];
+}
+
+
+bool Chip::Clock::is_running(const Gate gate)
+{
+	return (Chip::HAL::read_register(enable_register(bus(gate))) & bit(gate)) != 0;
+}
+
+
+uint32_t Chip::Clock::running(const Bus bus)
+{
+	return Chip::HAL::read_register(enable_register(bus));
+}
+
+
+
+/*
+ * Clock frequency functions
+ */
+uint32_t Chip::Clock::frequency(const Domain domain)
+{
+	return frequencies.hz[static_cast<uint8_t>(domain)];
+}
+
+
+// Decodes the clock tree the RCC is currently running
+Chip::Clock::Tree_t Chip::Clock::tree()
+{
+	const uint32_t CFGR = Chip::HAL::read_register(&RCC->CFGR);
+	const uint32_t PLLCFGR = Chip::HAL::read_register(&RCC->PLLCFGR);
+
+	// Doc: RM0440-7.4.3 | SWS is the source in use, SW only the one requested
+	const uint32_t SWS = (CFGR >> 2) & 0b11;
+	Source source = Source::HSI16;
+	if (SWS == static_cast<uint32_t>(Source::PLL)) {
+		source = Source::PLL;
+	} else if (SWS == static_cast<uint32_t>(Source::HSE)) {
+		source = Source::HSE;
+	}
+
+	// Doc: RM0440-7.4.3 | HPRE & PPREx are undivided until their top bit is set
+	const uint16_t AHB_DIVIDERS[] = {2, 4, 8, 16, 64, 128, 256, 512};
+	const uint32_t HPRE = (CFGR >> 4) & 0b1111;
+	const uint32_t PPRE1 = (CFGR >> 8) & 0b111;
+	const uint32_t PPRE2 = (CFGR >> 11) & 0b111;
+
+	// Doc: RM0440-7.4.4
+	return {
+		.source=source,
+		.pll_source=((PLLCFGR & 0b11) == 0b11) ? Source::HSE : Source::HSI16,
+		.hse=HSE_VALUE,
+		.pll_m=static_cast<uint8_t>(((PLLCFGR >> 4) & 0b1111) + 1),
+		.pll_n=static_cast<uint16_t>((PLLCFGR >> 8) & 0x7F),
+		.pll_r=static_cast<uint8_t>((((PLLCFGR >> 25) & 0b11) + 1) * 2),
+		.ahb_divider=(HPRE & 0b1000) ? AHB_DIVIDERS[HPRE & 0b111] : static_cast<uint16_t>(1),
+		.apb1_divider=static_cast<uint8_t>((PPRE1 & 0b100) ? (2 << (PPRE1 & 0b11)) : 1),
+		.apb2_divider=static_cast<uint8_t>((PPRE2 & 0b100) ? (2 << (PPRE2 & 0b11)) : 1),
+		.kernel_select=Chip::HAL::read_register(&RCC->CCIPR)
+	};
+}
+
+
+// Called after the clock tree is reconfigured, returns a bit per Domain that changed.
+// Listeners run once per update, so drivers only recompute their dividers when a frequency they use changes.
+uint32_t Chip::Clock::update()
+{
+	const Frequencies_t UPDATED = evaluate(tree());
+	uint32_t changed = 0;
+	for (uint_fast8_t domain = 0; domain < NUM_DOMAINS; domain++) {
+		if (UPDATED.hz[domain] != frequencies.hz[domain]) {
+			changed |= 1u << domain;
+		}
+	}
+	frequencies = UPDATED;
+
+	SystemCoreClock = frequencies.hz[static_cast<uint8_t>(Domain::HCLK)];
+
+	if (changed != 0) {
+		for (auto &subscription: subscriptions) {
+			if (subscription.listener != nullptr) {
+				subscription.listener(changed, subscription.context);
+			}
+		}
+	}
+	return changed;
+}
+
+
+bool Chip::Clock::subscribe(const Listener_t listener, void *const context)
+{
+	for (auto &subscription: subscriptions) {
+		if (subscription.listener == nullptr) {
+			subscription = {.listener=listener, .context=context};
+			return true;
+		}
+	}
+	return false;
+}
+
+
+void Chip::Clock::unsubscribe(const Listener_t listener, void *const context)
+{
+	for (auto &subscription: subscriptions) {
+		if (subscription.listener == listener && subscription.context == context) {
+			subscription = {.listener=nullptr, .context=nullptr};
+		}
+	}
+}
@@ -0,0 +1,248 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_clock.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_CLOCK_HH
+#define STM32G4_MODULE_LIBRARY_CLOCK_HH
+
+#include <cstdint>
+
+#ifndef HSE_VALUE
+#define HSE_VALUE 24000000U         // Same default as system_stm32g4xx.c, boards override it with -DHSE_VALUE
+#endif
+
+
+
+// Reference counted peripheral clock gates. Every driver acquires the gates it uses & releases them when done,
+// a clock is enabled on its first reference & disabled on its last, so drivers sharing a clock can't turn it off
+// under each other.
+namespace Chip {
+	namespace Clock {
+		enum class Bus : uint8_t {
+			// Doc: RM0440-7.4.14-7.4.19 | One enable register per bus
+			AHB1 = 0,
+			AHB2 = 1,
+			AHB3 = 2,
+			APB1_1 = 3,
+			APB1_2 = 4,
+			APB2 = 5
+		};
+
+		constexpr uint_fast8_t NUM_BUSES = 6;
+		constexpr uint_fast8_t GATES_PER_BUS = 32;
+
+		constexpr uint8_t gate_id(const Bus bus, const uint8_t bit)
+		{
+			return static_cast<uint8_t>((static_cast<uint8_t>(bus) << 5) | bit);
+		}
+
+		// Named after their enable bits, since the peripheral names are CMSIS macros.
+		// FLASHEN is on out of reset & is needed to run code, so it is not gated here
+		enum class Gate : uint8_t {
+			// Doc: RM0440-7.4.14
+			DMA1EN = gate_id(Bus::AHB1, 0),
+			DMA2EN = gate_id(Bus::AHB1, 1),
+			DMAMUX1EN = gate_id(Bus::AHB1, 2),
+			CORDICEN = gate_id(Bus::AHB1, 3),
+			FMACEN = gate_id(Bus::AHB1, 4),
+			CRCEN = gate_id(Bus::AHB1, 12),
+
+			// Doc: RM0440-7.4.15
+			GPIOAEN = gate_id(Bus::AHB2, 0),
+			GPIOBEN = gate_id(Bus::AHB2, 1),
+			GPIOCEN = gate_id(Bus::AHB2, 2),
+			GPIODEN = gate_id(Bus::AHB2, 3),
+			GPIOEEN = gate_id(Bus::AHB2, 4),
+			GPIOFEN = gate_id(Bus::AHB2, 5),
+			GPIOGEN = gate_id(Bus::AHB2, 6),
+			ADC12EN = gate_id(Bus::AHB2, 13),
+			ADC345EN = gate_id(Bus::AHB2, 14),
+			DAC1EN = gate_id(Bus::AHB2, 16),
+			DAC3EN = gate_id(Bus::AHB2, 18),
+			RNGEN = gate_id(Bus::AHB2, 26),
+
+			// Doc: RM0440-7.4.16
+			QSPIEN = gate_id(Bus::AHB3, 8),
+
+			// Doc: RM0440-7.4.17
+			TIM2EN = gate_id(Bus::APB1_1, 0),
+			TIM3EN = gate_id(Bus::APB1_1, 1),
+			TIM4EN = gate_id(Bus::APB1_1, 2),
+			TIM6EN = gate_id(Bus::APB1_1, 4),
+			TIM7EN = gate_id(Bus::APB1_1, 5),
+			CRSEN = gate_id(Bus::APB1_1, 8),
+			RTCAPBEN = gate_id(Bus::APB1_1, 10),
+			WWDGEN = gate_id(Bus::APB1_1, 11),
+			SPI2EN = gate_id(Bus::APB1_1, 14),
+			SPI3EN = gate_id(Bus::APB1_1, 15),
+			USART2EN = gate_id(Bus::APB1_1, 17),
+			USART3EN = gate_id(Bus::APB1_1, 18),
+			UART4EN = gate_id(Bus::APB1_1, 19),
+			UART5EN = gate_id(Bus::APB1_1, 20),
+			I2C1EN = gate_id(Bus::APB1_1, 21),
+			I2C2EN = gate_id(Bus::APB1_1, 22),
+			USBEN = gate_id(Bus::APB1_1, 23),
+			FDCANEN = gate_id(Bus::APB1_1, 25),
+			PWREN = gate_id(Bus::APB1_1, 28),
+			I2C3EN = gate_id(Bus::APB1_1, 30),
+			LPTIM1EN = gate_id(Bus::APB1_1, 31),
+
+			// Doc: RM0440-7.4.18
+			LPUART1EN = gate_id(Bus::APB1_2, 0),
+			UCPD1EN = gate_id(Bus::APB1_2, 8),
+
+			// Doc: RM0440-7.4.19
+			SYSCFGEN = gate_id(Bus::APB2, 0),
+			TIM1EN = gate_id(Bus::APB2, 11),
+			SPI1EN = gate_id(Bus::APB2, 12),
+			TIM8EN = gate_id(Bus::APB2, 13),
+			USART1EN = gate_id(Bus::APB2, 14),
+			TIM15EN = gate_id(Bus::APB2, 16),
+			TIM16EN = gate_id(Bus::APB2, 17),
+			TIM17EN = gate_id(Bus::APB2, 18),
+			TIM20EN = gate_id(Bus::APB2, 20),
+			SAI1EN = gate_id(Bus::APB2, 21)
+		};
+
+		constexpr Bus bus(const Gate gate) { return static_cast<Bus>(static_cast<uint8_t>(gate) >> 5); }
+		constexpr uint32_t bit(const Gate gate) { return 1u << (static_cast<uint8_t>(gate) & 0x1F); }
+
+		void acquire(Gate gate);
+		void release(Gate gate);
+
+		uint8_t references(Gate gate);
+		bool is_running(Gate gate);
+		uint32_t running(Bus bus);
+
+
+
+		// Clock tree frequencies. A static tree is evaluated at compile time with frequency(tree, domain),
+		// the registry holds the frequencies the RCC is actually running at & tells listeners when they change.
+		enum class Domain : uint8_t {
+			SYSCLK = 0,
+			HCLK = 1,
+			PCLK1 = 2,
+			PCLK2 = 3,
+			TIMER_PCLK1 = 4,        // Timers run at twice PCLK when their APB is divided
+			TIMER_PCLK2 = 5,
+			USART1_KERNEL = 6,
+			USART2_KERNEL = 7,
+			USART3_KERNEL = 8,
+			UART4_KERNEL = 9,
+			UART5_KERNEL = 10,
+			LPUART1_KERNEL = 11,
+			I2C1_KERNEL = 12,
+			I2C2_KERNEL = 13,
+			I2C3_KERNEL = 14,
+			LPTIM1_KERNEL = 15
+		};
+
+		constexpr uint_fast8_t NUM_DOMAINS = 16;
+		constexpr uint32_t HSI16_FREQUENCY = 16000000;
+		constexpr uint32_t LSI_FREQUENCY = 32000;
+		constexpr uint32_t LSE_FREQUENCY = 32768;
+
+		enum class Source : uint8_t {
+			// Doc: RM0440-7.4.3 | SW
+			HSI16 = 0b01,
+			HSE = 0b10,
+			PLL = 0b11
+		};
+
+		typedef struct {
+			Source source;
+			Source pll_source;          // HSI16 or HSE
+			uint32_t hse;               // Hz
+			uint8_t pll_m;              // Doc: RM0440-7.4.4 | Dividers & multiplier as values, not register fields
+			uint16_t pll_n;
+			uint8_t pll_r;
+			uint16_t ahb_divider;       // Doc: RM0440-7.4.3 | 1-512
+			uint8_t apb1_divider;       // 1-16
+			uint8_t apb2_divider;       // 1-16
+			uint32_t kernel_select;     // Doc: RM0440-7.4.26 | CCIPR
+		} Tree_t;
+
+		typedef void (*Listener_t)(uint32_t changed_domains, void *context);
+		constexpr uint_fast8_t MAX_LISTENERS = 8;
+
+
+		constexpr uint32_t frequency(const Tree_t &tree, const Domain domain)
+		{
+			uint32_t sysclk = HSI16_FREQUENCY;
+			if (tree.source == Source::HSE) {
+				sysclk = tree.hse;
+			} else if (tree.source == Source::PLL) {
+				const uint32_t INPUT = (tree.pll_source == Source::HSE) ? tree.hse : HSI16_FREQUENCY;
+				sysclk = static_cast<uint32_t>(static_cast<uint64_t>(INPUT) * tree.pll_n / tree.pll_m / tree.pll_r);
+			}
+			const uint32_t HCLK = sysclk / tree.ahb_divider;
+			const uint32_t PCLK1 = HCLK / tree.apb1_divider;
+			const uint32_t PCLK2 = HCLK / tree.apb2_divider;
+
+			// Doc: RM0440-7.4.26 | 2 select bits per kernel, in Domain order from USART1
+			const uint_fast8_t KERNEL = (domain >= Domain::USART1_KERNEL)
+				? static_cast<uint_fast8_t>(static_cast<uint8_t>(domain) - static_cast<uint8_t>(Domain::USART1_KERNEL)) : 0;
+			const uint32_t SELECT = (tree.kernel_select >> (KERNEL * 2)) & 0b11;
+
+			switch (domain) {
+				case Domain::SYSCLK:
+					return sysclk;
+				case Domain::HCLK:
+					return HCLK;
+				case Domain::PCLK1:
+					return PCLK1;
+				case Domain::PCLK2:
+					return PCLK2;
+				case Domain::TIMER_PCLK1:
+					return (tree.apb1_divider == 1) ? PCLK1 : PCLK1 * 2;
+				case Domain::TIMER_PCLK2:
+					return (tree.apb2_divider == 1) ? PCLK2 : PCLK2 * 2;
+				case Domain::USART1_KERNEL:
+				case Domain::USART2_KERNEL:
+				case Domain::USART3_KERNEL:
+				case Domain::UART4_KERNEL:
+				case Domain::UART5_KERNEL:
+				case Domain::LPUART1_KERNEL: {
+					// USART1 is the only one on APB2
+					const uint32_t SOURCES[] = {(domain == Domain::USART1_KERNEL) ? PCLK2 : PCLK1, sysclk,
+					                            HSI16_FREQUENCY, LSE_FREQUENCY};
+					return SOURCES[SELECT];
+				}
+				case Domain::I2C1_KERNEL:
+				case Domain::I2C2_KERNEL:
+				case Domain::I2C3_KERNEL: {
+					const uint32_t SOURCES[] = {PCLK1, sysclk, HSI16_FREQUENCY, 0};
+					return SOURCES[SELECT];
+				}
+				case Domain::LPTIM1_KERNEL: {
+					const uint32_t SOURCES[] = {PCLK1, LSI_FREQUENCY, HSI16_FREQUENCY, LSE_FREQUENCY};
+					return SOURCES[SELECT];
+				}
+			}
+			return 0;
+		}
+
+		// Rounded divider for a target frequency, e.g. a baud rate register value
+		constexpr uint32_t divider(const uint32_t clock_frequency, const uint32_t target_frequency)
+		{
+			return (clock_frequency + target_frequency / 2) / target_frequency;
+		}
+
+		uint32_t frequency(Domain domain);
+		Tree_t tree();
+		uint32_t update();
+
+		bool subscribe(Listener_t listener, void *context);
+		void unsubscribe(Listener_t listener, void *context);
+	}
+}
+
+
+#endif //STM32G4_MODULE_LIBRARY_CLOCK_HH
@@ -0,0 +1,75 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_core.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "stm32g491_chip.hh"
+
+
+
+// Everything in the HAL that touches a register or the core directly. The unit tests link stm32g491_mock.cc's
+// versions instead, which move the mock peripherals on as the drivers read & write them
+uint32_t Chip::HAL::read_register(volatile const uint32_t *const reg)
+{
+	return *reg;
+}
+
+
+void Chip::HAL::write_register(volatile uint32_t *const reg, uint32_t val)
+{
+	*reg = val;
+}
+
+
+void Chip::HAL::set_register(volatile uint32_t *const reg, uint32_t val)
+{
+	*reg |= val;
+}
+
+
+void Chip::HAL::clear_register(volatile uint32_t *const reg, uint32_t val)
+{
+	*reg &= ~(val);
+}
+
+
+void Chip::HAL::write_address(volatile Address_t *const reg, volatile const void *const address)
+{
+	*reg = reinterpret_cast<uintptr_t>(address);
+}
+
+
+
+/*
+ * Critical section functions
+ */
+// Returns the previous interrupt mask so critical sections can nest & be entered from interrupts
+uint32_t Chip::HAL::enter_critical()
+{
+	uint32_t primask;
+	save_and_disable_interrupts(primask);
+	return primask;
+}
+
+
+void Chip::HAL::exit_critical(const uint32_t primask)
+{
+	restore_interrupts(primask);
+}
+
+
+
+/*
+ * Sleep functions
+ */
+// Doc: PM0214-3.11.11 | Wakes on any interrupt that is enabled, even one masked by PRIMASK
+void Chip::HAL::wait_for_interrupt()
+{
+	cpu_sleep();
+}
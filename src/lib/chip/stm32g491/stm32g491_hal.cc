@@ -6,49 +6,79 @@
 // License      : MIT
 // Copyright    : (C) 2023, Liam Lawrence
 //
-// Updated      : February 25, 2023
+// Updated      : October 19, 2026
 //------------------------------------------------------------------------------
 
 #include "stm32g491_chip.hh"
 
 
 
-uint32_t Chip::HAL::read_register(volatile const uint32_t *const reg)
+// The register & core access itself is in stm32g491_core.cc
+uint32_t Chip::HAL::read_field(volatile const uint32_t *const reg, uint16_t position, uint16_t width)
 {
-	return *reg;
+	uint32_t reg_val = Chip::HAL::read_register(reg);
+	uint32_t shift = position * width;
+
+	uint32_t mask = Chip::HAL::generate_bitmask(width) << shift;
+	return (reg_val & mask) >> shift;
 }
 
 
-void Chip::HAL::set_register(volatile uint32_t *const reg, uint32_t val)
+void Chip::HAL::set_field(volatile uint32_t *const reg, uint16_t position, uint16_t width, uint32_t val)
 {
-	*reg |= val;
+	Chip::HAL::set_register(reg, val << (position * width));
 }
 
 
-void Chip::HAL::clear_register(volatile uint32_t *const reg, uint32_t val)
+void Chip::HAL::clear_field(volatile uint32_t *const reg, uint16_t position, uint16_t width)
 {
-	*reg &= ~(val);
+	uint32_t mask = Chip::HAL::generate_bitmask(width) << (position * width);
+	Chip::HAL::clear_register(reg, mask);
 }
 
 
-uint32_t Chip::HAL::read_field(volatile const uint32_t *const reg, uint16_t position, uint16_t width)
+
+/*
+ * NVIC functions
+ */
+void Chip::HAL::enable_irq(const IRQn_Type irq)
 {
-	uint32_t reg_val = Chip::HAL::read_register(reg);
-	uint32_t shift = position * width;
+	// Doc: PM0214-4.3.2 | ISER reads back the enable state and writing 1 to an enabled interrupt has no effect
+	const uint32_t irq_number = static_cast<uint32_t>(irq);
+	Chip::HAL::set_register(&NVIC->ISER[irq_number / 32], 1u << (irq_number % 32));
+}
 
-	uint32_t mask = Chip::HAL::generate_bitmask(width) << shift;
-	return (reg_val & mask) >> shift;
+
+void Chip::HAL::disable_irq(const IRQn_Type irq)
+{
+	// Doc: PM0214-4.3.3 | ICER reads back the enable state too, so it must be written, never read-modify-written
+	const uint32_t irq_number = static_cast<uint32_t>(irq);
+	Chip::HAL::write_register(&NVIC->ICER[irq_number / 32], 1u << (irq_number % 32));
 }
 
 
-void Chip::HAL::set_field(volatile uint32_t *const reg, uint16_t position, uint16_t width, uint32_t val)
+void Chip::HAL::set_irq_priority(const IRQn_Type irq, const uint8_t priority)
 {
-	Chip::HAL::set_register(reg, val << (position * width));
+	// Doc: PM0214-4.3.7 | Only the upper __NVIC_PRIO_BITS (4) bits of each IP byte are implemented
+	const uint_fast8_t PRIORITY_BITS = 4;
+	NVIC->IP[static_cast<uint32_t>(irq)] = static_cast<uint8_t>(priority << (8 - PRIORITY_BITS));
 }
 
 
-void Chip::HAL::clear_field(volatile uint32_t *const reg, uint16_t position, uint16_t width)
+
+/*
+ * Cycle counter functions
+ */
+void Chip::HAL::start_cycle_counter()
 {
-	uint32_t mask = Chip::HAL::generate_bitmask(width) << (position * width);
-	Chip::HAL::clear_register(reg, mask);
+	// Doc: DDI0403E-C1.6.5 & C1.8.7 | TRCENA powers the DWT, CYCCNTENA starts its cycle counter
+	Chip::HAL::set_register(&CoreDebug->DEMCR, 1 << 24);
+	Chip::HAL::set_register(&DWT->CTRL, 1 << 0);
+}
+
+
+// Counts core clock cycles & wraps, so intervals are taken as unsigned differences
+uint32_t Chip::HAL::read_cycle_counter()
+{
+	return Chip::HAL::read_register(&DWT->CYCCNT);
 }
@@ -0,0 +1,310 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_idle.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "stm32g491_chip.hh"
+
+
+
+namespace {
+	using Chip::Idle::Mode;
+
+	// Doc: RM0440-32.7.1-32.7.5
+	constexpr uint32_t CMPM = 1 << 0;
+	constexpr uint32_t ARRM = 1 << 1;
+	constexpr uint32_t CMPOK = 1 << 3;
+	constexpr uint32_t ARROK = 1 << 4;
+	constexpr uint32_t COUNTER_ENABLE = 1 << 0;
+	constexpr uint32_t CONTINUOUS_START = 1 << 2;
+	constexpr uint32_t COUNTER_MAX = 0xFFFF;
+
+	// Doc: RM0440-7.4.29, 6.4.1 & PM0214-4.4.6
+	constexpr uint32_t LSION = 1 << 0;
+	constexpr uint32_t LSIRDY = 1 << 1;
+	constexpr uint32_t LPMS_MASK = 0b111;
+	constexpr uint32_t SLEEPDEEP = 1 << 2;
+
+	// Doc: RM0440-15.3.1 | Direct line carrying the LPTIM1 wakeup out of Stop
+	constexpr uint32_t LPTIM1_EXTI_LINE = 29;
+
+	// LSI starts in well under a millisecond & an LPTIM register write completes in a few LSI ticks
+	constexpr uint32_t TIMEOUT_POLLS = 100000;
+
+	// A compare closer than this may have passed by the time the CMP write completes
+	constexpr uint64_t MIN_SLEEP_TICKS = 2;
+
+	typedef struct {
+		Chip::Idle::Timeout_t timeout;
+		void *context;
+		uint64_t deadline;
+	} Scheduled_t;
+
+	Scheduled_t scheduled[Chip::Idle::MAX_TIMEOUTS] = {};
+	Chip::Idle::Mode_Stats_t mode_stats[Chip::Idle::NUM_MODES] = {};
+
+	// Counter periods completed, counted on the autoreload match
+	volatile uint32_t periods = 0;
+
+
+	bool wait_for(volatile const uint32_t *const reg, const uint32_t mask, const uint32_t value)
+	{
+		for (uint32_t poll = 0; poll < TIMEOUT_POLLS; poll++) {
+			if ((Chip::HAL::read_register(reg) & mask) == value) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	// Doc: RM0440-32.7.8 | The counter runs from LSI, a read is only trusted when two in a row agree
+	uint32_t read_counter()
+	{
+		uint32_t count = Chip::HAL::read_register(&LPTIM1->CNT);
+		uint32_t again = Chip::HAL::read_register(&LPTIM1->CNT);
+		while (count != again) {
+			count = again;
+			again = Chip::HAL::read_register(&LPTIM1->CNT);
+		}
+		return count;
+	}
+
+
+	// Time is counted from the autoreload match, one tick before the counter wraps, so the period count & the
+	// counter roll over together. A time's counter value is one behind it.
+	constexpr uint32_t counter_value(const uint64_t time)
+	{
+		return static_cast<uint32_t>((time - 1) & COUNTER_MAX);
+	}
+
+	constexpr uint32_t time_in_period(const uint32_t count)
+	{
+		return (count + 1) & COUNTER_MAX;
+	}
+
+
+	void set_compare(const uint32_t count)
+	{
+		// Doc: RM0440-32.7.6 | CMP can't be written again until the last write is done
+		if (Chip::HAL::read_register(&LPTIM1->CMP) == count) {
+			return;
+		}
+		Chip::HAL::write_register(&LPTIM1->ICR, CMPOK);
+		Chip::HAL::write_register(&LPTIM1->CMP, count);
+		(void) wait_for(&LPTIM1->ISR, CMPOK, CMPOK);
+	}
+
+
+	uint64_t next_deadline()
+	{
+		uint64_t deadline = UINT64_MAX;
+		for (const auto &entry: scheduled) {
+			if (entry.timeout != nullptr && entry.deadline < deadline) {
+				deadline = entry.deadline;
+			}
+		}
+		return deadline;
+	}
+
+
+	// Timeouts run in thread context, one at a time, so a timeout can schedule itself again
+	void run_expired()
+	{
+		for (auto &entry: scheduled) {
+			const uint32_t primask = Chip::HAL::enter_critical();
+			const Scheduled_t DUE = entry;
+			const bool EXPIRED = (DUE.timeout != nullptr && DUE.deadline <= Chip::Idle::now());
+			if (EXPIRED) {
+				entry = {.timeout=nullptr, .context=nullptr, .deadline=0};
+			}
+			Chip::HAL::exit_critical(primask);
+
+			if (EXPIRED) {
+				DUE.timeout(DUE.context);
+			}
+		}
+	}
+
+
+	void enter(const Mode mode)
+	{
+		if (mode != Mode::SLEEP) {
+			// Doc: RM0440-6.4.1 | LPMS picks the Stop mode SLEEPDEEP enters
+			Chip::Clock::acquire(Chip::Clock::Gate::PWREN);
+			volatile uint32_t *const REGISTER = &PWR->CR1;
+			Chip::HAL::write_register(REGISTER, (Chip::HAL::read_register(REGISTER) & ~LPMS_MASK)
+			                                    | ((mode == Mode::STOP_1) ? 0b001u : 0b000u));
+			Chip::Clock::release(Chip::Clock::Gate::PWREN);
+			Chip::HAL::set_register(&SCB->SCR, SLEEPDEEP);
+		}
+		Chip::HAL::wait_for_interrupt();
+		Chip::HAL::clear_register(&SCB->SCR, SLEEPDEEP);
+	}
+}
+
+
+
+/*
+ * Time base functions
+ */
+// Starting again keeps the time base that is already running
+void Chip::Idle::init()
+{
+	Chip::Clock::acquire(Chip::Clock::Gate::LPTIM1EN);
+	if (Chip::HAL::read_register(&LPTIM1->CR) & COUNTER_ENABLE) {
+		Chip::Clock::release(Chip::Clock::Gate::LPTIM1EN);
+		return;
+	}
+
+	// Doc: RM0440-7.4.26 & 7.4.29 | LSI keeps running in Stop mode, LPTIM1SEL picks it as the kernel clock
+	Chip::HAL::set_register(&RCC->CSR, LSION);
+	(void) wait_for(&RCC->CSR, LSIRDY, LSIRDY);
+	volatile uint32_t *const KERNEL_SELECT = &RCC->CCIPR;
+	Chip::HAL::write_register(KERNEL_SELECT, (Chip::HAL::read_register(KERNEL_SELECT) & ~(0b11u << 18)) | (0b01 << 18));
+	Chip::Clock::update();
+
+	// Doc: RM0440-32.4.4 | IER & CFGR are written while the timer is disabled, ARR & CMP while it is enabled.
+	// No prescaler, the counter counts LSI ticks
+	Chip::HAL::write_register(&LPTIM1->IER, CMPM | ARRM);
+	Chip::HAL::write_register(&LPTIM1->CFGR, 0);
+	Chip::HAL::set_register(&LPTIM1->CR, COUNTER_ENABLE);
+	Chip::HAL::write_register(&LPTIM1->ICR, ARROK);
+	Chip::HAL::write_register(&LPTIM1->ARR, COUNTER_MAX);
+	(void) wait_for(&LPTIM1->ISR, ARROK, ARROK);
+	set_compare(COUNTER_MAX);
+	Chip::HAL::set_register(&LPTIM1->CR, CONTINUOUS_START);
+
+	Chip::HAL::set_register(&EXTI->IMR1, 1u << LPTIM1_EXTI_LINE);
+	Chip::HAL::enable_irq(LPTIM1_IRQn);
+}
+
+
+// Ticks of TICK_FREQUENCY since init()
+uint64_t Chip::Idle::now()
+{
+	const uint32_t primask = Chip::HAL::enter_critical();
+	uint32_t count = read_counter();
+	uint64_t completed = periods;
+
+	// A period that ended while interrupts were masked, e.g. while the core slept in idle(), hasn't been counted.
+	// The counter is read again after the flag so both are from after the rollover.
+	if (Chip::HAL::read_register(&LPTIM1->ISR) & ARRM) {
+		count = read_counter();
+		completed++;
+	}
+	Chip::HAL::exit_critical(primask);
+	return (completed << 16) | time_in_period(count);
+}
+
+
+
+/*
+ * Timeout functions
+ */
+// Runs timeout from idle() once now() reaches deadline, returns false when every slot is taken
+bool Chip::Idle::schedule(const uint64_t deadline, const Timeout_t timeout, void *const context)
+{
+	const uint32_t primask = Chip::HAL::enter_critical();
+	for (auto &entry: scheduled) {
+		if (entry.timeout == nullptr) {
+			entry = {.timeout=timeout, .context=context, .deadline=deadline};
+			Chip::HAL::exit_critical(primask);
+			return true;
+		}
+	}
+	Chip::HAL::exit_critical(primask);
+	return false;
+}
+
+
+void Chip::Idle::cancel(const Timeout_t timeout, void *const context)
+{
+	const uint32_t primask = Chip::HAL::enter_critical();
+	for (auto &entry: scheduled) {
+		if (entry.timeout == timeout && entry.context == context) {
+			entry = {.timeout=nullptr, .context=nullptr, .deadline=0};
+		}
+	}
+	Chip::HAL::exit_critical(primask);
+}
+
+
+
+/*
+ * Idle functions
+ */
+// Sleeps until the next deadline or the end of the counter's period, whichever is first, in the deepest mode
+// that wakes within max_wakeup_latency us. Drivers that need their clocks running while the core sleeps, e.g. a
+// DMA transfer from a timer, pass a latency below the Stop modes'.
+void Chip::Idle::idle(const uint32_t max_wakeup_latency)
+{
+	run_expired();
+
+	// Interrupts stay masked until the clock tree is back, so nothing is scheduled after the deadline is picked.
+	// Doc: PM0214-3.11.11 | WFI still wakes on them & they run once the mask is lifted
+	const uint32_t primask = Chip::HAL::enter_critical();
+	const uint64_t NOW = now();
+	const uint64_t PERIOD_END = ((NOW >> 16) + 1) << 16;
+	const uint64_t DEADLINE = next_deadline();
+	const uint64_t WAKEUP = (DEADLINE < PERIOD_END) ? DEADLINE : PERIOD_END;
+	if (WAKEUP <= NOW + MIN_SLEEP_TICKS) {
+		Chip::HAL::exit_critical(primask);
+		run_expired();
+		return;
+	}
+	set_compare(counter_value(WAKEUP));
+
+	const Chip::Clock::Tree_t TREE = Chip::Clock::tree();
+	const uint32_t RESTART = (TREE.source == Chip::Clock::Source::HSI16) ? 0 : PLL_RESTART_LATENCY;
+	const Mode MODE = select_mode(WAKEUP - NOW, max_wakeup_latency, RESTART);
+	enter(MODE);
+
+	// Stop modes wake up on HSI16, the time base kept counting through them so only the clock tree needs restoring
+	const uint32_t WOKEN = Chip::HAL::read_cycle_counter();
+	if (MODE != Mode::SLEEP) {
+		(void) Chip::Power::restore_clock(TREE);
+	}
+	const uint32_t WAKEUP_CYCLES = Chip::HAL::read_cycle_counter() - WOKEN;
+
+	Mode_Stats_t &stats = mode_stats[static_cast<uint8_t>(MODE)];
+	stats.entries++;
+	stats.resident_ticks += now() - NOW;
+	stats.last_wakeup_cycles = WAKEUP_CYCLES;
+	stats.max_wakeup_cycles = (WAKEUP_CYCLES > stats.max_wakeup_cycles) ? WAKEUP_CYCLES : stats.max_wakeup_cycles;
+	Chip::HAL::exit_critical(primask);
+
+	run_expired();
+}
+
+
+Chip::Idle::Mode_Stats_t Chip::Idle::stats(const Mode mode)
+{
+	return mode_stats[static_cast<uint8_t>(mode)];
+}
+
+
+
+/*
+ * Idle interrupt functions
+ */
+// Doc: RM0440-32.7.1-32.7.2 | A compare match only wakes the core, idle() works out what is due
+void Chip::Idle::handle_interrupt()
+{
+	const uint32_t FLAGS = Chip::HAL::read_register(&LPTIM1->ISR) & (CMPM | ARRM);
+	Chip::HAL::write_register(&LPTIM1->ICR, FLAGS);
+	if (FLAGS & ARRM) {
+		periods = periods + 1;
+	}
+}
+
+
+extern "C" {
+void LPTIM1_IRQHandler() { Chip::Idle::handle_interrupt(); }
+}
@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_idle.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_IDLE_HH
+#define STM32G4_MODULE_LIBRARY_IDLE_HH
+
+#include <cstdint>
+#include "stm32g491_clock.hh"
+
+
+
+// Tickless idle. LPTIM1 counts LSI ticks in every run, sleep & stop mode & is the system time base, so time
+// carries on through Stop without a tick interrupt. idle() runs the timeouts that are due, then sleeps until the
+// next one in the deepest mode whose wakeup latency is allowed & that is worth entering for that long.
+namespace Chip {
+	namespace Idle {
+		enum class Mode : uint8_t {
+			// Doc: RM0440-6.3 | There is no Stop 2 on the G4, Stop 1 is the deepest mode that keeps SRAM & registers
+			SLEEP = 0,
+			STOP_0 = 1,             // Main regulator stays on
+			STOP_1 = 2              // Low-power regulator, slower to wake
+		};
+
+		constexpr uint_fast8_t NUM_MODES = 3;
+		constexpr uint32_t TICK_FREQUENCY = Clock::LSI_FREQUENCY;
+
+		typedef struct {
+			Mode mode;
+			uint32_t wakeup_latency;    // us, rounded up from the datasheet
+			uint32_t min_residency;     // us, shorter stays cost more to enter & leave than they save
+		} Mode_Limits_t;
+
+		constexpr Mode_Limits_t MODE_LIMITS[NUM_MODES] = {
+			{.mode=Mode::SLEEP, .wakeup_latency=1, .min_residency=0},
+			{.mode=Mode::STOP_0, .wakeup_latency=5, .min_residency=1000},
+			{.mode=Mode::STOP_1, .wakeup_latency=10, .min_residency=2000}
+		};
+
+		// Doc: RM0440-7.3 | Worst case PLL lock time, added to the Stop modes when the PLL has to be restarted
+		constexpr uint32_t PLL_RESTART_LATENCY = 50;
+
+		typedef struct {
+			uint32_t entries;
+			uint64_t resident_ticks;        // Time spent in the mode
+			uint32_t last_wakeup_cycles;    // Core cycles from waking up to the clock tree running again
+			uint32_t max_wakeup_cycles;
+		} Mode_Stats_t;
+
+		typedef void (*Timeout_t)(void *context);
+		constexpr uint_fast8_t MAX_TIMEOUTS = 8;
+
+
+		// Rounded up, a deadline is never early
+		constexpr uint64_t ticks(const uint64_t microseconds)
+		{
+			return (microseconds * TICK_FREQUENCY + 999999) / 1000000;
+		}
+
+		constexpr Mode select_mode(const uint64_t idle_ticks, const uint32_t max_wakeup_latency,
+		                           const uint32_t clock_restart_latency)
+		{
+			Mode mode = Mode::SLEEP;
+			for (const auto &limits: MODE_LIMITS) {
+				const uint32_t LATENCY = limits.wakeup_latency + ((limits.mode == Mode::SLEEP) ? 0 : clock_restart_latency);
+				if (LATENCY <= max_wakeup_latency && ticks(limits.min_residency) <= idle_ticks) {
+					mode = limits.mode;
+				}
+			}
+			return mode;
+		}
+
+		void init();
+		uint64_t now();
+
+		bool schedule(uint64_t deadline, Timeout_t timeout, void *context);
+		void cancel(Timeout_t timeout, void *context);
+		void idle(uint32_t max_wakeup_latency);
+
+		Mode_Stats_t stats(Mode mode);
+		void handle_interrupt();
+	}
+}
+
+
+#endif //STM32G4_MODULE_LIBRARY_IDLE_HH
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_log.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "stm32g491_chip.hh"
+
+
+
+namespace {
+	constexpr uint32_t INDEX_MASK = Chip::Log::BUFFER_WORDS - 1;
+	static_assert((Chip::Log::BUFFER_WORDS & INDEX_MASK) == 0, "The log buffer must be a power of 2 words");
+
+	// Head & tail count words since reset() & wrap with uint32_t, the ring is indexed with their low bits.
+	// Every word the reader hasn't been given is 0 until its record is published, a header never is
+	uint32_t ring[Chip::Log::BUFFER_WORDS] = {};
+	uint32_t head = 0;
+	uint32_t tail = 0;
+	uint32_t dropped_records = 0;
+}
+
+
+
+void Chip::Log::write(const uint32_t header, const uint32_t *const arguments, const uint_fast8_t count)
+{
+	const uint32_t WORDS = HEADER_WORDS + count;
+
+	// Reserve, the reserving loses to an interrupt that logs in between & tries again after it
+	uint32_t start = __atomic_load_n(&head, __ATOMIC_RELAXED);
+	do {
+		if (start + WORDS - __atomic_load_n(&tail, __ATOMIC_ACQUIRE) > BUFFER_WORDS) {
+			__atomic_fetch_add(&dropped_records, 1, __ATOMIC_RELAXED);
+			return;
+		}
+	} while (!__atomic_compare_exchange_n(&head, &start, start + WORDS, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+	ring[(start + 1) & INDEX_MASK] = Chip::HAL::read_cycle_counter();
+	for (uint_fast8_t i = 0; i < count; i++) {
+		ring[(start + HEADER_WORDS + i) & INDEX_MASK] = arguments[i];
+	}
+	__atomic_store_n(&ring[start & INDEX_MASK], header, __ATOMIC_RELEASE);
+}
+
+
+uint32_t Chip::Log::read(uint32_t *const destination, const uint32_t max_words)
+{
+	uint32_t position = __atomic_load_n(&tail, __ATOMIC_RELAXED);
+	uint32_t copied = 0;
+
+	while (true) {
+		const uint32_t HEADER = __atomic_load_n(&ring[position & INDEX_MASK], __ATOMIC_ACQUIRE);
+		if (HEADER == 0) {
+			break;
+		}
+		const uint32_t WORDS = HEADER_WORDS + (HEADER >> 28);
+		if (copied + WORDS > max_words) {
+			break;
+		}
+		for (uint32_t i = 0; i < WORDS; i++) {
+			destination[copied++] = ring[(position + i) & INDEX_MASK];
+			ring[(position + i) & INDEX_MASK] = 0;
+		}
+		position += WORDS;
+	}
+
+	// The zeroed words are seen by any writer that sees the space they free
+	__atomic_store_n(&tail, position, __ATOMIC_RELEASE);
+	return copied;
+}
+
+
+uint32_t Chip::Log::dropped()
+{
+	return __atomic_load_n(&dropped_records, __ATOMIC_RELAXED);
+}
+
+
+uint32_t Chip::Log::used()
+{
+	return __atomic_load_n(&head, __ATOMIC_ACQUIRE) - __atomic_load_n(&tail, __ATOMIC_ACQUIRE);
+}
+
+
+void Chip::Log::reset()
+{
+	for (uint32_t &word : ring) {
+		word = 0;
+	}
+	__atomic_store_n(&head, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&tail, 0, __ATOMIC_RELAXED);
+	__atomic_store_n(&dropped_records, 0, __ATOMIC_RELAXED);
+}
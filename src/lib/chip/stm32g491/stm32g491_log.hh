@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_log.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_LOG_HH
+#define STM32G4_MODULE_LIBRARY_LOG_HH
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+
+
+// Deferred binary logging. Nothing is formatted on the chip: each CHIP_LOG() site is given an ID at compile time
+// from its format string, & only that ID, the cycle counter & the raw arguments are written to a ring of words.
+// The format strings are kept in the .log_strings section, which the linker script leaves out of flash, &
+// scripts/decode_log.py turns what read() copied out back into text with them.
+//
+// A record is a header word, ID in bits 27:0 & the argument count in bits 31:28, the cycle counter & one word per
+// argument. Records are reserved with a compare & exchange on the head (LDREX/STREX on the M4) & published by
+// writing their header last, so any interrupt can log without a critical section & read() stops at a record
+// that is reserved but not yet written. Timestamps are 0 until Chip::HAL::start_cycle_counter().
+namespace Chip {
+	namespace Log {
+		constexpr uint32_t BUFFER_WORDS = 512;          // A power of 2
+		constexpr uint_fast8_t MAX_ARGUMENTS = 8;
+		constexpr uint_fast8_t HEADER_WORDS = 2;        // Header & timestamp
+		constexpr uint32_t ID_MASK = 0x0FFFFFFF;
+
+		// The .log_strings entry of a log site, its header & format string. Only the decoder reads it, the section
+		// is linked at address 0 & never loaded
+		template<size_t LENGTH>
+		struct Entry_t {
+			uint32_t header;
+			char format[LENGTH];
+		};
+
+
+		// FNV-1a, an ID of 0 is moved to 1 so a header is never 0
+		constexpr uint32_t format_id(const char *const format)
+		{
+			uint32_t hash = 2166136261u;
+			for (const char *c = format; *c != '\0'; c++) {
+				hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+			}
+			const uint32_t ID = (hash ^ (hash >> 28)) & ID_MASK;
+			return (ID == 0) ? 1 : ID;
+		}
+
+		// Conversions after each %, %% being a literal %. Strings aren't supported, the decoder only has the words
+		constexpr uint_fast8_t count_arguments(const char *const format)
+		{
+			uint_fast8_t count = 0;
+			for (const char *c = format; *c != '\0'; c++) {
+				if (*c == '%') {
+					if (*(c + 1) == '%') {
+						c++;
+					} else {
+						count++;
+					}
+				}
+			}
+			return count;
+		}
+
+		// Whether every conversion is one decode_log.py reads from a word, which rules out %s & %n
+		constexpr bool decodable(const char *const format)
+		{
+			for (const char *c = format; *c != '\0'; c++) {
+				if (*c != '%') {
+					continue;
+				}
+				c++;
+				if (*c == '%') {
+					continue;
+				}
+				while (*c != '\0' && (*c == '-' || *c == '+' || *c == ' ' || *c == '#' || *c == '.'
+				                      || (*c >= '0' && *c <= '9') || *c == 'h' || *c == 'l' || *c == 'z')) {
+					c++;
+				}
+				bool known = false;
+				for (const char *k = "diouxXcfFeEgGp"; *k != '\0'; k++) {
+					known = known || (*c == *k);
+				}
+				if (!known) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		constexpr uint32_t header(const char *const format)
+		{
+			return (static_cast<uint32_t>(count_arguments(format)) << 28) | format_id(format);
+		}
+
+		// Only used unevaluated, so the count comes from the argument types & runtime values can be counted
+		template<typename... Arguments>
+		std::integral_constant<uint_fast8_t, sizeof...(Arguments)> num_arguments(const Arguments &...);
+
+		// One word per argument, floats as their bits & doubles narrowed to floats first
+		template<typename T>
+		inline uint32_t word(const T value)
+		{
+			if constexpr (std::is_floating_point<T>::value) {
+				const float NARROWED = static_cast<float>(value);
+				uint32_t bits;
+				memcpy(&bits, &NARROWED, sizeof(bits));
+				return bits;
+			} else if constexpr (std::is_pointer<T>::value) {
+				return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(value));
+			} else {
+				return static_cast<uint32_t>(value);
+			}
+		}
+
+		void write(uint32_t header, const uint32_t *arguments, uint_fast8_t count);
+
+		template<typename... Arguments>
+		inline void write_record(const uint32_t header, const Arguments... arguments)
+		{
+			const uint32_t WORDS[sizeof...(Arguments) + 1] = {word(arguments)...};
+			write(header, WORDS, sizeof...(Arguments));
+		}
+
+		// Copies whole records in order & frees their space, returns the number of words copied
+		uint32_t read(uint32_t *destination, uint32_t max_words);
+
+		uint32_t dropped();             // Records that didn't fit since reset()
+		uint32_t used();                // Words waiting to be read
+		void reset();                   // Only while nothing is logging
+	}
+}
+
+
+// Checked at compile time: the format's conversions against the arguments & the argument count against the header
+#define CHIP_LOG(FORMAT, ...) do { \
+	static_assert(Chip::Log::count_arguments(FORMAT) == decltype(Chip::Log::num_arguments(__VA_ARGS__))::value, \
+	              "CHIP_LOG() format doesn't match its arguments"); \
+	static_assert(Chip::Log::count_arguments(FORMAT) <= Chip::Log::MAX_ARGUMENTS, "Too many CHIP_LOG() arguments"); \
+	static_assert(Chip::Log::decodable(FORMAT), "CHIP_LOG() can't log strings, only what fits in a word"); \
+	__attribute__((section(".log_strings"), used)) \
+	static const Chip::Log::Entry_t<sizeof(FORMAT)> CHIP_LOG_ENTRY = {Chip::Log::header(FORMAT), FORMAT}; \
+	constexpr uint32_t CHIP_LOG_HEADER = Chip::Log::header(FORMAT); \
+	Chip::Log::write_record(CHIP_LOG_HEADER, ##__VA_ARGS__); \
+} while (false)
+
+
+#endif //STM32G4_MODULE_LIBRARY_LOG_HH
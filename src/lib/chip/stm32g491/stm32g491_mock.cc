@@ -6,10 +6,142 @@
 // License      : MIT
 // Copyright    : (C) 2023, Liam Lawrence
 //
-// Updated      : February 25, 2023
+// Updated      : October 19, 2026
 //------------------------------------------------------------------------------
 
 #include "stm32g491_mock.hh"
+#include "stm32g491_chip.hh"
+#include <cstring>
+
+
+
+/*
+ * NVIC
+ */
+NVIC_Type mock_NVIC;
+NVIC_Type *NVIC = &mock_NVIC;
+
+// Drivers define the handlers they use, the same way they override the weak aliases in the startup file
+extern "C" {
+void DMA1_Channel1_IRQHandler() __attribute__((weak));
+void DMA1_Channel2_IRQHandler() __attribute__((weak));
+void DMA1_Channel3_IRQHandler() __attribute__((weak));
+void DMA1_Channel4_IRQHandler() __attribute__((weak));
+void DMA1_Channel5_IRQHandler() __attribute__((weak));
+void DMA1_Channel6_IRQHandler() __attribute__((weak));
+void DMA1_Channel7_IRQHandler() __attribute__((weak));
+void DMA1_Channel8_IRQHandler() __attribute__((weak));
+void DMA2_Channel1_IRQHandler() __attribute__((weak));
+void DMA2_Channel2_IRQHandler() __attribute__((weak));
+void DMA2_Channel3_IRQHandler() __attribute__((weak));
+void DMA2_Channel4_IRQHandler() __attribute__((weak));
+void DMA2_Channel5_IRQHandler() __attribute__((weak));
+void DMA2_Channel6_IRQHandler() __attribute__((weak));
+void DMA2_Channel7_IRQHandler() __attribute__((weak));
+void DMA2_Channel8_IRQHandler() __attribute__((weak));
+void DMAMUX_OVR_IRQHandler() __attribute__((weak));
+void USART1_IRQHandler() __attribute__((weak));
+void USART2_IRQHandler() __attribute__((weak));
+void USART3_IRQHandler() __attribute__((weak));
+void UART4_IRQHandler() __attribute__((weak));
+void UART5_IRQHandler() __attribute__((weak));
+void LPUART1_IRQHandler() __attribute__((weak));
+void LPTIM1_IRQHandler() __attribute__((weak));
+void TIM1_BRK_TIM15_IRQHandler() __attribute__((weak));
+void TIM1_UP_TIM16_IRQHandler() __attribute__((weak));
+void TIM1_TRG_COM_TIM17_IRQHandler() __attribute__((weak));
+void TIM1_CC_IRQHandler() __attribute__((weak));
+void TIM2_IRQHandler() __attribute__((weak));
+void TIM3_IRQHandler() __attribute__((weak));
+void TIM4_IRQHandler() __attribute__((weak));
+void TIM6_DAC_IRQHandler() __attribute__((weak));
+void TIM7_IRQHandler() __attribute__((weak));
+void TIM8_UP_IRQHandler() __attribute__((weak));
+void TIM8_TRG_COM_IRQHandler() __attribute__((weak));
+void TIM8_CC_IRQHandler() __attribute__((weak));
+void TIM20_UP_IRQHandler() __attribute__((weak));
+void TIM20_TRG_COM_IRQHandler() __attribute__((weak));
+void TIM20_CC_IRQHandler() __attribute__((weak));
+}
+
+typedef struct {
+	IRQn_Type irq;
+	void (*handler)();
+} Mock_Vector_t;
+
+const Mock_Vector_t mock_vector_table[] = {
+	{DMA1_Channel1_IRQn, DMA1_Channel1_IRQHandler},
+	{DMA1_Channel2_IRQn, DMA1_Channel2_IRQHandler},
+	{DMA1_Channel3_IRQn, DMA1_Channel3_IRQHandler},
+	{DMA1_Channel4_IRQn, DMA1_Channel4_IRQHandler},
+	{DMA1_Channel5_IRQn, DMA1_Channel5_IRQHandler},
+	{DMA1_Channel6_IRQn, DMA1_Channel6_IRQHandler},
+	{DMA1_Channel7_IRQn, DMA1_Channel7_IRQHandler},
+	{DMA1_Channel8_IRQn, DMA1_Channel8_IRQHandler},
+	{DMA2_Channel1_IRQn, DMA2_Channel1_IRQHandler},
+	{DMA2_Channel2_IRQn, DMA2_Channel2_IRQHandler},
+	{DMA2_Channel3_IRQn, DMA2_Channel3_IRQHandler},
+	{DMA2_Channel4_IRQn, DMA2_Channel4_IRQHandler},
+	{DMA2_Channel5_IRQn, DMA2_Channel5_IRQHandler},
+	{DMA2_Channel6_IRQn, DMA2_Channel6_IRQHandler},
+	{DMA2_Channel7_IRQn, DMA2_Channel7_IRQHandler},
+	{DMA2_Channel8_IRQn, DMA2_Channel8_IRQHandler},
+	{DMAMUX_OVR_IRQn, DMAMUX_OVR_IRQHandler},
+	{USART1_IRQn, USART1_IRQHandler},
+	{USART2_IRQn, USART2_IRQHandler},
+	{USART3_IRQn, USART3_IRQHandler},
+	{UART4_IRQn, UART4_IRQHandler},
+	{UART5_IRQn, UART5_IRQHandler},
+	{LPUART1_IRQn, LPUART1_IRQHandler},
+	{LPTIM1_IRQn, LPTIM1_IRQHandler},
+	{TIM1_BRK_TIM15_IRQn, TIM1_BRK_TIM15_IRQHandler},
+	{TIM1_UP_TIM16_IRQn, TIM1_UP_TIM16_IRQHandler},
+	{TIM1_TRG_COM_TIM17_IRQn, TIM1_TRG_COM_TIM17_IRQHandler},
+	{TIM1_CC_IRQn, TIM1_CC_IRQHandler},
+	{TIM2_IRQn, TIM2_IRQHandler},
+	{TIM3_IRQn, TIM3_IRQHandler},
+	{TIM4_IRQn, TIM4_IRQHandler},
+	{TIM6_DAC_IRQn, TIM6_DAC_IRQHandler},
+	{TIM7_IRQn, TIM7_IRQHandler},
+	{TIM8_UP_IRQn, TIM8_UP_IRQHandler},
+	{TIM8_TRG_COM_IRQn, TIM8_TRG_COM_IRQHandler},
+	{TIM8_CC_IRQn, TIM8_CC_IRQHandler},
+	{TIM20_UP_IRQn, TIM20_UP_IRQHandler},
+	{TIM20_TRG_COM_IRQn, TIM20_TRG_COM_IRQHandler},
+	{TIM20_CC_IRQn, TIM20_CC_IRQHandler},
+};
+
+
+// Runs the handler for an interrupt if it is enabled in the NVIC, otherwise leaves it pending
+void raise_IRQ(IRQn_Type irq)
+{
+	const uint32_t word = static_cast<uint32_t>(irq) / 32;
+	const uint32_t bit = 1u << (static_cast<uint32_t>(irq) % 32);
+
+	if (!(mock_NVIC.ISER[word] & bit)) {
+		mock_NVIC.ISPR[word] |= bit;
+		return;
+	}
+	mock_NVIC.ISPR[word] &= ~bit;
+	for (const auto &vector: mock_vector_table) {
+		if (vector.irq == irq && vector.handler) {
+			vector.handler();
+		}
+	}
+}
+
+
+
+/*
+ * Debug & DWT
+ */
+CoreDebug_Type mock_CoreDebug;
+CoreDebug_Type *CoreDebug = &mock_CoreDebug;
+DWT_Type mock_DWT;
+DWT_Type *DWT = &mock_DWT;
+SCB_Type mock_SCB;
+SCB_Type *SCB = &mock_SCB;
+uint32_t SystemCoreClock = 16000000;
 
 
 
@@ -53,26 +185,38 @@ void update_GPIO_BSRR()
 }
 
 
+// Applies a whole-word BSRR store immediately, like the hardware does, and logs it when logging is enabled.
+// Doc: RM0440-9.4.7 | Set bits take priority over reset bits for the same pin
+const uint32_t MAX_GPIO_WRITES = 4096;
+bool mock_GPIO_logging = false;
+Mock_GPIO_Write_t mock_GPIO_writes[MAX_GPIO_WRITES];
+uint32_t mock_GPIO_num_writes = 0;
+
+void record_GPIO_BSRR(GPIO_TypeDef *port, uint32_t value)
+{
+	port->ODR = (port->ODR & ~(value >> 16)) | (value & 0xFFFF);
+	port->BSRR = 0;
+
+	if (mock_GPIO_logging && mock_GPIO_num_writes < MAX_GPIO_WRITES) {
+		mock_GPIO_writes[mock_GPIO_num_writes++] = {.port=port, .bsrr=value};
+	}
+}
+
+
+// Drives a sequence of levels onto a port's IDR, raising the DMA request that samples it after each one
+void feed_GPIO_IDR(GPIO_TypeDef *port, const uint16_t *samples, uint32_t length, uint16_t request)
+{
+	for (uint32_t i = 0; i < length; i++) {
+		port->IDR = samples[i];
+		trigger_DMA_request(request);
+	}
+}
+
+
 // Returns an int based off the GPIO Port
 uint16_t port2int(GPIO_TypeDef *port)
 {
-	uint16_t num = 0;
-	if (port == GPIOA) {
-		num = 0;
-	} else if (port == GPIOB) {
-		num = 1;
-	} else if (port == GPIOC) {
-		num = 2;
-	} else if (port == GPIOD) {
-		num = 3;
-	} else if (port == GPIOE) {
-		num = 4;
-	} else if (port == GPIOF) {
-		num = 5;
-	} else if (port == GPIOG) {
-		num = 6;
-	}
-	return num;
+	return static_cast<uint16_t>(port - mock_GPIO_ports);
 }
 
 
@@ -82,3 +226,711 @@ uint16_t port2int(GPIO_TypeDef *port)
  */
 RCC_TypeDef mock_RCC;
 RCC_TypeDef *RCC = &mock_RCC;
+PWR_TypeDef mock_PWR;
+PWR_TypeDef *PWR = &mock_PWR;
+FLASH_TypeDef mock_FLASH;
+FLASH_TypeDef *FLASH = &mock_FLASH;
+
+
+// Settles the status bits the RCC & PWR derive from their control bits, called whenever a driver reads their
+// registers or the cycle counter. Each poll also moves the cycle counter on, so waits take time.
+const uint32_t MOCK_CYCLES_PER_POLL = 16;
+
+void update_RCC_PWR_status()
+{
+	// Doc: RM0440-7.4.1 & 7.4.29 | HSIRDY, HSERDY, PLLRDY & LSIRDY follow HSION, HSEON, PLLON & LSION
+	mock_RCC.CSR = (mock_RCC.CSR & ~(1u << 1)) | ((mock_RCC.CSR & 1) << 1);
+	const uint32_t ready = ((mock_RCC.CR >> 8) & 1) << 10 | ((mock_RCC.CR >> 16) & 1) << 17 | ((mock_RCC.CR >> 24) & 1) << 25;
+	mock_RCC.CR = (mock_RCC.CR & ~((1u << 10) | (1u << 17) | (1u << 25))) | ready;
+
+	// Doc: RM0440-7.4.3 | SWS follows SW
+	mock_RCC.CFGR = (mock_RCC.CFGR & ~(0b11u << 2)) | ((mock_RCC.CFGR & 0b11) << 2);
+
+	// Doc: RM0440-6.4.1 & 6.4.6 | The regulator is always settled & REGLPF follows LPR
+	mock_PWR.SR2 = (mock_PWR.SR2 & ~((1u << 9) | (1u << 10))) | (((mock_PWR.CR1 >> 14) & 1) << 9);
+
+	if (mock_DWT.CTRL & (1 << 0)) {
+		mock_DWT.CYCCNT += MOCK_CYCLES_PER_POLL;
+	}
+}
+
+
+
+/*
+ * TIM
+ */
+const uint16_t NUM_TIMERS = 11;
+TIM_TypeDef mock_TIMs[NUM_TIMERS];
+TIM_TypeDef *TIM1 = &mock_TIMs[0];
+TIM_TypeDef *TIM2 = &mock_TIMs[1];
+TIM_TypeDef *TIM3 = &mock_TIMs[2];
+TIM_TypeDef *TIM4 = &mock_TIMs[3];
+TIM_TypeDef *TIM6 = &mock_TIMs[4];
+TIM_TypeDef *TIM7 = &mock_TIMs[5];
+TIM_TypeDef *TIM8 = &mock_TIMs[6];
+TIM_TypeDef *TIM15 = &mock_TIMs[7];
+TIM_TypeDef *TIM16 = &mock_TIMs[8];
+TIM_TypeDef *TIM17 = &mock_TIMs[9];
+TIM_TypeDef *TIM20 = &mock_TIMs[10];
+
+
+// Runs the DMA burst one update event requests, each beat written to DMAR lands in the next register from DBA.
+// Doc: RM0440-29.5.25-29.5.26
+void trigger_TIM_burst(TIM_TypeDef *timer, uint16_t request)
+{
+	const uint32_t base = timer->DCR & 0x1F;
+	const uint32_t length = ((timer->DCR >> 8) & 0x1F) + 1;
+	if (!(timer->DIER & (1 << 8))) {
+		return;
+	}
+	for (uint32_t beat = 0; beat < length; beat++) {
+		trigger_DMA_request(request);
+		(&timer->CR1)[base + beat] = timer->DMAR;
+	}
+}
+
+
+// Captures a sequence of counter values on a channel, raising its DMA request after each one when CCxDE is set.
+// Doc: RM0440-29.3.7
+void feed_TIM_capture(TIM_TypeDef *timer, uint32_t channel, const uint32_t *counts, uint32_t length, uint16_t request)
+{
+	for (uint32_t i = 0; i < length; i++) {
+		(&timer->CCR1)[channel - 1] = counts[i];
+		if (timer->DIER & (1u << (8 + channel))) {
+			trigger_DMA_request(request);
+		}
+	}
+}
+
+
+
+/*
+ * DMA & DMAMUX
+ */
+const uint16_t NUM_DMA_CHANNELS = 16;
+DMA_TypeDef mock_DMAs[2];
+DMA_TypeDef *DMA1 = &mock_DMAs[0];
+DMA_TypeDef *DMA2 = &mock_DMAs[1];
+
+DMA_Channel_TypeDef mock_DMA_channels[NUM_DMA_CHANNELS];
+DMA_Channel_TypeDef *DMA1_Channel1 = &mock_DMA_channels[0];
+DMA_Channel_TypeDef *DMA1_Channel2 = &mock_DMA_channels[1];
+DMA_Channel_TypeDef *DMA1_Channel3 = &mock_DMA_channels[2];
+DMA_Channel_TypeDef *DMA1_Channel4 = &mock_DMA_channels[3];
+DMA_Channel_TypeDef *DMA1_Channel5 = &mock_DMA_channels[4];
+DMA_Channel_TypeDef *DMA1_Channel6 = &mock_DMA_channels[5];
+DMA_Channel_TypeDef *DMA1_Channel7 = &mock_DMA_channels[6];
+DMA_Channel_TypeDef *DMA1_Channel8 = &mock_DMA_channels[7];
+DMA_Channel_TypeDef *DMA2_Channel1 = &mock_DMA_channels[8];
+DMA_Channel_TypeDef *DMA2_Channel2 = &mock_DMA_channels[9];
+DMA_Channel_TypeDef *DMA2_Channel3 = &mock_DMA_channels[10];
+DMA_Channel_TypeDef *DMA2_Channel4 = &mock_DMA_channels[11];
+DMA_Channel_TypeDef *DMA2_Channel5 = &mock_DMA_channels[12];
+DMA_Channel_TypeDef *DMA2_Channel6 = &mock_DMA_channels[13];
+DMA_Channel_TypeDef *DMA2_Channel7 = &mock_DMA_channels[14];
+DMA_Channel_TypeDef *DMA2_Channel8 = &mock_DMA_channels[15];
+
+DMAMUX_Channel_TypeDef mock_DMAMUX_channels[NUM_DMA_CHANNELS];
+DMAMUX_Channel_TypeDef *DMAMUX1 = &mock_DMAMUX_channels[0];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel0 = &mock_DMAMUX_channels[0];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel1 = &mock_DMAMUX_channels[1];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel2 = &mock_DMAMUX_channels[2];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel3 = &mock_DMAMUX_channels[3];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel4 = &mock_DMAMUX_channels[4];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel5 = &mock_DMAMUX_channels[5];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel6 = &mock_DMAMUX_channels[6];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel7 = &mock_DMAMUX_channels[7];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel8 = &mock_DMAMUX_channels[8];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel9 = &mock_DMAMUX_channels[9];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel10 = &mock_DMAMUX_channels[10];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel11 = &mock_DMAMUX_channels[11];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel12 = &mock_DMAMUX_channels[12];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel13 = &mock_DMAMUX_channels[13];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel14 = &mock_DMAMUX_channels[14];
+DMAMUX_Channel_TypeDef *DMAMUX1_Channel15 = &mock_DMAMUX_channels[15];
+
+const uint16_t NUM_DMAMUX_GENERATORS = 4;
+DMAMUX_RequestGen_TypeDef mock_DMAMUX_generators[NUM_DMAMUX_GENERATORS];
+DMAMUX_RequestGen_TypeDef *DMAMUX1_RequestGenerator0 = &mock_DMAMUX_generators[0];
+DMAMUX_RequestGen_TypeDef *DMAMUX1_RequestGenerator1 = &mock_DMAMUX_generators[1];
+DMAMUX_RequestGen_TypeDef *DMAMUX1_RequestGenerator2 = &mock_DMAMUX_generators[2];
+DMAMUX_RequestGen_TypeDef *DMAMUX1_RequestGenerator3 = &mock_DMAMUX_generators[3];
+DMAMUX_ChannelStatus_TypeDef mock_DMAMUX_channel_status;
+DMAMUX_ChannelStatus_TypeDef *DMAMUX1_ChannelStatus = &mock_DMAMUX_channel_status;
+DMAMUX_RequestGenStatus_TypeDef mock_DMAMUX_generator_status;
+DMAMUX_RequestGenStatus_TypeDef *DMAMUX1_RequestGenStatus = &mock_DMAMUX_generator_status;
+
+// Requests still to be let through a synchronized channel & still to be sent by a generator
+uint32_t mock_DMAMUX_sync_budgets[NUM_DMA_CHANNELS];
+uint32_t mock_DMAMUX_generator_pending[NUM_DMAMUX_GENERATORS];
+
+
+// The hardware keeps the programmed CNDTR value internally for circular reloads, the mock keeps it here
+typedef struct {
+	uint32_t reload;
+	uint32_t last_count;
+	uintptr_t cpar;
+	uintptr_t cmar;
+} Mock_DMA_Shadow_t;
+
+Mock_DMA_Shadow_t mock_DMA_shadows[NUM_DMA_CHANNELS];
+
+
+// Performs a single DMA beat on a channel and updates its flags, Doc: RM0440-12.4
+static void service_DMA_channel(uint16_t index)
+{
+	DMA_Channel_TypeDef &channel = mock_DMA_channels[index];
+	DMA_TypeDef &dma = mock_DMAs[index / 8];
+	Mock_DMA_Shadow_t &shadow = mock_DMA_shadows[index];
+	const uint32_t flag_shift = 4 * (index % 8);
+
+	// Flags written to IFCR since the last beat are cleared in ISR
+	dma.ISR &= ~dma.IFCR;
+	dma.IFCR = 0;
+
+	if (!(channel.CCR & (1 << 0))) {
+		shadow.last_count = UINT32_MAX;
+		return;
+	}
+
+	// Anything but the mock changing CNDTR or the addresses means the channel was reprogrammed
+	if (channel.CNDTR != shadow.last_count || channel.CPAR != shadow.cpar || channel.CMAR != shadow.cmar) {
+		shadow.reload = channel.CNDTR;
+		shadow.cpar = channel.CPAR;
+		shadow.cmar = channel.CMAR;
+	}
+	if (channel.CNDTR == 0) {
+		shadow.last_count = 0;
+		return;
+	}
+
+	const uint32_t offset = shadow.reload - channel.CNDTR;
+	const uint32_t psize = 1u << ((channel.CCR >> 8) & 0b11);
+	const uint32_t msize = 1u << ((channel.CCR >> 10) & 0b11);
+	uint8_t *peripheral = reinterpret_cast<uint8_t *>(channel.CPAR + ((channel.CCR & (1 << 6)) ? offset * psize : 0));
+	uint8_t *memory = reinterpret_cast<uint8_t *>(channel.CMAR + ((channel.CCR & (1 << 7)) ? offset * msize : 0));
+
+	uint32_t data = 0;
+	if (channel.CCR & (1 << 4)) {
+		memcpy(&data, memory, msize);
+		memcpy(peripheral, &data, psize);
+	} else {
+		memcpy(&data, peripheral, psize);
+		memcpy(memory, &data, msize);
+	}
+
+	channel.CNDTR--;
+	if (channel.CNDTR == shadow.reload / 2) {
+		dma.ISR |= (0b0101u << flag_shift);     // GIF & HTIF
+	}
+	if (channel.CNDTR == 0) {
+		dma.ISR |= (0b0011u << flag_shift);     // GIF & TCIF
+		if (channel.CCR & (1 << 5)) {
+			channel.CNDTR = shadow.reload;
+		}
+	}
+	shadow.last_count = channel.CNDTR;
+
+	// Doc: RM0440-12.6.3 | TCIE & HTIE gate the channel interrupt
+	const IRQn_Type DMA_IRQS[NUM_DMA_CHANNELS] = {
+		DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+		DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn, DMA1_Channel8_IRQn,
+		DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn, DMA2_Channel4_IRQn,
+		DMA2_Channel5_IRQn, DMA2_Channel6_IRQn, DMA2_Channel7_IRQn, DMA2_Channel8_IRQn
+	};
+	const uint32_t enabled_flags = (channel.CCR & (0b0110)) << flag_shift;
+	if (dma.ISR & enabled_flags) {
+		raise_IRQ(DMA_IRQS[index]);
+	}
+}
+
+
+// Runs one beat on every enabled DMA channel routed to the DMAMUX request, Doc: RM0440-13.3.
+// A synchronized channel only lets requests through after a sync event, NBREQ + 1 of them per event.
+void trigger_DMA_request(uint16_t request)
+{
+	for (uint16_t i = 0; i < NUM_DMA_CHANNELS; i++) {
+		const uint32_t mux = mock_DMAMUX_channels[i].CCR;
+		if ((mux & 0x7F) != request || (mock_DMA_channels[i].CCR & (1 << 14))) {
+			continue;
+		}
+		if (mux & (1 << 16)) {
+			if (mock_DMAMUX_sync_budgets[i] == 0) {
+				continue;
+			}
+			mock_DMAMUX_sync_budgets[i]--;
+		}
+		service_DMA_channel(i);
+
+		// Doc: RM0440-13.4.4 | Channels 0-3 send an event on dmamux_evt0-3 every NBREQ + 1 requests
+		if ((mux & (1 << 9)) && i < 4 && (!(mux & (1 << 16)) || mock_DMAMUX_sync_budgets[i] == 0)) {
+			trigger_DMAMUX_signal(static_cast<uint16_t>(16 + i), true);
+		}
+	}
+}
+
+
+// Applies the flag clears written to CFR & RGCFR
+void update_DMAMUX_status()
+{
+	mock_DMAMUX_channel_status.CSR &= ~mock_DMAMUX_channel_status.CFR;
+	mock_DMAMUX_channel_status.CFR = 0;
+	mock_DMAMUX_generator_status.RGSR &= ~mock_DMAMUX_generator_status.RGCFR;
+	mock_DMAMUX_generator_status.RGCFR = 0;
+}
+
+
+// An edge on a DMAMUX trigger & synchronization input, e.g. EXTI line 0-15 or LPTIM1_OUT, Doc: RM0440-13.3.3-13.3.4.
+// A generator or a synchronized channel that is still busy with the last edge's requests overruns.
+void trigger_DMAMUX_signal(uint16_t signal, bool rising)
+{
+	update_DMAMUX_status();
+	const uint32_t edge = rising ? 0b01 : 0b10;
+	bool overrun = false;
+
+	for (uint16_t i = 0; i < NUM_DMA_CHANNELS; i++) {
+		const uint32_t mux = mock_DMAMUX_channels[i].CCR;
+		if ((mux & (1 << 16)) && ((mux >> 24) & 0x1F) == signal && ((mux >> 17) & edge)) {
+			if (mock_DMAMUX_sync_budgets[i] != 0) {
+				mock_DMAMUX_channel_status.CSR |= 1u << i;
+				overrun = overrun || (mux & (1 << 8));
+			}
+			mock_DMAMUX_sync_budgets[i] = ((mux >> 19) & 0x1F) + 1;
+		}
+	}
+
+	for (uint16_t g = 0; g < NUM_DMAMUX_GENERATORS; g++) {
+		const uint32_t control = mock_DMAMUX_generators[g].RGCR;
+		if (!(control & (1 << 16)) || (control & 0x1F) != signal || !((control >> 17) & edge)) {
+			continue;
+		}
+		if (mock_DMAMUX_generator_pending[g] != 0) {
+			mock_DMAMUX_generator_status.RGSR |= 1u << g;
+			overrun = overrun || (control & (1 << 8));
+		}
+		mock_DMAMUX_generator_pending[g] = ((control >> 19) & 0x1F) + 1;
+
+		// The generated requests are taken as fast as a channel routed to them is enabled to take them
+		const uint16_t request = static_cast<uint16_t>(1 + g);
+		for (uint16_t i = 0; i < NUM_DMA_CHANNELS && mock_DMAMUX_generator_pending[g] != 0; i++) {
+			while ((mock_DMAMUX_channels[i].CCR & 0x7F) == request && (mock_DMA_channels[i].CCR & (1 << 0))
+			       && mock_DMA_channels[i].CNDTR != 0 && mock_DMAMUX_generator_pending[g] != 0) {
+				mock_DMAMUX_generator_pending[g]--;
+				service_DMA_channel(i);
+			}
+		}
+	}
+
+	if (overrun) {
+		raise_IRQ(DMAMUX_OVR_IRQn);
+	}
+}
+
+
+// Runs every enabled memory-to-memory channel to completion, the hardware doesn't wait for a request.
+// Returns whether any channel ran, Doc: RM0440-12.4.5
+bool run_DMA_mem2mem()
+{
+	bool ran = false;
+	for (uint16_t i = 0; i < NUM_DMA_CHANNELS; i++) {
+		DMA_Channel_TypeDef &channel = mock_DMA_channels[i];
+		while ((channel.CCR & (1 << 14)) && (channel.CCR & (1 << 0)) && channel.CNDTR != 0) {
+			service_DMA_channel(i);
+			ran = true;
+		}
+	}
+	return ran;
+}
+
+
+// Counts a job's done callback, context is its Mock_DMA_Done_t
+void record_DMA_done(bool completed, void *context)
+{
+	Mock_DMA_Done_t &done = *static_cast<Mock_DMA_Done_t *>(context);
+	done.count++;
+	done.completed = completed;
+}
+
+
+
+/*
+ * EXTI
+ */
+EXTI_TypeDef mock_EXTI;
+EXTI_TypeDef *EXTI = &mock_EXTI;
+
+
+
+/*
+ * LPTIM
+ */
+LPTIM_TypeDef mock_LPTIM1;
+LPTIM_TypeDef *LPTIM1 = &mock_LPTIM1;
+
+
+// Applies flags written to ICR & completes CMP & ARR writes, called whenever a driver reads an LPTIM1 register,
+// Doc: RM0440-32.7.1-32.7.2
+void update_LPTIM_status()
+{
+	mock_LPTIM1.ISR &= ~mock_LPTIM1.ICR;
+	mock_LPTIM1.ICR = 0;
+	mock_LPTIM1.ISR |= (1 << 3) | (1 << 4);
+}
+
+
+// Counts an enabled LPTIM forward tick by tick, raising its interrupt on every tick that sets an enabled flag.
+// Returns whether an interrupt was raised, Doc: RM0440-32.4.9
+bool advance_LPTIM(LPTIM_TypeDef *lptim, uint32_t ticks)
+{
+	bool raised = false;
+	if (!(lptim->CR & (1 << 0))) {
+		return raised;
+	}
+	for (uint32_t tick = 0; tick < ticks; tick++) {
+		lptim->CNT = (lptim->CNT >= lptim->ARR) ? 0 : lptim->CNT + 1;
+		if (lptim->CNT == lptim->CMP) {
+			lptim->ISR |= (1 << 0);     // CMPM
+		}
+		if (lptim->CNT == lptim->ARR) {
+			lptim->ISR |= (1 << 1);     // ARRM
+		}
+		if (lptim->ISR & lptim->IER & 0b11) {
+			raise_IRQ(LPTIM1_IRQn);
+			update_LPTIM_status();
+			raised = true;
+		}
+	}
+	return raised;
+}
+
+
+// Sleeps until a memory-to-memory DMA finishes or LPTIM1 raises an interrupt. Stop modes wake up on HSI16 with HSE
+// & the PLL off, Doc: PM0214-4.4.6 & RM0440-6.3.5
+void mock_WFI()
+{
+	if (run_DMA_mem2mem()) {
+		return;
+	}
+	if (mock_SCB.SCR & (1 << 2)) {
+		mock_RCC.CR &= ~((1u << 16) | (1u << 17) | (1u << 24) | (1u << 25));
+		mock_RCC.CFGR = (mock_RCC.CFGR & ~0b1111u) | 0b0101;
+	}
+	for (uint32_t tick = 0; tick <= 0xFFFF; tick++) {
+		if (advance_LPTIM(LPTIM1, 1)) {
+			return;
+		}
+	}
+}
+
+
+
+/*
+ * USART
+ */
+const uint16_t NUM_USARTS = 6;
+const uint32_t USART_FIFO_DEPTH = 8;
+USART_TypeDef mock_USARTs[NUM_USARTS];
+USART_TypeDef *USART1 = &mock_USARTs[0];
+USART_TypeDef *USART2 = &mock_USARTs[1];
+USART_TypeDef *USART3 = &mock_USARTs[2];
+USART_TypeDef *UART4 = &mock_USARTs[3];
+USART_TypeDef *UART5 = &mock_USARTs[4];
+USART_TypeDef *LPUART1 = &mock_USARTs[5];
+
+typedef struct {
+	uint8_t rx[USART_FIFO_DEPTH];
+	uint32_t rx_count;
+	uint8_t tx[USART_FIFO_DEPTH];
+	uint32_t tx_count;
+	bool enabled;
+} Mock_USART_FIFO_t;
+
+Mock_USART_FIFO_t mock_USART_FIFOs[NUM_USARTS];
+
+
+static IRQn_Type USART_irq(const USART_TypeDef *usart)
+{
+	const IRQn_Type IRQS[NUM_USARTS] = {USART1_IRQn, USART2_IRQn, USART3_IRQn, UART4_IRQn, UART5_IRQn, LPUART1_IRQn};
+	return IRQS[usart - mock_USARTs];
+}
+
+
+// Doc: RM0440-37.5.3 | FIFOEN gives 8 entries each way, without it RDR & TDR are a single entry
+static uint32_t USART_depth(const USART_TypeDef *usart)
+{
+	return (usart->CR1 & (1 << 29)) ? USART_FIFO_DEPTH : 1;
+}
+
+
+// Doc: RM0440-37.8.3 | RXFTCFG & TXFTCFG in entries
+static uint32_t USART_threshold(uint32_t config)
+{
+	const uint32_t levels[8] = {1, 2, 4, 6, 7, 8, 8, 8};
+	return levels[config & 0b111];
+}
+
+
+// RXFNE, TXFNF, TXFE, RXFF, RXFT & TXFT from the FIFO levels. TXFT is set once the TX FIFO has at least the
+// threshold's worth of free entries. Clearing UE flushes both FIFOs
+static void update_USART_FIFO_flags(USART_TypeDef *usart)
+{
+	Mock_USART_FIFO_t &fifo = mock_USART_FIFOs[usart - mock_USARTs];
+	const bool enabled = usart->CR1 & (1 << 0);
+	if (!enabled && fifo.enabled) {
+		fifo.rx_count = 0;
+		fifo.tx_count = 0;
+	}
+	fifo.enabled = enabled;
+
+	const uint32_t depth = USART_depth(usart);
+	const uint32_t flags = (1 << 5) | (1 << 7) | (1 << 23) | (1 << 24) | (1u << 26) | (1u << 27);
+	uint32_t isr = usart->ISR & ~flags;
+	if (fifo.rx_count != 0) {
+		isr |= (1 << 5);
+		usart->RDR = fifo.rx[0];
+	}
+	if (fifo.tx_count < depth) {
+		isr |= (1 << 7);
+	}
+	if (fifo.tx_count == 0) {
+		isr |= (1 << 23);
+	}
+	if (fifo.rx_count == depth) {
+		isr |= (1 << 24);
+	}
+	if (depth > 1 && fifo.rx_count >= USART_threshold(usart->CR3 >> 25)) {
+		isr |= (1u << 26);
+	}
+	if (depth > 1 && depth - fifo.tx_count >= USART_threshold(usart->CR3 >> 29)) {
+		isr |= (1u << 27);
+	}
+	usart->ISR = isr;
+}
+
+
+// Doc: RM0440-37.8.1 & 37.8.3 | ORE & EIE, RXFNE & RXFNEIE, TXFNF & TXFNFIE, IDLE & IDLEIE, RTOF & RTOIE,
+// RXFT & RXFTIE, TXFT & TXFTIE, CMF & CMIE
+static void check_USART_IRQ(USART_TypeDef *usart)
+{
+	const uint32_t isr = usart->ISR;
+	const uint32_t cr1 = usart->CR1;
+	const uint32_t cr3 = usart->CR3;
+	if (((isr & (1 << 3)) && (cr3 & (1 << 0))) || ((isr & (1 << 5)) && (cr1 & (1 << 5)))
+	    || ((isr & (1 << 7)) && (cr1 & (1 << 7))) || ((isr & (1 << 4)) && (cr1 & (1 << 4)))
+	    || ((isr & (1 << 11)) && (cr1 & (1 << 26))) || ((isr & (1u << 26)) && (cr3 & (1 << 28)))
+	    || ((isr & (1u << 27)) && (cr3 & (1 << 23))) || ((isr & (1 << 17)) && (cr1 & (1 << 14)))) {
+		raise_IRQ(USART_irq(usart));
+	}
+}
+
+
+// Applies the flag clears written to ICR, Doc: RM0440-37.8.11
+void update_USART_status(USART_TypeDef *usart)
+{
+	usart->ISR &= ~usart->ICR;
+	usart->ICR = 0;
+	update_USART_FIFO_flags(usart);
+}
+
+
+// Receives bytes one after another, each read from RDR by the DMA request when DMAR is set.
+// Doc: RM0440-37.5.3 | A byte arriving with the RX FIFO full sets ORE instead, one matching ADD sets CMF
+void feed_USART(USART_TypeDef *usart, const uint8_t *data, uint32_t length, uint16_t request)
+{
+	Mock_USART_FIFO_t &fifo = mock_USART_FIFOs[usart - mock_USARTs];
+	for (uint32_t i = 0; i < length; i++) {
+		update_USART_status(usart);
+		if (!(usart->CR1 & (1 << 0)) || !(usart->CR1 & (1 << 2))) {
+			continue;
+		}
+		if (fifo.rx_count == USART_depth(usart)) {
+			usart->ISR |= (1 << 3);
+		} else {
+			fifo.rx[fifo.rx_count++] = data[i];
+		}
+		update_USART_FIFO_flags(usart);
+		if (usart->CR3 & (1 << 6)) {
+			trigger_DMA_request(request);
+			(void) read_USART_RDR(usart);
+		}
+		if (data[i] == (usart->CR2 >> 24)) {
+			usart->ISR |= (1 << 17);
+		}
+		check_USART_IRQ(usart);
+	}
+}
+
+
+// The line goes quiet after a burst, setting IDLE & RTOF when the receiver timeout is on.
+// Doc: RM0440-37.8.10 | IDLEIE & RTOIE raise the interrupt
+void idle_USART(USART_TypeDef *usart)
+{
+	update_USART_status(usart);
+	usart->ISR |= (1 << 4);
+	if (usart->CR2 & (1 << 23)) {
+		usart->ISR |= (1 << 11);
+	}
+	check_USART_IRQ(usart);
+	update_USART_status(usart);
+}
+
+
+// Shifts out what the driver wrote to the TX FIFO, or what the DMA writes to TDR while a channel has items left
+// for the request. Interrupts run as the FIFO empties, returns the bytes sent
+uint32_t drain_USART(USART_TypeDef *usart, uint8_t *data, uint32_t max_length, uint16_t request)
+{
+	Mock_USART_FIFO_t &fifo = mock_USART_FIFOs[usart - mock_USARTs];
+	uint32_t sent = 0;
+	while (sent < max_length && (usart->CR1 & (1 << 3))) {
+		update_USART_status(usart);
+		check_USART_IRQ(usart);
+		if (fifo.tx_count != 0) {
+			data[sent++] = fifo.tx[0];
+			fifo.tx_count--;
+			memmove(fifo.tx, fifo.tx + 1, fifo.tx_count);
+			continue;
+		}
+
+		bool pending = false;
+		for (uint16_t i = 0; i < NUM_DMA_CHANNELS; i++) {
+			pending = pending || ((mock_DMAMUX_channels[i].CCR & 0x7F) == request
+			                      && (mock_DMA_channels[i].CCR & (1 << 0)) && mock_DMA_channels[i].CNDTR != 0);
+		}
+		if (!pending || !(usart->CR3 & (1 << 7))) {
+			break;
+		}
+		trigger_DMA_request(request);
+		data[sent++] = static_cast<uint8_t>(usart->TDR);
+	}
+	return sent;
+}
+
+
+// Reading RDR pops the RX FIFO
+uint8_t read_USART_RDR(USART_TypeDef *usart)
+{
+	Mock_USART_FIFO_t &fifo = mock_USART_FIFOs[usart - mock_USARTs];
+	const uint8_t value = static_cast<uint8_t>(usart->RDR);
+	if (fifo.rx_count != 0) {
+		fifo.rx_count--;
+		memmove(fifo.rx, fifo.rx + 1, fifo.rx_count);
+	}
+	update_USART_FIFO_flags(usart);
+	return value;
+}
+
+
+// Writing TDR pushes onto the TX FIFO, a write with it full is lost
+void write_USART_TDR(USART_TypeDef *usart, uint8_t value)
+{
+	Mock_USART_FIFO_t &fifo = mock_USART_FIFOs[usart - mock_USARTs];
+	usart->TDR = value;
+	if ((usart->CR1 & (1 << 3)) && fifo.tx_count < USART_depth(usart)) {
+		fifo.tx[fifo.tx_count++] = value;
+	}
+	update_USART_FIFO_flags(usart);
+}
+
+
+
+/*
+ * HAL register & core access
+ */
+// Linked in place of stm32g491_core.cc, so what the drivers read & write moves the mock on the way the
+// hardware would by itself
+namespace {
+	template<typename Block>
+	bool within(volatile const uint32_t *const reg, const Block &block)
+	{
+		const uintptr_t ADDRESS = reinterpret_cast<uintptr_t>(reg);
+		const uintptr_t START = reinterpret_cast<uintptr_t>(&block);
+		return ADDRESS >= START && ADDRESS < START + sizeof(Block);
+	}
+}
+
+
+uint32_t Chip::HAL::read_register(volatile const uint32_t *const reg)
+{
+	// A memory-to-memory channel doesn't wait for requests, so it has moved on by the time its count is read
+	for (const DMA_Channel_TypeDef &channel : mock_DMA_channels) {
+		if (reg == &channel.CNDTR) {
+			run_DMA_mem2mem();
+		}
+	}
+	if (within(reg, mock_RCC) || within(reg, mock_PWR)) {
+		update_RCC_PWR_status();
+	}
+	if (within(reg, mock_LPTIM1)) {
+		update_LPTIM_status();
+	}
+	for (USART_TypeDef &usart : mock_USARTs) {
+		if (reg == &usart.RDR) {
+			return read_USART_RDR(&usart);
+		}
+	}
+	if (reg == &mock_DWT.CYCCNT) {
+		// The count as it was at the read, the time the read took comes after
+		const uint32_t CYCLES = *reg;
+		update_RCC_PWR_status();
+		return CYCLES;
+	}
+	return *reg;
+}
+
+
+void Chip::HAL::write_register(volatile uint32_t *const reg, uint32_t val)
+{
+	*reg = val;
+
+	// Doc: PM0214-4.3.3 | Writing 1 to ICER disables the interrupt, which ISER reads back
+	if (within(reg, mock_NVIC.ICER)) {
+		mock_NVIC.ISER[reg - mock_NVIC.ICER] &= ~val;
+	}
+	for (GPIO_TypeDef &port : mock_GPIO_ports) {
+		if (reg == &port.BSRR) {
+			record_GPIO_BSRR(&port, val);
+		}
+	}
+	for (USART_TypeDef &usart : mock_USARTs) {
+		if (reg == &usart.TDR) {
+			write_USART_TDR(&usart, static_cast<uint8_t>(val));
+		}
+	}
+}
+
+
+void Chip::HAL::set_register(volatile uint32_t *const reg, uint32_t val)
+{
+	Chip::HAL::write_register(reg, Chip::HAL::read_register(reg) | val);
+}
+
+
+void Chip::HAL::clear_register(volatile uint32_t *const reg, uint32_t val)
+{
+	Chip::HAL::write_register(reg, Chip::HAL::read_register(reg) & ~val);
+}
+
+
+void Chip::HAL::write_address(volatile Address_t *const reg, volatile const void *const address)
+{
+	*reg = reinterpret_cast<uintptr_t>(address);
+}
+
+
+// The tests run single threaded, the handlers are called straight from raise_IRQ()
+uint32_t Chip::HAL::enter_critical()
+{
+	return 0;
+}
+
+
+void Chip::HAL::exit_critical(const uint32_t primask)
+{
+	(void) primask;
+}
+
+
+void Chip::HAL::wait_for_interrupt()
+{
+	mock_WFI();
+}
@@ -6,7 +6,7 @@
 // License      : MIT
 // Copyright    : (C) 2023, Liam Lawrence
 //
-// Updated      : February 25, 2023
+// Updated      : October 19, 2026
 //------------------------------------------------------------------------------
 
 #ifndef STM32G4_MODULE_LIBRARY_MOCK_HH
@@ -16,6 +16,162 @@
 
 
 
+/**
+  * @brief STM32G4XX Interrupt Number Definition
+  */
+
+typedef enum {
+	WWDG_IRQn                   = 0,
+	PVD_PVM_IRQn                = 1,
+	RTC_TAMP_LSECSS_IRQn        = 2,
+	RTC_WKUP_IRQn               = 3,
+	FLASH_IRQn                  = 4,
+	RCC_IRQn                    = 5,
+	EXTI0_IRQn                  = 6,
+	EXTI1_IRQn                  = 7,
+	EXTI2_IRQn                  = 8,
+	EXTI3_IRQn                  = 9,
+	EXTI4_IRQn                  = 10,
+	DMA1_Channel1_IRQn          = 11,
+	DMA1_Channel2_IRQn          = 12,
+	DMA1_Channel3_IRQn          = 13,
+	DMA1_Channel4_IRQn          = 14,
+	DMA1_Channel5_IRQn          = 15,
+	DMA1_Channel6_IRQn          = 16,
+	DMA1_Channel7_IRQn          = 17,
+	ADC1_2_IRQn                 = 18,
+	USB_HP_IRQn                 = 19,
+	USB_LP_IRQn                 = 20,
+	FDCAN1_IT0_IRQn             = 21,
+	FDCAN1_IT1_IRQn             = 22,
+	EXTI9_5_IRQn                = 23,
+	TIM1_BRK_TIM15_IRQn         = 24,
+	TIM1_UP_TIM16_IRQn          = 25,
+	TIM1_TRG_COM_TIM17_IRQn     = 26,
+	TIM1_CC_IRQn                = 27,
+	TIM2_IRQn                   = 28,
+	TIM3_IRQn                   = 29,
+	TIM4_IRQn                   = 30,
+	I2C1_EV_IRQn                = 31,
+	I2C1_ER_IRQn                = 32,
+	I2C2_EV_IRQn                = 33,
+	I2C2_ER_IRQn                = 34,
+	SPI1_IRQn                   = 35,
+	SPI2_IRQn                   = 36,
+	USART1_IRQn                 = 37,
+	USART2_IRQn                 = 38,
+	USART3_IRQn                 = 39,
+	EXTI15_10_IRQn              = 40,
+	RTC_Alarm_IRQn              = 41,
+	USBWakeUp_IRQn              = 42,
+	TIM8_BRK_IRQn               = 43,
+	TIM8_UP_IRQn                = 44,
+	TIM8_TRG_COM_IRQn           = 45,
+	TIM8_CC_IRQn                = 46,
+	ADC3_IRQn                   = 47,
+	LPTIM1_IRQn                 = 49,
+	SPI3_IRQn                   = 51,
+	UART4_IRQn                  = 52,
+	UART5_IRQn                  = 53,
+	TIM6_DAC_IRQn               = 54,
+	TIM7_IRQn                   = 55,
+	DMA2_Channel1_IRQn          = 56,
+	DMA2_Channel2_IRQn          = 57,
+	DMA2_Channel3_IRQn          = 58,
+	DMA2_Channel4_IRQn          = 59,
+	DMA2_Channel5_IRQn          = 60,
+	UCPD1_IRQn                  = 63,
+	COMP1_2_3_IRQn              = 64,
+	COMP4_IRQn                  = 65,
+	CRS_IRQn                    = 75,
+	SAI1_IRQn                   = 76,
+	TIM20_BRK_IRQn              = 77,
+	TIM20_UP_IRQn               = 78,
+	TIM20_TRG_COM_IRQn          = 79,
+	TIM20_CC_IRQn               = 80,
+	FPU_IRQn                    = 81,
+	FDCAN2_IT0_IRQn             = 86,
+	FDCAN2_IT1_IRQn             = 87,
+	RNG_IRQn                    = 90,
+	LPUART1_IRQn                = 91,
+	I2C3_EV_IRQn                = 92,
+	I2C3_ER_IRQn                = 93,
+	DMAMUX_OVR_IRQn             = 94,
+	QUADSPI_IRQn                = 95,
+	DMA1_Channel8_IRQn          = 96,
+	DMA2_Channel6_IRQn          = 97,
+	DMA2_Channel7_IRQn          = 98,
+	DMA2_Channel8_IRQn          = 99,
+	CORDIC_IRQn                 = 100,
+	FMAC_IRQn                   = 101
+} IRQn_Type;
+
+
+/**
+  * @brief Nested Vectored Interrupt Controller
+  */
+
+typedef struct {
+	uint32_t ISER[8U];          /*!< Interrupt Set Enable Register           */
+	uint32_t RESERVED0[24U];
+	uint32_t ICER[8U];          /*!< Interrupt Clear Enable Register         */
+	uint32_t RESERVED1[24U];
+	uint32_t ISPR[8U];          /*!< Interrupt Set Pending Register          */
+	uint32_t RESERVED2[24U];
+	uint32_t ICPR[8U];          /*!< Interrupt Clear Pending Register        */
+	uint32_t RESERVED3[24U];
+	uint32_t IABR[8U];          /*!< Interrupt Active bit Register           */
+	uint32_t RESERVED4[56U];
+	uint8_t IP[240U];           /*!< Interrupt Priority Register (8Bit wide) */
+	uint32_t RESERVED5[644U];
+	uint32_t STIR;              /*!< Software Trigger Interrupt Register     */
+} NVIC_Type;
+
+extern NVIC_Type *NVIC;
+
+void raise_IRQ(IRQn_Type irq);
+
+
+/**
+  * @brief Debug & Data Watchpoint and Trace
+  */
+
+typedef struct {
+	uint32_t DHCSR;             /*!< Debug Halting Control and Status Register    */
+	uint32_t DCRSR;             /*!< Debug Core Register Selector Register        */
+	uint32_t DCRDR;             /*!< Debug Core Register Data Register            */
+	uint32_t DEMCR;             /*!< Debug Exception and Monitor Control Register */
+} CoreDebug_Type;
+
+typedef struct {
+	uint32_t CTRL;              /*!< Control Register     */
+	uint32_t CYCCNT;            /*!< Cycle Count Register */
+} DWT_Type;
+
+extern CoreDebug_Type *CoreDebug;
+extern DWT_Type *DWT;
+
+
+/**
+  * @brief System Control Block
+  */
+
+typedef struct {
+	uint32_t CPUID;             /*!< CPUID Base Register                                   */
+	uint32_t ICSR;              /*!< Interrupt Control and State Register                  */
+	uint32_t VTOR;              /*!< Vector Table Offset Register                          */
+	uint32_t AIRCR;             /*!< Application Interrupt and Reset Control Register      */
+	uint32_t SCR;               /*!< System Control Register                               */
+} SCB_Type;
+
+extern SCB_Type *SCB;
+
+// CMSIS's core clock frequency, kept by system_stm32g4xx.c on the chip
+extern uint32_t SystemCoreClock;
+
+void mock_WFI();
+
+
 /**
   * @brief General Purpose I/O
   */
@@ -42,8 +198,19 @@ extern GPIO_TypeDef *GPIOF;
 extern GPIO_TypeDef *GPIOG;
 
 void update_GPIO_BSRR();
+void record_GPIO_BSRR(GPIO_TypeDef *port, uint32_t value);
+void feed_GPIO_IDR(GPIO_TypeDef *port, const uint16_t *samples, uint32_t length, uint16_t request);
 uint16_t port2int(GPIO_TypeDef *port);
 
+typedef struct {
+	GPIO_TypeDef *port;
+	uint32_t bsrr;
+} Mock_GPIO_Write_t;
+
+extern bool mock_GPIO_logging;
+extern Mock_GPIO_Write_t mock_GPIO_writes[];
+extern uint32_t mock_GPIO_num_writes;
+
 
 /**
   * @brief Reset and Clock Control
@@ -94,5 +261,265 @@ typedef struct {
 
 extern RCC_TypeDef *RCC;
 
+void update_RCC_PWR_status();
+
+
+/**
+  * @brief Power Control
+  */
+
+typedef struct {
+	uint32_t CR1;           /*!< PWR power control register 1,        Address offset: 0x00 */
+	uint32_t CR2;           /*!< PWR power control register 2,        Address offset: 0x04 */
+	uint32_t CR3;           /*!< PWR power control register 3,        Address offset: 0x08 */
+	uint32_t CR4;           /*!< PWR power control register 4,        Address offset: 0x0C */
+	uint32_t SR1;           /*!< PWR power status register 1,         Address offset: 0x10 */
+	uint32_t SR2;           /*!< PWR power status register 2,         Address offset: 0x14 */
+	uint32_t SCR;           /*!< PWR power status reset register,     Address offset: 0x18 */
+	uint32_t RESERVED[25];  /*!< Reserved,                            Address offset: 0x1C - 0x7C */
+	uint32_t CR5;           /*!< PWR power control register 5,        Address offset: 0x80 */
+} PWR_TypeDef;
+
+extern PWR_TypeDef *PWR;
+
+
+/**
+  * @brief FLASH Registers
+  */
+
+typedef struct {
+	uint32_t ACR;           /*!< FLASH access control register,       Address offset: 0x00 */
+	uint32_t PDKEYR;        /*!< FLASH power down key register,       Address offset: 0x04 */
+	uint32_t KEYR;          /*!< FLASH key register,                  Address offset: 0x08 */
+	uint32_t OPTKEYR;       /*!< FLASH option key register,           Address offset: 0x0C */
+	uint32_t SR;            /*!< FLASH status register,               Address offset: 0x10 */
+	uint32_t CR;            /*!< FLASH control register,              Address offset: 0x14 */
+} FLASH_TypeDef;
+
+extern FLASH_TypeDef *FLASH;
+
+
+/**
+  * @brief External Interrupt/Event Controller
+  */
+
+typedef struct {
+	uint32_t IMR1;          /*!< EXTI Interrupt mask register 1,             Address offset: 0x00 */
+	uint32_t EMR1;          /*!< EXTI Event mask register 1,                 Address offset: 0x04 */
+	uint32_t RTSR1;         /*!< EXTI Rising trigger selection register 1,   Address offset: 0x08 */
+	uint32_t FTSR1;         /*!< EXTI Falling trigger selection register 1,  Address offset: 0x0C */
+	uint32_t SWIER1;        /*!< EXTI Software interrupt event register 1,   Address offset: 0x10 */
+	uint32_t PR1;           /*!< EXTI Pending register 1,                    Address offset: 0x14 */
+} EXTI_TypeDef;
+
+extern EXTI_TypeDef *EXTI;
+
+
+/**
+  * @brief LPTIMER
+  */
+
+typedef struct {
+	uint32_t ISR;           /*!< LPTIM Interrupt and Status register, Address offset: 0x00 */
+	uint32_t ICR;           /*!< LPTIM Interrupt Clear register,      Address offset: 0x04 */
+	uint32_t IER;           /*!< LPTIM Interrupt Enable register,     Address offset: 0x08 */
+	uint32_t CFGR;          /*!< LPTIM Configuration register,        Address offset: 0x0C */
+	uint32_t CR;            /*!< LPTIM Control register,              Address offset: 0x10 */
+	uint32_t CMP;           /*!< LPTIM Compare register,              Address offset: 0x14 */
+	uint32_t ARR;           /*!< LPTIM Autoreload register,           Address offset: 0x18 */
+	uint32_t CNT;           /*!< LPTIM Counter register,              Address offset: 0x1C */
+	uint32_t OR;            /*!< LPTIM Option register,               Address offset: 0x20 */
+} LPTIM_TypeDef;
+
+extern LPTIM_TypeDef *LPTIM1;
+
+void update_LPTIM_status();
+bool advance_LPTIM(LPTIM_TypeDef *lptim, uint32_t ticks);
+
+
+/**
+  * @brief TIM
+  */
+
+typedef struct {
+	uint32_t CR1;           /*!< TIM control register 1,                   Address offset: 0x00  */
+	uint32_t CR2;           /*!< TIM control register 2,                   Address offset: 0x04  */
+	uint32_t SMCR;          /*!< TIM slave mode control register,          Address offset: 0x08  */
+	uint32_t DIER;          /*!< TIM DMA/interrupt enable register,        Address offset: 0x0C  */
+	uint32_t SR;            /*!< TIM status register,                      Address offset: 0x10  */
+	uint32_t EGR;           /*!< TIM event generation register,            Address offset: 0x14  */
+	uint32_t CCMR1;         /*!< TIM capture/compare mode register 1,      Address offset: 0x18  */
+	uint32_t CCMR2;         /*!< TIM capture/compare mode register 2,      Address offset: 0x1C  */
+	uint32_t CCER;          /*!< TIM capture/compare enable register,      Address offset: 0x20  */
+	uint32_t CNT;           /*!< TIM counter register,                     Address offset: 0x24  */
+	uint32_t PSC;           /*!< TIM prescaler,                            Address offset: 0x28  */
+	uint32_t ARR;           /*!< TIM auto-reload register,                 Address offset: 0x2C  */
+	uint32_t RCR;           /*!< TIM repetition counter register,          Address offset: 0x30  */
+	uint32_t CCR1;          /*!< TIM capture/compare register 1,           Address offset: 0x34  */
+	uint32_t CCR2;          /*!< TIM capture/compare register 2,           Address offset: 0x38  */
+	uint32_t CCR3;          /*!< TIM capture/compare register 3,           Address offset: 0x3C  */
+	uint32_t CCR4;          /*!< TIM capture/compare register 4,           Address offset: 0x40  */
+	uint32_t BDTR;          /*!< TIM break and dead-time register,         Address offset: 0x44  */
+	uint32_t CCR5;          /*!< TIM capture/compare register 5,           Address offset: 0x48  */
+	uint32_t CCR6;          /*!< TIM capture/compare register 6,           Address offset: 0x4C  */
+	uint32_t CCMR3;         /*!< TIM capture/compare mode register 3,      Address offset: 0x50  */
+	uint32_t DTR2;          /*!< TIM deadtime register 2,                  Address offset: 0x54  */
+	uint32_t ECR;           /*!< TIM encoder control register,             Address offset: 0x58  */
+	uint32_t TISEL;         /*!< TIM Input Selection register,             Address offset: 0x5C  */
+	uint32_t AF1;           /*!< TIM alternate function option register 1, Address offset: 0x60  */
+	uint32_t AF2;           /*!< TIM alternate function option register 2, Address offset: 0x64  */
+	uint32_t OR;            /*!< TIM option register,                      Address offset: 0x68  */
+	uint32_t RESERVED0[220];/*!< Reserved,                                 Address offset: 0x6C  */
+	uint32_t DCR;           /*!< TIM DMA control register,                 Address offset: 0x3DC */
+	uint32_t DMAR;          /*!< TIM DMA address for full transfer,        Address offset: 0x3E0 */
+} TIM_TypeDef;
+
+extern TIM_TypeDef *TIM1;
+extern TIM_TypeDef *TIM2;
+extern TIM_TypeDef *TIM3;
+extern TIM_TypeDef *TIM4;
+extern TIM_TypeDef *TIM6;
+extern TIM_TypeDef *TIM7;
+extern TIM_TypeDef *TIM8;
+extern TIM_TypeDef *TIM15;
+extern TIM_TypeDef *TIM16;
+extern TIM_TypeDef *TIM17;
+extern TIM_TypeDef *TIM20;
+
+void trigger_TIM_burst(TIM_TypeDef *timer, uint16_t request);
+void feed_TIM_capture(TIM_TypeDef *timer, uint32_t channel, const uint32_t *counts, uint32_t length, uint16_t request);
+
+
+/**
+  * @brief DMA Controller
+  */
+
+typedef struct {
+	uint32_t CCR;           /*!< DMA channel x configuration register        */
+	uint32_t CNDTR;         /*!< DMA channel x number of data register       */
+	uintptr_t CPAR;         /*!< DMA channel x peripheral address register, widened to hold host pointers */
+	uintptr_t CMAR;         /*!< DMA channel x memory address register, widened to hold host pointers     */
+} DMA_Channel_TypeDef;
+
+typedef struct {
+	uint32_t ISR;           /*!< DMA interrupt status register,                 Address offset: 0x00 */
+	uint32_t IFCR;          /*!< DMA interrupt flag clear register,             Address offset: 0x04 */
+} DMA_TypeDef;
+
+extern DMA_TypeDef *DMA1;
+extern DMA_TypeDef *DMA2;
+extern DMA_Channel_TypeDef *DMA1_Channel1;
+extern DMA_Channel_TypeDef *DMA1_Channel2;
+extern DMA_Channel_TypeDef *DMA1_Channel3;
+extern DMA_Channel_TypeDef *DMA1_Channel4;
+extern DMA_Channel_TypeDef *DMA1_Channel5;
+extern DMA_Channel_TypeDef *DMA1_Channel6;
+extern DMA_Channel_TypeDef *DMA1_Channel7;
+extern DMA_Channel_TypeDef *DMA1_Channel8;
+extern DMA_Channel_TypeDef *DMA2_Channel1;
+extern DMA_Channel_TypeDef *DMA2_Channel2;
+extern DMA_Channel_TypeDef *DMA2_Channel3;
+extern DMA_Channel_TypeDef *DMA2_Channel4;
+extern DMA_Channel_TypeDef *DMA2_Channel5;
+extern DMA_Channel_TypeDef *DMA2_Channel6;
+extern DMA_Channel_TypeDef *DMA2_Channel7;
+extern DMA_Channel_TypeDef *DMA2_Channel8;
+
+void trigger_DMA_request(uint16_t request);
+bool run_DMA_mem2mem();
+
+// Done callbacks of the DMA jobs, e.g. Copy & Chain, counted with the last job's result
+typedef struct {
+	uint32_t count;
+	bool completed;
+} Mock_DMA_Done_t;
+
+void record_DMA_done(bool completed, void *context);
+
+
+/**
+  * @brief DMA Multiplexer
+  */
+
+typedef struct {
+	uint32_t CCR;           /*!< DMA Multiplexer Channel x Control Register    Address offset: 0x0004 * (channel x) */
+} DMAMUX_Channel_TypeDef;
+
+extern DMAMUX_Channel_TypeDef *DMAMUX1;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel0;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel1;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel2;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel3;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel4;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel5;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel6;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel7;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel8;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel9;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel10;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel11;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel12;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel13;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel14;
+extern DMAMUX_Channel_TypeDef *DMAMUX1_Channel15;
+
+typedef struct {
+	uint32_t CSR;           /*!< DMA Channel Status Register                    Address offset: 0x0080   */
+	uint32_t CFR;           /*!< DMA Channel Clear Flag Register                Address offset: 0x0084   */
+} DMAMUX_ChannelStatus_TypeDef;
+
+typedef struct {
+	uint32_t RGCR;          /*!< DMA Request Generator x Control Register     Address offset: 0x0100 + 0x0004 * (Req Gen x) */
+} DMAMUX_RequestGen_TypeDef;
+
+typedef struct {
+	uint32_t RGSR;          /*!< DMA Request Generator Status Register        Address offset: 0x0140   */
+	uint32_t RGCFR;         /*!< DMA Request Generator Clear Flag Register    Address offset: 0x0144   */
+} DMAMUX_RequestGenStatus_TypeDef;
+
+extern DMAMUX_RequestGen_TypeDef *DMAMUX1_RequestGenerator0;
+extern DMAMUX_RequestGen_TypeDef *DMAMUX1_RequestGenerator1;
+extern DMAMUX_RequestGen_TypeDef *DMAMUX1_RequestGenerator2;
+extern DMAMUX_RequestGen_TypeDef *DMAMUX1_RequestGenerator3;
+extern DMAMUX_ChannelStatus_TypeDef *DMAMUX1_ChannelStatus;
+extern DMAMUX_RequestGenStatus_TypeDef *DMAMUX1_RequestGenStatus;
+
+void trigger_DMAMUX_signal(uint16_t signal, bool rising);
+void update_DMAMUX_status();
+
+
+/**
+  * @brief Universal Synchronous Asynchronous Receiver Transmitter
+  */
+
+typedef struct {
+	uint32_t CR1;           /*!< USART Control register 1,                 Address offset: 0x00  */
+	uint32_t CR2;           /*!< USART Control register 2,                 Address offset: 0x04  */
+	uint32_t CR3;           /*!< USART Control register 3,                 Address offset: 0x08  */
+	uint32_t BRR;           /*!< USART Baud rate register,                 Address offset: 0x0C  */
+	uint32_t GTPR;          /*!< USART Guard time and prescaler register,  Address offset: 0x10  */
+	uint32_t RTOR;          /*!< USART Receiver Timeout register,          Address offset: 0x14  */
+	uint32_t RQR;           /*!< USART Request register,                   Address offset: 0x18  */
+	uint32_t ISR;           /*!< USART Interrupt and status register,      Address offset: 0x1C  */
+	uint32_t ICR;           /*!< USART Interrupt flag Clear register,      Address offset: 0x20  */
+	uint32_t RDR;           /*!< USART Receive Data register,              Address offset: 0x24  */
+	uint32_t TDR;           /*!< USART Transmit Data register,             Address offset: 0x28  */
+	uint32_t PRESC;         /*!< USART Prescaler register,                 Address offset: 0x2C  */
+} USART_TypeDef;
+
+extern USART_TypeDef *USART1;
+extern USART_TypeDef *USART2;
+extern USART_TypeDef *USART3;
+extern USART_TypeDef *UART4;
+extern USART_TypeDef *UART5;
+extern USART_TypeDef *LPUART1;
+
+void update_USART_status(USART_TypeDef *usart);
+void feed_USART(USART_TypeDef *usart, const uint8_t *data, uint32_t length, uint16_t request);
+void idle_USART(USART_TypeDef *usart);
+uint32_t drain_USART(USART_TypeDef *usart, uint8_t *data, uint32_t max_length, uint16_t request);
+uint8_t read_USART_RDR(USART_TypeDef *usart);
+void write_USART_TDR(USART_TypeDef *usart, uint8_t value);
+
 
 #endif //STM32G4_MODULE_LIBRARY_MOCK_HH
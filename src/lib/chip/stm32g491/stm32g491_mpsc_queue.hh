@@ -0,0 +1,201 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_mpsc_queue.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_MPSC_QUEUE_HH
+#define STM32G4_MODULE_LIBRARY_MPSC_QUEUE_HH
+
+#include <cstdint>
+#include <type_traits>
+
+
+
+// Events from any number of interrupts to one consumer, e.g. the main loop, with no critical sections.
+// Each priority has its own queue of N slots, 0 being the most urgent like the NVIC's, & pop() always takes from
+// the most urgent one with anything in it.
+// A producer claims a slot by moving the queue's head with a compare & exchange, then writes the event & publishes it
+// through the slot's sequence number. An interrupt that posts in between makes the claim fail & retry, so a producer
+// never waits on another & events from the same one stay in order. The consumer stops at a claimed slot that isn't
+// published yet rather than pass it.
+// A full queue drops the event & counts it, & the most events each queue has held is kept, so N can be sized
+// from a run under load.
+namespace Chip {
+	template<typename T, uint32_t N, uint_fast8_t LEVELS = 1>
+	class MPSCQueue {
+		static_assert(N >= 2 && (N & (N - 1)) == 0, "The queue capacity must be a power of 2");
+		static_assert(N <= (1u << 30), "The queue capacity must leave the sequence numbers room to wrap");
+		static_assert(LEVELS >= 1, "The queue needs a priority level");
+		static_assert(std::is_trivially_copyable<T>::value, "Events are copied as memory");
+
+	public:
+		static constexpr uint32_t CAPACITY = N;
+		static constexpr uint_fast8_t NUM_LEVELS = LEVELS;
+
+		typedef void (*Handler_t)(const T &event, uint_fast8_t priority, void *context);
+
+		MPSCQueue()
+		{
+			for (Lane_t &lane : lanes) {
+				for (uint32_t i = 0; i < N; i++) {
+					store_release(lane.slots[i].sequence, i);
+				}
+			}
+		}
+
+		// From any context. Returns false when the priority's queue is full & the event was dropped
+		bool push(const T &event, const uint_fast8_t priority = 0)
+		{
+			Lane_t &lane = lane_of(priority);
+			uint32_t position = load_acquire(lane.head);
+			Slot_t *slot;
+			while (true) {
+				slot = &lane.slots[position & MASK];
+				const int32_t LAG = static_cast<int32_t>(load_acquire(slot->sequence) - position);
+				if (LAG == 0) {
+					if (compare_exchange(lane.head, position, position + 1)) {
+						break;
+					}
+				} else if (LAG < 0) {
+					// The slot still holds the event from N pushes ago
+					fetch_add(lane.dropped, 1);
+					return false;
+				}
+				position = load_acquire(lane.head);
+			}
+
+			slot->event = event;
+			store_release(slot->sequence, position + 1);
+			// The tail first, it can only be behind a head read after it
+			const uint32_t TAIL = load_acquire(lane.tail);
+			raise(lane.high_water, load_acquire(lane.head) - TAIL);
+			return true;
+		}
+
+		// From the consumer only. Takes the oldest event of the most urgent priority that has one
+		bool pop(T &event, uint_fast8_t *const priority = nullptr)
+		{
+			for (uint_fast8_t level = 0; level < LEVELS; level++) {
+				Lane_t &lane = lanes[level];
+				const uint32_t POSITION = load_acquire(lane.tail);
+				Slot_t &slot = lane.slots[POSITION & MASK];
+				if (load_acquire(slot.sequence) != POSITION + 1) {
+					continue;
+				}
+				event = slot.event;
+				store_release(slot.sequence, POSITION + N);
+				store_release(lane.tail, POSITION + 1);
+				if (priority != nullptr) {
+					*priority = level;
+				}
+				return true;
+			}
+			return false;
+		}
+
+		// Hands every event to the handler in priority order, an urgent one posted meanwhile is next.
+		// Returns the number handled, at most max_events so a flood can't hold the consumer
+		uint32_t drain(const Handler_t handler, void *const context, const uint32_t max_events = UINT32_MAX)
+		{
+			uint32_t handled = 0;
+			T event;
+			uint_fast8_t priority;
+			while (handled < max_events && pop(event, &priority)) {
+				handler(event, priority, context);
+				handled++;
+			}
+			return handled;
+		}
+
+		// Either side, a snapshot the producers may already have changed. Out of range priorities are the last, as in push()
+		uint32_t size(const uint_fast8_t priority) const
+		{
+			const Lane_t &lane = lane_of(priority);
+			return load_acquire(lane.head) - load_acquire(lane.tail);
+		}
+
+		bool empty() const
+		{
+			for (uint_fast8_t level = 0; level < LEVELS; level++) {
+				if (size(level) != 0) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		uint32_t high_water(const uint_fast8_t priority) const { return load_acquire(lane_of(priority).high_water); }
+		uint32_t dropped(const uint_fast8_t priority) const { return load_acquire(lane_of(priority).dropped); }
+
+		void clear_statistics()
+		{
+			for (Lane_t &lane : lanes) {
+				store_release(lane.high_water, 0);
+				store_release(lane.dropped, 0);
+			}
+		}
+
+	private:
+		static constexpr uint32_t MASK = N - 1;
+
+		typedef uint32_t Word_t;
+
+		// The compiler's atomics, LDREX/STREX & a DMB each side on the M4, so the event stays on the right side of
+		// its sequence number & an interrupt between the load & the store makes the claim fail & retry
+		static uint32_t load_acquire(const Word_t &word) { return __atomic_load_n(&word, __ATOMIC_ACQUIRE); }
+		static void store_release(Word_t &word, const uint32_t value)
+		{
+			__atomic_store_n(&word, value, __ATOMIC_RELEASE);
+		}
+		static bool compare_exchange(Word_t &word, uint32_t expected, const uint32_t desired)
+		{
+			return __atomic_compare_exchange_n(&word, &expected, desired, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+		}
+
+		static void fetch_add(Word_t &word, const uint32_t amount)
+		{
+			uint32_t value = load_acquire(word);
+			while (!compare_exchange(word, value, value + amount)) {
+				value = load_acquire(word);
+			}
+		}
+
+		static void raise(Word_t &word, const uint32_t value)
+		{
+			uint32_t current = load_acquire(word);
+			while (value > current && !compare_exchange(word, current, value)) {
+				current = load_acquire(word);
+			}
+		}
+
+		typedef struct {
+			Word_t sequence;            // Position + 1 once published, position + N once the consumer is done with it
+			T event;
+		} Slot_t;
+
+		typedef struct {
+			Slot_t slots[N];
+			Word_t head;                // Claimed by producers
+			Word_t tail;                // Taken by the consumer
+			Word_t high_water;
+			Word_t dropped;
+		} Lane_t;
+
+		Lane_t lanes[LEVELS] = {};
+
+		Lane_t &lane_of(const uint_fast8_t priority) { return lanes[(priority < LEVELS) ? priority : LEVELS - 1]; }
+		const Lane_t &lane_of(const uint_fast8_t priority) const
+		{
+			return lanes[(priority < LEVELS) ? priority : LEVELS - 1];
+		}
+	};
+}
+
+
+#endif //STM32G4_MODULE_LIBRARY_MPSC_QUEUE_HH
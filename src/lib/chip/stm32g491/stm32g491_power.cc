@@ -0,0 +1,293 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_power.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "stm32g491_chip.hh"
+
+
+
+namespace {
+	using Chip::Power::Level;
+	using Chip::Clock::Source;
+
+	// Doc: RM0440-6.4.1, 6.4.6 & 6.4.22
+	constexpr uint32_t LPR = 1 << 14;
+	constexpr uint32_t VOS_SHIFT = 9;
+	constexpr uint32_t REGLPF = 1 << 9;
+	constexpr uint32_t VOSF = 1 << 10;
+	constexpr uint32_t R1MODE = 1 << 8;
+	constexpr uint32_t VOS_RANGE_1 = 0b01;
+	constexpr uint32_t VOS_RANGE_2 = 0b10;
+
+	// Doc: RM0440-7.4.1 & 7.4.3
+	constexpr uint32_t HSION = 1 << 8;
+	constexpr uint32_t HSIRDY = 1 << 10;
+	constexpr uint32_t HSEON = 1 << 16;
+	constexpr uint32_t HSERDY = 1 << 17;
+	constexpr uint32_t PLLON = 1 << 24;
+	constexpr uint32_t PLLRDY = 1 << 25;
+	constexpr uint32_t SWS_SHIFT = 2;
+
+	// A PLL locks in well under a millisecond, polls that run past this are a hardware fault
+	constexpr uint32_t TIMEOUT_POLLS = 100000;
+	constexpr uint32_t BOOST_STEP_FREQUENCY = 80000000;
+
+	Chip::Power::Switch_Stats_t stats = {};
+
+
+	bool wait_for(volatile const uint32_t *const reg, const uint32_t mask, const uint32_t value)
+	{
+		for (uint32_t poll = 0; poll < TIMEOUT_POLLS; poll++) {
+			if ((Chip::HAL::read_register(reg) & mask) == value) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+
+	void wait_cycles(const uint32_t cycles)
+	{
+		const uint32_t START = Chip::HAL::read_cycle_counter();
+		while (Chip::HAL::read_cycle_counter() - START < cycles) {}
+	}
+
+
+	// Doc: RM0440-7.4.3 | Prescaler fields from divider values, the inverse of Chip::Clock::tree()
+	constexpr uint32_t ahb_prescaler(const uint16_t divider)
+	{
+		const uint16_t AHB_DIVIDERS[] = {2, 4, 8, 16, 64, 128, 256, 512};
+		for (uint32_t i = 0; i < 8; i++) {
+			if (AHB_DIVIDERS[i] == divider) {
+				return 0b1000 | i;
+			}
+		}
+		return 0;
+	}
+
+	constexpr uint32_t apb_prescaler(const uint8_t divider)
+	{
+		for (uint32_t i = 0; i < 4; i++) {
+			if ((2u << i) == divider) {
+				return 0b100 | i;
+			}
+		}
+		return 0;
+	}
+
+	// Only the source & prescalers are written, the MCO settings in the same register are kept
+	void set_clock_config(const Chip::Clock::Tree_t &tree, const Source source, const uint16_t ahb_divider)
+	{
+		const uint32_t MASK = 0b11 | (0b1111 << 4) | (0b111 << 8) | (0b111 << 11);
+		const uint32_t CONFIG = static_cast<uint32_t>(source) | (ahb_prescaler(ahb_divider) << 4)
+		                        | (apb_prescaler(tree.apb1_divider) << 8) | (apb_prescaler(tree.apb2_divider) << 11);
+		Chip::HAL::write_register(&RCC->CFGR, (Chip::HAL::read_register(&RCC->CFGR) & ~MASK) | CONFIG);
+	}
+
+
+	bool set_flash_latency(const uint8_t latency)
+	{
+		// Doc: RM0440-5.3.3 & 5.7.1 | The new latency is in effect once it reads back from ACR
+		volatile uint32_t *const REGISTER = &FLASH->ACR;
+		const uint32_t LATENCY_MASK = 0b1111;
+		Chip::HAL::write_register(REGISTER, (Chip::HAL::read_register(REGISTER) & ~LATENCY_MASK) | latency);
+		return wait_for(REGISTER, LATENCY_MASK, latency);
+	}
+
+
+	uint8_t flash_latency()
+	{
+		return static_cast<uint8_t>(Chip::HAL::read_register(&FLASH->ACR) & 0b1111);
+	}
+
+
+	void set_voltage_range(const uint32_t range)
+	{
+		volatile uint32_t *const REGISTER = &PWR->CR1;
+		Chip::HAL::write_register(REGISTER, (Chip::HAL::read_register(REGISTER) & ~(0b11u << VOS_SHIFT))
+		                                    | (range << VOS_SHIFT));
+	}
+
+
+	// Everything that raises the frequency limit, done before the clock speeds up
+	bool raise_limits(const Level level, const uint8_t latency)
+	{
+		if (latency > flash_latency() && !set_flash_latency(latency)) {
+			return false;
+		}
+
+		// Doc: RM0440-6.3.4 | The main regulator is back before anything runs faster than 2 MHz
+		if (level != Level::LOW_POWER_RUN) {
+			Chip::HAL::clear_register(&PWR->CR1, LPR);
+			if (!wait_for(&PWR->SR2, REGLPF, 0)) {
+				return false;
+			}
+		}
+
+		// Doc: RM0440-6.1.5 | Range 1 has to be reached before boost mode is selected
+		if (level == Level::RANGE_1_BOOST || level == Level::RANGE_1) {
+			set_voltage_range(VOS_RANGE_1);
+			if (!wait_for(&PWR->SR2, VOSF, 0)) {
+				return false;
+			}
+		}
+		if (level == Level::RANGE_1_BOOST) {
+			Chip::HAL::clear_register(&PWR->CR5, R1MODE);
+		}
+		return true;
+	}
+
+
+	// Everything that lowers the frequency limit, done once the clock has slowed down
+	bool lower_limits(const Level level, const uint8_t latency)
+	{
+		if (level == Level::RANGE_1) {
+			Chip::HAL::set_register(&PWR->CR5, R1MODE);
+		}
+		if (level == Level::RANGE_2 || level == Level::LOW_POWER_RUN) {
+			set_voltage_range(VOS_RANGE_2);
+			if (!wait_for(&PWR->SR2, VOSF, 0)) {
+				return false;
+			}
+		}
+		if (level == Level::LOW_POWER_RUN) {
+			Chip::HAL::set_register(&PWR->CR1, LPR);
+			if (!wait_for(&PWR->SR2, REGLPF, REGLPF)) {
+				return false;
+			}
+		}
+		if (latency < flash_latency() && !set_flash_latency(latency)) {
+			return false;
+		}
+		return true;
+	}
+
+
+	bool switch_clock(const Chip::Clock::Tree_t &tree, const bool boost)
+	{
+		const uint32_t SWS_MASK = 0b11 << SWS_SHIFT;
+
+		// HSI16 runs the core while the PLL is reprogrammed, the PLL can't be changed while it is in use
+		Chip::HAL::set_register(&RCC->CR, HSION);
+		if (!wait_for(&RCC->CR, HSIRDY, HSIRDY)) {
+			return false;
+		}
+		volatile uint32_t *const REGISTER = &RCC->CFGR;
+		Chip::HAL::write_register(REGISTER, (Chip::HAL::read_register(REGISTER) & ~0b11u)
+		                                    | static_cast<uint32_t>(Source::HSI16));
+		if (!wait_for(REGISTER, SWS_MASK, static_cast<uint32_t>(Source::HSI16) << SWS_SHIFT)) {
+			return false;
+		}
+		Chip::HAL::clear_register(&RCC->CR, PLLON);
+		if (!wait_for(&RCC->CR, PLLRDY, 0)) {
+			return false;
+		}
+
+		// Doc: RM0440-7.2.1 | HSE is off after reset & after Stop mode
+		if (tree.source == Source::HSE || (tree.source == Source::PLL && tree.pll_source == Source::HSE)) {
+			Chip::HAL::set_register(&RCC->CR, HSEON);
+			if (!wait_for(&RCC->CR, HSERDY, HSERDY)) {
+				return false;
+			}
+		}
+
+		if (tree.source != Source::PLL) {
+			set_clock_config(tree, tree.source, tree.ahb_divider);
+			return wait_for(&RCC->CFGR, SWS_MASK, static_cast<uint32_t>(tree.source) << SWS_SHIFT);
+		}
+
+		// Doc: RM0440-7.4.4 | PLLR output enabled
+		const uint32_t PLL_SOURCE = (tree.pll_source == Source::HSE) ? 0b11 : 0b10;
+		Chip::HAL::write_register(&RCC->PLLCFGR, PLL_SOURCE | (static_cast<uint32_t>(tree.pll_m - 1) << 4)
+		                                         | (static_cast<uint32_t>(tree.pll_n) << 8) | (1 << 24)
+		                                         | (static_cast<uint32_t>(tree.pll_r / 2 - 1) << 25));
+		Chip::HAL::set_register(&RCC->CR, PLLON);
+		if (!wait_for(&RCC->CR, PLLRDY, PLLRDY)) {
+			return false;
+		}
+
+		// Doc: RM0440-6.1.5 | Jumping past 80 MHz in boost mode goes through AHB / 2 for at least 1 us
+		const uint32_t HCLK = Chip::Clock::frequency(tree, Chip::Clock::Domain::HCLK);
+		const bool STEP = boost && HCLK > BOOST_STEP_FREQUENCY;
+		set_clock_config(tree, Source::PLL, static_cast<uint16_t>(tree.ahb_divider * (STEP ? 2 : 1)));
+		if (!wait_for(&RCC->CFGR, SWS_MASK, static_cast<uint32_t>(Source::PLL) << SWS_SHIFT)) {
+			return false;
+		}
+		if (STEP) {
+			wait_cycles(HCLK / 2 / 1000000);
+			set_clock_config(tree, Source::PLL, tree.ahb_divider);
+		}
+		return true;
+	}
+}
+
+
+
+/*
+ * Performance level functions
+ */
+// Returns false if the RCC or PWR stopped responding part way, the clock registry still follows whatever tree
+// the chip ended up running
+bool Chip::Power::set_performance_level(const Level level)
+{
+	const uint32_t START = Chip::HAL::read_cycle_counter();
+	Chip::Clock::acquire(Chip::Clock::Gate::PWREN);
+
+	const Chip::Clock::Tree_t TREE = tree(level, Chip::HAL::read_register(&RCC->CCIPR));
+	const uint8_t LATENCY = flash_latency(level, Chip::Clock::frequency(TREE, Chip::Clock::Domain::HCLK));
+	const bool SWITCHED = raise_limits(level, LATENCY) && switch_clock(TREE, level == Level::RANGE_1_BOOST)
+	                      && lower_limits(level, LATENCY);
+
+	Chip::Clock::release(Chip::Clock::Gate::PWREN);
+	const uint32_t CYCLES = Chip::HAL::read_cycle_counter() - START;
+	stats.last_cycles = CYCLES;
+	stats.max_cycles = (CYCLES > stats.max_cycles) ? CYCLES : stats.max_cycles;
+	stats.switches++;
+
+	// Listeners re-derive their dividers outside the timed part of the switch
+	Chip::Clock::update();
+	return SWITCHED;
+}
+
+
+// Decoded from the regulator, so it is right even before the first switch
+Chip::Power::Level Chip::Power::performance_level()
+{
+	Chip::Clock::acquire(Chip::Clock::Gate::PWREN);
+	const uint32_t CR1 = Chip::HAL::read_register(&PWR->CR1);
+	const uint32_t CR5 = Chip::HAL::read_register(&PWR->CR5);
+	Chip::Clock::release(Chip::Clock::Gate::PWREN);
+
+	if (CR1 & LPR) {
+		return Level::LOW_POWER_RUN;
+	}
+	if (((CR1 >> VOS_SHIFT) & 0b11) == VOS_RANGE_2) {
+		return Level::RANGE_2;
+	}
+	return (CR5 & R1MODE) ? Level::RANGE_1 : Level::RANGE_1_BOOST;
+}
+
+
+Chip::Power::Switch_Stats_t Chip::Power::switch_stats()
+{
+	return stats;
+}
+
+
+
+// Stop mode wakes the chip on HSI16 with HSE & the PLL off, the regulator & wait states are kept.
+// Restarts whatever tree was running before, nothing has changed as far as the clock registry is concerned.
+bool Chip::Power::restore_clock(const Clock::Tree_t &tree)
+{
+	if (tree.source == Clock::Source::HSI16) {
+		return true;
+	}
+	return switch_clock(tree, performance_level() == Level::RANGE_1_BOOST);
+}
@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_power.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_POWER_HH
+#define STM32G4_MODULE_LIBRARY_POWER_HH
+
+#include <cstdint>
+#include "stm32g491_clock.hh"
+
+
+
+// Performance levels. Each one pairs a regulator range with the fastest clock tree it allows, switching levels
+// sequences the regulator, flash wait states & PLL, then updates the clock registry so drivers re-derive their
+// dividers from the new frequencies.
+namespace Chip {
+	namespace Power {
+		enum class Level : uint8_t {
+			// Doc: RM0440-6.1.5 & 6.3.4
+			RANGE_1_BOOST = 0,      // 170 MHz from the PLL
+			RANGE_1 = 1,            // 150 MHz from the PLL
+			RANGE_2 = 2,            // 16 MHz from HSI16, the PLL is off
+			LOW_POWER_RUN = 3       // 2 MHz, HSI16 divided by 8 on the low-power regulator
+		};
+
+		constexpr uint_fast8_t NUM_LEVELS = 4;
+
+		typedef struct {
+			uint32_t last_cycles;       // Core cycles the last switch took, counted at whatever speed the core ran
+			uint32_t max_cycles;
+			uint32_t switches;
+		} Switch_Stats_t;
+
+
+		// Every level runs from HSI16, so none of them depend on the board's crystal.
+		// Kernel clock selections aren't part of a level, they are kept as they are.
+		constexpr Clock::Tree_t tree(const Level level, const uint32_t kernel_select = 0)
+		{
+			// Doc: RM0440-7.4.4 | HSI16 / 4 feeds the VCO 4 MHz, N & R take it to the system clock
+			Clock::Tree_t tree = {
+				.source=Clock::Source::PLL, .pll_source=Clock::Source::HSI16, .hse=HSE_VALUE, .pll_m=4, .pll_n=85,
+				.pll_r=2, .ahb_divider=1, .apb1_divider=1, .apb2_divider=1, .kernel_select=kernel_select
+			};
+			if (level == Level::RANGE_1) {
+				tree.pll_n = 75;
+			} else if (level == Level::RANGE_2) {
+				tree.source = Clock::Source::HSI16;
+			} else if (level == Level::LOW_POWER_RUN) {
+				tree.source = Clock::Source::HSI16;
+				tree.ahb_divider = 8;
+			}
+			return tree;
+		}
+
+		// Doc: RM0440-5.3.3 | Wait states needed to read flash at an HCLK, each one covers a fixed slice of frequency
+		constexpr uint8_t flash_latency(const Level level, const uint32_t hclk)
+		{
+			uint32_t hz_per_state = 12000000;
+			if (level == Level::RANGE_1_BOOST) {
+				hz_per_state = 34000000;
+			} else if (level == Level::RANGE_1) {
+				hz_per_state = 30000000;
+			}
+			return static_cast<uint8_t>((hclk == 0) ? 0 : (hclk - 1) / hz_per_state);
+		}
+
+		bool set_performance_level(Level level);
+		Level performance_level();
+		Switch_Stats_t switch_stats();
+
+		bool restore_clock(const Clock::Tree_t &tree);
+	}
+}
+
+
+#endif //STM32G4_MODULE_LIBRARY_POWER_HH
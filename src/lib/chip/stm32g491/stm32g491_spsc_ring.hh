@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+// File Name    : stm32g491_spsc_ring.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_SPSC_RING_HH
+#define STM32G4_MODULE_LIBRARY_SPSC_RING_HH
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+
+
+// A queue between one producer & one consumer, e.g. an interrupt & the main loop, with no critical sections.
+// Only the producer moves the head & only the consumer moves the tail, each publishing its index after the elements
+// it covers & reading the other's before touching them with the compiler's acquire & release atomics, the same code
+// on the chip & in the unit tests where the two sides are threads.
+// The spans are the ring's storage in place, so a DMA can fill or empty it directly & commit() or consume() the
+// count it moved afterwards. A span stops at the end of the storage, the rest comes as the next one.
+namespace Chip {
+	template<typename T, uint32_t N>
+	class SPSCRing {
+		static_assert(N >= 2 && (N & (N - 1)) == 0, "The ring capacity must be a power of 2");
+		static_assert(N <= (1u << 31), "The ring capacity must leave the indices room to wrap");
+		static_assert(std::is_trivially_copyable<T>::value, "Ring elements are copied as memory");
+
+	public:
+		static constexpr uint32_t CAPACITY = N;
+
+		template<typename U>
+		struct Span_t {
+			U *data;
+			uint32_t length;
+		};
+
+		/*
+		 * Producer side
+		 */
+		bool push(const T &value)
+		{
+			const uint32_t HEAD = load(head);
+			if (HEAD - load_acquire(tail) == N) {
+				return false;
+			}
+			buffer[HEAD & MASK] = value;
+			store_release(head, HEAD + 1);
+			return true;
+		}
+
+		// Pushes as many as fit & returns how many that was
+		uint32_t push(const T *const values, const uint32_t count)
+		{
+			const uint32_t HEAD = load(head);
+			const uint32_t PUSHED = std::min(count, N - (HEAD - load_acquire(tail)));
+			const uint32_t START = HEAD & MASK;
+			const uint32_t FIRST = std::min(PUSHED, N - START);
+			std::copy_n(values, FIRST, &buffer[START]);
+			std::copy_n(values + FIRST, PUSHED - FIRST, &buffer[0]);
+			store_release(head, HEAD + PUSHED);
+			return PUSHED;
+		}
+
+		// The free space from the head up to the end of the storage, filled then commit()ed
+		Span_t<T> write_span()
+		{
+			const uint32_t HEAD = load(head);
+			const uint32_t START = HEAD & MASK;
+			return {&buffer[START], std::min(N - (HEAD - load_acquire(tail)), N - START)};
+		}
+
+		void commit(const uint32_t count)
+		{
+			store_release(head, load(head) + count);
+		}
+
+
+		/*
+		 * Consumer side
+		 */
+		bool pop(T &value)
+		{
+			const uint32_t TAIL = load(tail);
+			if (load_acquire(head) == TAIL) {
+				return false;
+			}
+			value = buffer[TAIL & MASK];
+			store_release(tail, TAIL + 1);
+			return true;
+		}
+
+		// Pops as many as there are up to count & returns how many that was
+		uint32_t pop(T *const values, const uint32_t count)
+		{
+			const uint32_t TAIL = load(tail);
+			const uint32_t POPPED = std::min(count, load_acquire(head) - TAIL);
+			const uint32_t START = TAIL & MASK;
+			const uint32_t FIRST = std::min(POPPED, N - START);
+			std::copy_n(&buffer[START], FIRST, values);
+			std::copy_n(&buffer[0], POPPED - FIRST, values + FIRST);
+			store_release(tail, TAIL + POPPED);
+			return POPPED;
+		}
+
+		// The elements from the tail up to the end of the storage, read then consume()d
+		Span_t<const T> read_span() const
+		{
+			const uint32_t TAIL = load(tail);
+			const uint32_t START = TAIL & MASK;
+			return {&buffer[START], std::min(load_acquire(head) - TAIL, N - START)};
+		}
+
+		void consume(const uint32_t count)
+		{
+			store_release(tail, load(tail) + count);
+		}
+
+
+		/*
+		 * Either side, a snapshot the other side may already have changed
+		 */
+		uint32_t size() const { return load_acquire(head) - load_acquire(tail); }
+		uint32_t space() const { return N - size(); }
+		bool empty() const { return size() == 0; }
+		bool full() const { return size() == N; }
+
+	private:
+		static constexpr uint32_t MASK = N - 1;
+
+		typedef uint32_t Index_t;
+
+		// Doc: PM0214-3.10.3 | A DMB each side on the M4, keeping the element accesses on their side of the index,
+		// for a DMA as well
+		static uint32_t load(const Index_t &index) { return __atomic_load_n(&index, __ATOMIC_RELAXED); }
+		static uint32_t load_acquire(const Index_t &index) { return __atomic_load_n(&index, __ATOMIC_ACQUIRE); }
+		static void store_release(Index_t &index, const uint32_t value)
+		{
+			__atomic_store_n(&index, value, __ATOMIC_RELEASE);
+		}
+
+		T buffer[N] = {};
+		Index_t head = 0;
+		Index_t tail = 0;
+	};
+}
+
+
+#endif //STM32G4_MODULE_LIBRARY_SPSC_RING_HH
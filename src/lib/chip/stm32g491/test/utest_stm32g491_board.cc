@@ -0,0 +1,193 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_stm32g491_board.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstring>
+#include "../stm32g491_chip.hh"
+
+
+
+namespace {
+	using GPIO = Chip::GPIO;
+	using Block = Chip::Board::Block;
+
+	constexpr Chip::Board::Pin_Config_t output_pin(const GPIO::PinId pin, const uint8_t level)
+	{
+		return {.pin=pin, .mode=GPIO::Pin_Mode::OUTPUT, .otype=GPIO::Pin_OType::PUSH_PULL,
+		        .ospeed=GPIO::Pin_OSpeed::HIGH_SPEED, .pupd=GPIO::Pin_PUPD::NO_PULL_UP_DOWN,
+		        .af=GPIO::Pin_AF::AF0, .level=level};
+	}
+
+	constexpr Chip::Board::Pin_Config_t alternate_pin(const GPIO::PinId pin, const GPIO::Pin_AF af)
+	{
+		return {.pin=pin, .mode=GPIO::Pin_Mode::ALTERNATE, .otype=GPIO::Pin_OType::OPEN_DRAIN,
+		        .ospeed=GPIO::Pin_OSpeed::VERY_HIGH_SPEED, .pupd=GPIO::Pin_PUPD::PULL_UP, .af=af, .level=0};
+	}
+
+	constexpr auto BOARD = Chip::Board::Builder<32>()
+		.pin(output_pin({GPIO::Port::E, 1}, 1))
+		.pin(output_pin({GPIO::Port::E, 2}, 0))
+		.pin(alternate_pin({GPIO::Port::E, 9}, GPIO::Pin_AF::AF2))
+		.pin(output_pin({GPIO::Port::F, 0}, 1))
+		.clock(Chip::Clock::Gate::TIM3EN)
+		.write(Block::TIMER_3, offsetof(TIM_TypeDef, PSC), 169)
+		.write(Block::TIMER_3, offsetof(TIM_TypeDef, ARR), 999)
+		.write(Block::TIMER_3, offsetof(TIM_TypeDef, CR1), 1 << 7, 1 << 7)
+		.write(Block::TIMER_3, offsetof(TIM_TypeDef, CR1), 1 << 3, 1 << 3);
+	constexpr auto IMAGE = BOARD.compile<BOARD.image_size()>();
+
+	// Two ports of 7 registers each: a 3 register run, ODR, a 2 register AFR run & MODER last. PSC & ARR form a run,
+	// both CR1 writes are merged into one masked entry.
+	static_assert(BOARD.image_size() == 2 * (4 + 2 + 3 + 2) + 3 + 3, "Writes to the same register are merged");
+	static_assert(IMAGE.clocks[static_cast<uint8_t>(Chip::Clock::Bus::AHB2)] == 0b110000, "Ports E & F are clocked");
+
+	void reset_registers()
+	{
+		std::memset(GPIOE, 0, sizeof(GPIO_TypeDef));
+		std::memset(GPIOF, 0, sizeof(GPIO_TypeDef));
+		TIM3->CR1 = 1 << 0;
+		TIM3->PSC = 0;
+		TIM3->ARR = 0;
+	}
+
+	void check_registers()
+	{
+		REQUIRE(GPIOE->MODER == 0xFFFBFFD7);
+		REQUIRE(GPIOE->OTYPER == (1 << 9));
+		REQUIRE(GPIOE->OSPEEDR == ((0b10 << 2) | (0b10 << 4) | (0b11 << 18)));
+		REQUIRE(GPIOE->PUPDR == (0b01 << 18));
+		REQUIRE(GPIOE->ODR == (1 << 1));
+		REQUIRE(GPIOE->AFR[0] == 0);
+		REQUIRE(GPIOE->AFR[1] == (2 << 4));
+		REQUIRE(GPIOF->MODER == 0xFFFFFFFD);
+		REQUIRE(GPIOF->ODR == 1);
+		REQUIRE(TIM3->PSC == 169);
+		REQUIRE(TIM3->ARR == 999);
+		REQUIRE(TIM3->CR1 == ((1 << 7) | (1 << 3) | (1 << 0)));
+		REQUIRE(Chip::Clock::is_running(Chip::Clock::Gate::GPIOEEN));
+		REQUIRE(Chip::Clock::is_running(Chip::Clock::Gate::GPIOFEN));
+		REQUIRE(Chip::Clock::is_running(Chip::Clock::Gate::TIM3EN));
+	}
+}
+
+
+TEST_CASE("Chip board images", "[Chip][Board]")
+{
+	SECTION("Board Image Encoding") {
+		// The first entry is port E's OTYPER-PUPDR run, MODER is the port's last so the pins drive only once set up
+		REQUIRE(IMAGE.words[0] == ((static_cast<uint32_t>(Block::PORT_E) << 24) | (3 << 16) | 0x04));
+		REQUIRE(IMAGE.words[4] == ((static_cast<uint32_t>(Block::PORT_E) << 24) | (1 << 16) | 0x14));
+		REQUIRE(IMAGE.words[6] == ((static_cast<uint32_t>(Block::PORT_E) << 24) | (2 << 16) | 0x20));
+		REQUIRE(IMAGE.words[9] == ((static_cast<uint32_t>(Block::PORT_E) << 24) | (1 << 16) | 0x00));
+		REQUIRE(IMAGE.words[10] == 0xFFFBFFD7);
+		REQUIRE(IMAGE.words[11] == ((static_cast<uint32_t>(Block::PORT_F) << 24) | (3 << 16) | 0x04));
+	}
+
+
+	SECTION("Board Image Apply") {
+		reset_registers();
+		Chip::Board::release_clocks();
+		const uint8_t HELD = Chip::Clock::references(Chip::Clock::Gate::TIM3EN);
+		Chip::init(IMAGE);
+		check_registers();
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM3EN) == HELD + 1);
+
+		// Applying again, or another image with the same clocks, keeps the one reference
+		Chip::init(IMAGE);
+		Chip::init(IMAGE, 3);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM3EN) == HELD + 1);
+		Chip::Board::release_clocks();
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM3EN) == HELD);
+	}
+
+
+	SECTION("Board Image Apply DMA") {
+		// Eight consecutive timer registers make a run long enough for the DMA path
+		constexpr auto LONG_RUN = Chip::Board::Builder<8>()
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR1), 11)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR2), 22)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR3), 33)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR4), 44)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, BDTR), 55)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR5), 66)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR6), 77)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCMR3), 88);
+		constexpr auto LONG_RUN_IMAGE = LONG_RUN.compile<LONG_RUN.image_size()>();
+		static_assert(LONG_RUN.image_size() == 9, "");
+
+		reset_registers();
+		Chip::init(IMAGE, 3);
+		check_registers();
+
+		Chip::init(LONG_RUN_IMAGE, 3);
+		REQUIRE(TIM2->CCR1 == 11);
+		REQUIRE(TIM2->BDTR == 55);
+		REQUIRE(TIM2->CCMR3 == 88);
+		REQUIRE((DMA1_Channel4->CCR & (1 << 0)) == 0);
+		REQUIRE(!DMA_Class::allocated(3));
+
+		// A short entry of the run's block waits for the run, one of another block goes ahead of it
+		constexpr auto MIXED = Chip::Board::Builder<10>()
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR1), 1)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR2), 2)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR3), 3)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR4), 4)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, BDTR), 5)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR5), 6)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCR6), 7)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, CCMR3), 8)
+			.write(Block::TIMER_2, offsetof(TIM_TypeDef, ECR), 1 << 0, 1 << 0)
+			.write(Block::TIMER_3, offsetof(TIM_TypeDef, ARR), 499);
+		constexpr auto MIXED_IMAGE = MIXED.compile<MIXED.image_size()>();
+		TIM2->ECR = 0;
+		Chip::init(MIXED_IMAGE, 3);
+		REQUIRE(TIM2->CCR1 == 1);
+		REQUIRE(TIM2->CCMR3 == 8);
+		REQUIRE(TIM2->ECR == (1 << 0));
+		REQUIRE(TIM3->ARR == 499);
+		REQUIRE(!DMA_Class::allocated(3));
+
+		// A channel that is taken leaves the whole image to the CPU
+		REQUIRE(DMA_Class::reserve(3));
+		TIM2->CCR1 = 0;
+		Chip::init(LONG_RUN_IMAGE, 3);
+		REQUIRE(TIM2->CCR1 == 11);
+		REQUIRE(DMA_Class::allocated(3));
+		DMA_Class::free(3);
+	}
+}
+
+
+TEST_CASE("Chip board image benchmark", "[Chip][Board][.benchmark]")
+{
+	BENCHMARK("Board image apply") {
+		Chip::Board::apply(IMAGE.words, sizeof(IMAGE.words) / sizeof(uint32_t), IMAGE.clocks);
+		return GPIOE->MODER;
+	};
+
+	BENCHMARK("Imperative GPIO calls") {
+		const GPIO::GPIO_Pin_t PINS[] = {GPIO::PinId(GPIO::Port::E, 1), GPIO::PinId(GPIO::Port::E, 2),
+		                                 GPIO::PinId(GPIO::Port::E, 9), GPIO::PinId(GPIO::Port::F, 0)};
+		for (auto pin: PINS) {
+			GPIO::set_mode(pin, GPIO::Pin_Mode::OUTPUT);
+			GPIO::set_otype(pin, GPIO::Pin_OType::PUSH_PULL);
+			GPIO::set_ospeed(pin, GPIO::Pin_OSpeed::HIGH_SPEED);
+			GPIO::set_pupd(pin, GPIO::Pin_PUPD::NO_PULL_UP_DOWN);
+			GPIO::set_alternate_function(pin, GPIO::Pin_AF::AF0);
+			GPIO::set(pin);
+		}
+		Timer_Class::set_clock(TIM3, Timer_Class::Clock_Status::ENABLED);
+		Timer_Class::set_time_base(TIM3, 169, 999);
+		Timer_Class::set_clock(TIM3, Timer_Class::Clock_Status::DISABLED);
+		return GPIOE->MODER;
+	};
+}
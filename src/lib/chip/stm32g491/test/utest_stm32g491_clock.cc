@@ -0,0 +1,193 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_stm32g491_clock.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include "../stm32g491_chip.hh"
+
+
+
+TEST_CASE("Chip clock gates", "[Chip][Clock]")
+{
+	using Gate = Chip::Clock::Gate;
+	using Bus = Chip::Clock::Bus;
+	auto gate = GENERATE(Gate::CORDICEN, Gate::CRCEN, Gate::DAC3EN, Gate::RNGEN, Gate::QSPIEN, Gate::I2C3EN,
+	                     Gate::LPUART1EN, Gate::UCPD1EN, Gate::SYSCFGEN, Gate::SAI1EN);
+
+
+	SECTION("Clock Gate Encoding") {
+		// Doc: RM0440-7.4.14-7.4.19
+		static_assert(Chip::Clock::bus(Gate::GPIOCEN) == Bus::AHB2 && Chip::Clock::bit(Gate::GPIOCEN) == (1 << 2), "");
+		static_assert(Chip::Clock::bus(Gate::LPTIM1EN) == Bus::APB1_1 && Chip::Clock::bit(Gate::LPTIM1EN) == (1u << 31), "");
+		static_assert(Chip::Clock::bus(Gate::TIM20EN) == Bus::APB2 && Chip::Clock::bit(Gate::TIM20EN) == (1 << 20), "");
+
+		volatile uint32_t *const REGISTERS[] = {
+			&RCC->AHB1ENR, &RCC->AHB2ENR, &RCC->AHB3ENR, &RCC->APB1ENR1, &RCC->APB1ENR2, &RCC->APB2ENR
+		};
+		const uint8_t HELD = Chip::Clock::references(gate);
+		Chip::Clock::acquire(gate);
+		REQUIRE((*REGISTERS[static_cast<uint8_t>(Chip::Clock::bus(gate))] & Chip::Clock::bit(gate)) != 0);
+		REQUIRE((Chip::Clock::running(Chip::Clock::bus(gate)) & Chip::Clock::bit(gate)) != 0);
+		Chip::Clock::release(gate);
+		REQUIRE(Chip::Clock::references(gate) == HELD);
+	}
+
+
+	SECTION("Clock Reference Counting") {
+		// None of these gates are used by the drivers under test
+		REQUIRE(Chip::Clock::references(gate) == 0);
+		REQUIRE(!Chip::Clock::is_running(gate));
+
+		// Two users: the clock stays on until the last one releases it
+		Chip::Clock::acquire(gate);
+		Chip::Clock::acquire(gate);
+		REQUIRE(Chip::Clock::references(gate) == 2);
+		Chip::Clock::release(gate);
+		REQUIRE(Chip::Clock::is_running(gate));
+		Chip::Clock::release(gate);
+		REQUIRE(!Chip::Clock::is_running(gate));
+
+		// Unbalanced releases can't turn off a clock someone else holds
+		Chip::Clock::release(gate);
+		Chip::Clock::acquire(gate);
+		REQUIRE(Chip::Clock::references(gate) == 1);
+		REQUIRE(Chip::Clock::is_running(gate));
+		Chip::Clock::release(gate);
+	}
+
+
+	SECTION("Clock Gates Are Independent") {
+		const uint32_t OTHER_BITS = Chip::Clock::running(Chip::Clock::bus(gate)) & ~Chip::Clock::bit(gate);
+		Chip::Clock::acquire(gate);
+		Chip::Clock::release(gate);
+		REQUIRE(Chip::Clock::running(Chip::Clock::bus(gate)) == OTHER_BITS);
+	}
+
+
+	SECTION("Clock Saturation") {
+		// A count that saturates is pinned on, leaked references can't wrap around to 0
+		const Gate FMAC = Gate::FMACEN;
+		for (uint16_t i = 0; i < 300; i++) {
+			Chip::Clock::acquire(FMAC);
+		}
+		REQUIRE(Chip::Clock::references(FMAC) == UINT8_MAX);
+		Chip::Clock::release(FMAC);
+		REQUIRE(Chip::Clock::is_running(FMAC));
+	}
+}
+
+
+TEST_CASE("Chip clock gates shared by drivers", "[Chip][Clock]")
+{
+	using GPIO = Chip::GPIO;
+	using Gate = Chip::Clock::Gate;
+
+	// A timer started by the waveform driver & held by the application survives the waveform stopping
+	Waveform_Class::Waveform_t WAVEFORM = {.port=GPIOF, .timer=TIM17, .dma_channel=14, .started=false};
+	const uint32_t BUFFER[] = {1, 1 << 16};
+
+	// Counted from what the other tests hold, the gates may already be running
+	const uint8_t TIMER_HELD = Chip::Clock::references(Gate::TIM17EN);
+	Timer_Class::set_clock(TIM17, Timer_Class::Clock_Status::ENABLED);
+	REQUIRE(Waveform_Class::start(WAVEFORM, BUFFER, 2, Waveform_Class::Playback::CIRCULAR, 0, 1));
+	REQUIRE(Chip::Clock::is_running(Gate::DMA2EN));
+	REQUIRE(Chip::Clock::is_running(Gate::DMAMUX1EN));
+	Waveform_Class::stop(WAVEFORM);
+	REQUIRE(Chip::Clock::references(Gate::TIM17EN) == TIMER_HELD + 1);
+	REQUIRE(Chip::Clock::is_running(Gate::TIM17EN));
+	Timer_Class::set_clock(TIM17, Timer_Class::Clock_Status::DISABLED);
+	REQUIRE(Chip::Clock::references(Gate::TIM17EN) == TIMER_HELD);
+
+	// Two drivers sharing a port: dropping one pin doesn't stop the other
+	const uint8_t PORT_HELD = Chip::Clock::references(Gate::GPIOFEN);
+	GPIO::set_mode({.port=GPIOF, .number=3}, GPIO::Pin_Mode::OUTPUT);
+	GPIO::set_port_clock(GPIOF, GPIO::Clock_Status::ENABLED);
+	GPIO::set_mode({.port=GPIOF, .number=3}, GPIO::Pin_Mode::ANALOG);
+	REQUIRE(Chip::Clock::references(Gate::GPIOFEN) == PORT_HELD + 1);
+	REQUIRE(Chip::Clock::is_running(Gate::GPIOFEN));
+	GPIO::set_port_clock(GPIOF, GPIO::Clock_Status::DISABLED);
+	REQUIRE(Chip::Clock::references(Gate::GPIOFEN) == PORT_HELD);
+}
+
+
+TEST_CASE("Chip clock frequencies", "[Chip][Clock]")
+{
+	using Domain = Chip::Clock::Domain;
+	using Source = Chip::Clock::Source;
+
+	// Doc: RM0440-7.4.4 | 16 MHz / 4 * 85 / 2 = 170 MHz, with APB1 divided by 2
+	constexpr Chip::Clock::Tree_t TREE = {
+		.source=Source::PLL, .pll_source=Source::HSI16, .hse=HSE_VALUE, .pll_m=4, .pll_n=85, .pll_r=2,
+		.ahb_divider=1, .apb1_divider=2, .apb2_divider=1, .kernel_select=(0b10 << 2) | (0b01 << 18)
+	};
+	static_assert(Chip::Clock::frequency(TREE, Domain::SYSCLK) == 170000000, "");
+	static_assert(Chip::Clock::frequency(TREE, Domain::PCLK1) == 85000000, "");
+	static_assert(Chip::Clock::frequency(TREE, Domain::TIMER_PCLK1) == 170000000, "");
+	static_assert(Chip::Clock::frequency(TREE, Domain::TIMER_PCLK2) == 170000000, "");
+	static_assert(Chip::Clock::frequency(TREE, Domain::USART1_KERNEL) == 170000000, "");
+	static_assert(Chip::Clock::frequency(TREE, Domain::USART2_KERNEL) == Chip::Clock::HSI16_FREQUENCY, "");
+	static_assert(Chip::Clock::frequency(TREE, Domain::LPTIM1_KERNEL) == Chip::Clock::LSI_FREQUENCY, "");
+	static_assert(Chip::Clock::divider(Chip::Clock::frequency(TREE, Domain::USART1_KERNEL), 115200) == 1476, "");
+
+
+	SECTION("Clock Reset Frequencies") {
+		REQUIRE(Chip::Clock::frequency(Domain::SYSCLK) == Chip::Clock::HSI16_FREQUENCY);
+		REQUIRE(Chip::Clock::frequency(Domain::PCLK2) == Chip::Clock::HSI16_FREQUENCY);
+		REQUIRE(Chip::Clock::frequency(Domain::I2C1_KERNEL) == Chip::Clock::HSI16_FREQUENCY);
+	}
+
+
+	SECTION("Clock Frequency Updates") {
+		struct Notifications {
+			uint32_t count;
+			uint32_t changed;
+		} notifications = {0, 0};
+		const auto LISTENER = [](const uint32_t changed, void *const context) {
+			Notifications &n = *static_cast<Notifications *>(context);
+			n.count++;
+			n.changed = changed;
+		};
+		REQUIRE(Chip::Clock::subscribe(LISTENER, &notifications));
+
+		// Doc: RM0440-7.4.3-7.4.4 | Same tree as above, programmed into the RCC
+		RCC->PLLCFGR = (0b10 << 0) | (3 << 4) | (85 << 8) | (0b00 << 25);
+		RCC->CFGR = (0b11 << 0) | (0b11 << 2) | (0b100 << 8);
+		RCC->CCIPR = TREE.kernel_select;
+		const uint32_t CHANGED = Chip::Clock::update();
+		REQUIRE(Chip::Clock::frequency(Domain::SYSCLK) == Chip::Clock::frequency(TREE, Domain::SYSCLK));
+		for (uint8_t domain = 0; domain < Chip::Clock::NUM_DOMAINS; domain++) {
+			REQUIRE(Chip::Clock::frequency(static_cast<Domain>(domain))
+			        == Chip::Clock::frequency(TREE, static_cast<Domain>(domain)));
+		}
+		REQUIRE(notifications.count == 1);
+		REQUIRE(notifications.changed == CHANGED);
+		REQUIRE((CHANGED & (1 << static_cast<uint8_t>(Domain::USART2_KERNEL))) == 0);
+
+		// Nothing changed, nobody is notified
+		REQUIRE(Chip::Clock::update() == 0);
+		REQUIRE(notifications.count == 1);
+
+		// APB2 divided by 16 only changes what is clocked from APB2
+		RCC->CFGR |= (0b111 << 11);
+		REQUIRE(Chip::Clock::update() == ((1 << static_cast<uint8_t>(Domain::PCLK2))
+		                                  | (1 << static_cast<uint8_t>(Domain::TIMER_PCLK2))
+		                                  | (1 << static_cast<uint8_t>(Domain::USART1_KERNEL))));
+		REQUIRE(Chip::Clock::frequency(Domain::TIMER_PCLK2) == 170000000 / 8);
+
+		Chip::Clock::unsubscribe(LISTENER, &notifications);
+		RCC->PLLCFGR = 0;
+		RCC->CFGR = 0;
+		RCC->CCIPR = 0;
+		Chip::Clock::update();
+		REQUIRE(notifications.count == 2);
+		REQUIRE(Chip::Clock::frequency(Domain::HCLK) == Chip::Clock::HSI16_FREQUENCY);
+	}
+}
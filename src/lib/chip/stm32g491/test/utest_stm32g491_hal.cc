@@ -6,7 +6,7 @@
 // License      : MIT
 // Copyright    : (C) 2023, Liam Lawrence
 //
-// Updated      : February 25, 2023
+// Updated      : October 19, 2026
 //------------------------------------------------------------------------------
 
 #include <catch2/catch_test_macros.hpp>
@@ -42,4 +42,12 @@ TEST_CASE("Chip HAL", "[Chip][HAL][Registers]")
 		Chip::HAL::set_field(&reg, position, width, value);
 		REQUIRE(Chip::HAL::read_field(&reg, position, width) == value);
 	}
+
+
+	SECTION("Write Registers") {
+		uint32_t reg = static_cast<uint32_t>(rand_reg);
+
+		Chip::HAL::write_register(&reg, ~reg);
+		REQUIRE(Chip::HAL::read_register(&reg) == ~static_cast<uint32_t>(rand_reg));
+	}
 }
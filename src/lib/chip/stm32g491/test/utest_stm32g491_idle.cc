@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_stm32g491_idle.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include "../stm32g491_chip.hh"
+
+
+
+namespace {
+	struct Fired {
+		uint32_t count;
+		uint64_t at;
+	};
+
+	void record(void *const context)
+	{
+		Fired &fired = *static_cast<Fired *>(context);
+		fired.count++;
+		fired.at = Chip::Idle::now();
+	}
+}
+
+
+TEST_CASE("Chip tickless idle", "[Chip][Idle]")
+{
+	using Mode = Chip::Idle::Mode;
+
+	Chip::HAL::start_cycle_counter();
+	Chip::Idle::init();
+
+
+	SECTION("Idle Mode Selection") {
+		// Doc: RM0440-6.3 | Short stays & tight latencies keep the main regulator on
+		static_assert(Chip::Idle::ticks(1000000) == Chip::Idle::TICK_FREQUENCY, "");
+		static_assert(Chip::Idle::ticks(1) == 1, "");
+		static_assert(Chip::Idle::select_mode(Chip::Idle::ticks(100), 1000, 0) == Mode::SLEEP, "");
+		static_assert(Chip::Idle::select_mode(Chip::Idle::ticks(1500), 1000, 0) == Mode::STOP_0, "");
+		static_assert(Chip::Idle::select_mode(Chip::Idle::ticks(5000), 1000, 0) == Mode::STOP_1, "");
+		static_assert(Chip::Idle::select_mode(Chip::Idle::ticks(5000), 8, 0) == Mode::STOP_0, "");
+		static_assert(Chip::Idle::select_mode(Chip::Idle::ticks(5000), 0, 0) == Mode::SLEEP, "");
+
+		// Restarting the PLL counts against the latency budget
+		static_assert(Chip::Idle::select_mode(Chip::Idle::ticks(5000), 20, Chip::Idle::PLL_RESTART_LATENCY)
+		              == Mode::SLEEP, "");
+		static_assert(Chip::Idle::select_mode(Chip::Idle::ticks(5000), 60, Chip::Idle::PLL_RESTART_LATENCY)
+		              == Mode::STOP_1, "");
+	}
+
+
+	SECTION("Idle Time Base") {
+		// Doc: RM0440-32.7.4-32.7.7 | LSI ticks, free running over the whole counter
+		REQUIRE((RCC->CSR & 0b11) == 0b11);
+		REQUIRE(((RCC->CCIPR >> 18) & 0b11) == 0b01);
+		REQUIRE(Chip::Clock::frequency(Chip::Clock::Domain::LPTIM1_KERNEL) == Chip::Clock::LSI_FREQUENCY);
+		REQUIRE(LPTIM1->ARR == 0xFFFF);
+		REQUIRE((LPTIM1->CR & 0b101) == 0b101);
+		REQUIRE((EXTI->IMR1 & (1u << 29)) != 0);
+
+		// Time carries on across counter periods
+		uint64_t before = Chip::Idle::now();
+		for (uint32_t step = 0; step < 40; step++) {
+			advance_LPTIM(LPTIM1, 0x1000);
+			const uint64_t AFTER = Chip::Idle::now();
+			REQUIRE(AFTER - before == 0x1000);
+			before = AFTER;
+		}
+
+		// A rollover nobody has handled yet, like one that happens while idle() has interrupts masked
+		if (LPTIM1->CNT == 0xFFFF) {
+			advance_LPTIM(LPTIM1, 1);
+		}
+		Chip::HAL::disable_irq(LPTIM1_IRQn);
+		const uint64_t START = Chip::Idle::now();
+		const uint32_t TO_ROLLOVER = 0xFFFF - LPTIM1->CNT;
+		advance_LPTIM(LPTIM1, TO_ROLLOVER + 5);
+		REQUIRE((LPTIM1->ISR & (1 << 1)) != 0);
+		REQUIRE(Chip::Idle::now() - START == TO_ROLLOVER + 5);
+		Chip::HAL::enable_irq(LPTIM1_IRQn);
+		raise_IRQ(LPTIM1_IRQn);
+		update_LPTIM_status();
+		REQUIRE(Chip::Idle::now() - START == TO_ROLLOVER + 5);
+	}
+
+
+	SECTION("Idle Deadlines") {
+		Fired soon = {0, 0};
+		Fired later = {0, 0};
+		Fired never = {0, 0};
+		const uint64_t START = Chip::Idle::now();
+		const Chip::Idle::Mode_Stats_t STOP_BEFORE = Chip::Idle::stats(Mode::STOP_1);
+		const Chip::Idle::Mode_Stats_t SLEEP_BEFORE = Chip::Idle::stats(Mode::SLEEP);
+
+		REQUIRE(Chip::Idle::schedule(START + Chip::Idle::ticks(100000), record, &later));
+		REQUIRE(Chip::Idle::schedule(START + Chip::Idle::ticks(500), record, &soon));
+		REQUIRE(Chip::Idle::schedule(START + Chip::Idle::ticks(200000), record, &never));
+		Chip::Idle::cancel(record, &never);
+
+		// Half a millisecond away is too short for Stop, the core only sleeps
+		while (soon.count == 0) {
+			Chip::Idle::idle(1000);
+		}
+		REQUIRE(soon.count == 1);
+		REQUIRE(soon.at == START + Chip::Idle::ticks(500));
+		REQUIRE(later.count == 0);
+		REQUIRE(Chip::Idle::stats(Mode::SLEEP).entries > SLEEP_BEFORE.entries);
+
+		// A hundred milliseconds is worth Stop 1, the clock tree is still HSI16 so nothing needs restarting
+		while (later.count == 0) {
+			Chip::Idle::idle(1000);
+		}
+		REQUIRE(later.at == START + Chip::Idle::ticks(100000));
+		const Chip::Idle::Mode_Stats_t STOP = Chip::Idle::stats(Mode::STOP_1);
+		REQUIRE(STOP.entries > STOP_BEFORE.entries);
+		REQUIRE(STOP.resident_ticks - STOP_BEFORE.resident_ticks >= Chip::Idle::ticks(99000));
+		REQUIRE((PWR->CR1 & 0b111) == 0b001);
+		REQUIRE((SCB->SCR & (1 << 2)) == 0);
+
+		// A timeout that was cancelled never runs, the slots are all free again
+		Chip::Idle::idle(1000);
+		REQUIRE(never.count == 0);
+		for (uint8_t i = 0; i < Chip::Idle::MAX_TIMEOUTS; i++) {
+			REQUIRE(Chip::Idle::schedule(UINT64_MAX, record, &never));
+		}
+		REQUIRE(!Chip::Idle::schedule(UINT64_MAX, record, &never));
+		Chip::Idle::cancel(record, &never);
+	}
+
+
+	SECTION("Idle Clock Restart") {
+		// Stop wakes up on HSI16, the PLL is restarted before anything else runs
+		REQUIRE(Chip::Power::set_performance_level(Chip::Power::Level::RANGE_1_BOOST));
+		const Chip::Idle::Mode_Stats_t BEFORE = Chip::Idle::stats(Mode::STOP_1);
+
+		Fired fired = {0, 0};
+		REQUIRE(Chip::Idle::schedule(Chip::Idle::now() + Chip::Idle::ticks(50000), record, &fired));
+		while (fired.count == 0) {
+			Chip::Idle::idle(100);
+		}
+		const Chip::Idle::Mode_Stats_t STATS = Chip::Idle::stats(Mode::STOP_1);
+		REQUIRE(STATS.entries > BEFORE.entries);
+		REQUIRE(STATS.last_wakeup_cycles > 0);
+		REQUIRE(STATS.max_wakeup_cycles >= STATS.last_wakeup_cycles);
+		REQUIRE(((RCC->CFGR >> 2) & 0b11) == 0b11);
+		REQUIRE(((RCC->CR >> 25) & 1) == 1);
+		REQUIRE(Chip::Clock::tree().pll_n == 85);
+
+		// Too tight a latency for a PLL restart keeps the core in Sleep
+		const Chip::Idle::Mode_Stats_t SLEEP_BEFORE = Chip::Idle::stats(Mode::SLEEP);
+		fired = {0, 0};
+		REQUIRE(Chip::Idle::schedule(Chip::Idle::now() + Chip::Idle::ticks(50000), record, &fired));
+		while (fired.count == 0) {
+			Chip::Idle::idle(20);
+		}
+		REQUIRE(Chip::Idle::stats(Mode::STOP_1).entries == STATS.entries);
+		REQUIRE(Chip::Idle::stats(Mode::SLEEP).entries > SLEEP_BEFORE.entries);
+
+		// Back to the reset tree for the other tests
+		RCC->CR = (1 << 8) | (1 << 10);
+		RCC->CFGR = 0;
+		RCC->PLLCFGR = 0;
+		FLASH->ACR = 0;
+		Chip::Clock::update();
+	}
+}
@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_stm32g491_log.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstdio>
+#include "../stm32g491_chip.hh"
+
+
+
+TEST_CASE("Chip deferred logging", "[Chip][Log]")
+{
+	namespace Log = Chip::Log;
+	uint32_t words[Log::BUFFER_WORDS] = {};
+	Log::reset();
+
+
+	SECTION("Log Format IDs") {
+		static_assert(Log::count_arguments("Nothing") == 0, "");
+		static_assert(Log::count_arguments("%u of %d") == 2, "");
+		static_assert(Log::count_arguments("100%% at %u%%") == 1, "");
+		static_assert(Log::decodable("%-8.3f %08lX %hhu %zu %c %p 100%%"), "");
+		static_assert(!Log::decodable("%s"), "");
+		static_assert(!Log::decodable("%u then %-10s"), "");
+		static_assert(!Log::decodable("%"), "");
+		static_assert((Log::header("%u of %d") >> 28) == 2, "");
+		static_assert((Log::header("") & Log::ID_MASK) != 0, "");
+		static_assert(Log::format_id("%u of %d") != Log::format_id("%d of %u"), "");
+		static_assert(decltype(Log::num_arguments(1, 'a', 2.0f))::value == 3, "");
+	}
+
+
+	SECTION("Log Records") {
+		// The header, the cycle counter at the call & the arguments as they were, nothing formatted
+		DWT->CYCCNT = 1234;
+		CHIP_LOG("Motor %u at %d rpm", 3u, -1500);
+		DWT->CYCCNT = 5678;
+		CHIP_LOG("Current %f A", 1.5f);
+		CHIP_LOG("Started");
+		REQUIRE(Log::used() == 4 + 3 + 2);
+
+		REQUIRE(Log::read(words, Log::BUFFER_WORDS) == 9);
+		REQUIRE(words[0] == Log::header("Motor %u at %d rpm"));
+		REQUIRE(words[1] == 1234);
+		REQUIRE(words[2] == 3);
+		REQUIRE(words[3] == static_cast<uint32_t>(-1500));
+		REQUIRE(words[4] == Log::header("Current %f A"));
+		REQUIRE(words[5] == 5678);
+		REQUIRE(words[6] == 0x3FC00000);
+		REQUIRE(words[7] == Log::header("Started"));
+		REQUIRE(Log::used() == 0);
+		REQUIRE(Log::read(words, Log::BUFFER_WORDS) == 0);
+
+		// Only whole records are read, the rest stays for the next read
+		CHIP_LOG("%u", 1u);
+		CHIP_LOG("%u", 2u);
+		REQUIRE(Log::read(words, 5) == 3);
+		REQUIRE(words[2] == 1);
+		REQUIRE(Log::read(words, 2) == 0);
+		REQUIRE(Log::read(words, 3) == 3);
+		REQUIRE(words[2] == 2);
+	}
+
+
+	SECTION("Log Drops & Wraparound") {
+		// A record that doesn't fit is dropped whole & counted, the ones before it are kept
+		const uint32_t FITTING = Log::BUFFER_WORDS / 3;
+		for (uint32_t i = 0; i < FITTING + 2; i++) {
+			CHIP_LOG("Sample %u", i);
+		}
+		REQUIRE(Log::dropped() == 2);
+		REQUIRE(Log::used() == FITTING * 3);
+		CHIP_LOG("Started");
+		REQUIRE(Log::dropped() == 2);
+
+		REQUIRE(Log::read(words, Log::BUFFER_WORDS) == FITTING * 3 + 2);
+		for (uint32_t i = 0; i < FITTING; i++) {
+			REQUIRE(words[i * 3 + 2] == i);
+		}
+
+		// Records now run across the end of the ring & come out in order
+		for (uint32_t round = 0; round < 4; round++) {
+			for (uint32_t i = 0; i < 100; i++) {
+				CHIP_LOG("%u %u %u", round, i, i * 2);
+			}
+			REQUIRE(Log::read(words, Log::BUFFER_WORDS) == 500);
+			for (uint32_t i = 0; i < 100; i++) {
+				REQUIRE(words[i * 5 + 2] == round);
+				REQUIRE(words[i * 5 + 3] == i);
+				REQUIRE(words[i * 5 + 4] == i * 2);
+			}
+		}
+		REQUIRE(Log::dropped() == 2);
+
+		Log::reset();
+		REQUIRE(Log::dropped() == 0);
+		REQUIRE(Log::used() == 0);
+	}
+
+
+	SECTION("Log GPIO Warning") {
+		// Doc: RM0440-9.3.15-9.3.16 | Taking PB8 out of analog is logged, other pins aren't
+		const Chip::GPIO::GPIO_Pin_t PB8 = {.port=GPIOB, .number=8};
+		const Chip::GPIO::GPIO_Pin_t PB9 = {.port=GPIOB, .number=9};
+		Chip::GPIO::set_mode(PB9, Chip::GPIO::Pin_Mode::OUTPUT);
+		REQUIRE(Log::used() == 0);
+		Chip::GPIO::set_mode(PB8, Chip::GPIO::Pin_Mode::OUTPUT);
+		REQUIRE(Log::read(words, Log::BUFFER_WORDS) == 4);
+		REQUIRE((words[0] >> 28) == 2);
+		REQUIRE(words[2] == 'B');
+		REQUIRE(words[3] == 8);
+
+		Chip::GPIO::set_mode(PB8, Chip::GPIO::Pin_Mode::ANALOG);
+		Chip::GPIO::set_mode(PB9, Chip::GPIO::Pin_Mode::ANALOG);
+		REQUIRE(Log::used() == 0);
+	}
+
+
+	Log::reset();
+}
+
+
+TEST_CASE("Chip deferred logging benchmark", "[Chip][Log][.benchmark]")
+{
+	// A record written & read back against formatting the same message, which is what logging costs without it
+	uint32_t words[8];
+	char text[64];
+	Chip::Log::reset();
+
+	BENCHMARK("CHIP_LOG, 3 arguments") {
+		CHIP_LOG("Motor %u at %d rpm, %f A", 3u, -1500, 1.5f);
+		return Chip::Log::read(words, 8);
+	};
+	BENCHMARK("snprintf, 3 arguments") {
+		return snprintf(text, sizeof(text), "Motor %u at %d rpm, %f A", 3u, -1500, 1.5);
+	};
+
+	Chip::Log::reset();
+}
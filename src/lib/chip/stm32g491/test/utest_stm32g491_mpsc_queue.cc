@@ -0,0 +1,212 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_stm32g491_mpsc_queue.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../stm32g491_chip.hh"
+
+
+
+namespace {
+	typedef struct {
+		uint16_t source;
+		uint16_t code;
+		uint32_t data;
+	} Event_t;
+
+	typedef Chip::MPSCQueue<Event_t, 64, 3> Queue_t;
+
+	constexpr uint_fast8_t NUM_PRODUCERS = 8;
+	constexpr uint32_t EVENTS_PER_PRODUCER = 100000;
+
+	struct Drained {
+		Queue_t *queue;
+		uint16_t codes[8];
+		uint_fast8_t priorities[8];
+		uint_fast8_t count;
+	};
+
+	void record(const Event_t &event, const uint_fast8_t priority, void *const context)
+	{
+		Drained &drained = *static_cast<Drained *>(context);
+		drained.codes[drained.count] = event.code;
+		drained.priorities[drained.count] = priority;
+		drained.count++;
+
+		// An urgent event raised while a lower one is handled goes ahead of the rest
+		if (event.code == 20) {
+			(void) drained.queue->push({.source=0, .code=1, .data=0}, 0);
+		}
+	}
+
+	// Every producer posts its own numbered events at its own priority & gives up on the ones that don't fit,
+	// the consumer checks each producer's events arrive in order, at its priority, with only dropped ones missing
+	uint32_t hammer(Queue_t &queue, uint32_t *const received, uint32_t *const failed)
+	{
+		std::atomic<uint32_t> finished(0);
+		std::vector<std::thread> producers;
+		for (uint16_t source = 0; source < NUM_PRODUCERS; source++) {
+			producers.emplace_back([&queue, &finished, source, failed]() {
+				for (uint32_t i = 0; i < EVENTS_PER_PRODUCER; i++) {
+					if (!queue.push({.source=source, .code=0, .data=i}, static_cast<uint_fast8_t>(source % 3))) {
+						failed[source]++;
+						std::this_thread::yield();
+					}
+				}
+				finished++;
+			});
+		}
+
+		uint32_t errors = 0;
+		uint32_t next[NUM_PRODUCERS] = {};
+		while (true) {
+			// Read before the pop, so an empty queue after every producer returned really is the end
+			const bool LAST = (finished == NUM_PRODUCERS);
+			Event_t event;
+			uint_fast8_t priority;
+			if (queue.pop(event, &priority)) {
+				if (event.source >= NUM_PRODUCERS) {
+					errors++;
+					continue;
+				}
+				errors += (priority != event.source % 3 || event.data < next[event.source]);
+				next[event.source] = event.data + 1;
+				received[event.source]++;
+			} else if (LAST) {
+				break;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+		for (std::thread &producer : producers) {
+			producer.join();
+		}
+		return errors;
+	}
+}
+
+
+TEST_CASE("Chip MPSC queue", "[Chip][MPSCQueue]")
+{
+	static Queue_t queue;
+	Event_t event = {};
+	uint_fast8_t priority = 0;
+
+
+	SECTION("MPSC Queue Priorities") {
+		// The most urgent level first & each level in the order it was posted, out of range goes to the last
+		REQUIRE(queue.push({.source=0, .code=30, .data=0}, 2));
+		REQUIRE(queue.push({.source=0, .code=10, .data=0}, 0));
+		REQUIRE(queue.push({.source=0, .code=20, .data=0}, 1));
+		REQUIRE(queue.push({.source=0, .code=31, .data=0}, 7));
+		REQUIRE(queue.push({.source=0, .code=11, .data=0}, 0));
+		REQUIRE(queue.size(2) == 2);
+		REQUIRE(queue.size(7) == 2);
+
+		const uint16_t EXPECTED[] = {10, 11, 20, 30, 31};
+		for (const uint16_t CODE : EXPECTED) {
+			REQUIRE(queue.pop(event, &priority));
+			REQUIRE(event.code == CODE);
+			REQUIRE(priority == CODE / 10 - 1);
+		}
+		REQUIRE(!queue.pop(event));
+		REQUIRE(queue.empty());
+	}
+
+
+	SECTION("MPSC Queue Drain") {
+		Drained drained = {};
+		drained.queue = &queue;
+		REQUIRE(queue.push({.source=0, .code=30, .data=0}, 2));
+		REQUIRE(queue.push({.source=0, .code=20, .data=0}, 1));
+		REQUIRE(queue.push({.source=0, .code=21, .data=0}, 1));
+
+		REQUIRE(queue.drain(record, &drained, 2) == 2);
+		REQUIRE(drained.codes[0] == 20);
+		REQUIRE(drained.codes[1] == 1);
+		REQUIRE(drained.priorities[1] == 0);
+
+		REQUIRE(queue.drain(record, &drained) == 2);
+		REQUIRE(drained.codes[2] == 21);
+		REQUIRE(drained.codes[3] == 30);
+		REQUIRE(drained.priorities[3] == 2);
+		REQUIRE(queue.drain(record, &drained) == 0);
+	}
+
+
+	SECTION("MPSC Queue Statistics") {
+		// A full level drops & counts, the others are unaffected
+		queue.clear_statistics();
+		for (uint32_t i = 0; i < Queue_t::CAPACITY + 5; i++) {
+			(void) queue.push({.source=0, .code=0, .data=i}, 1);
+		}
+		REQUIRE(queue.push({.source=0, .code=0, .data=0}, 0));
+		REQUIRE(queue.dropped(1) == 5);
+		REQUIRE(queue.dropped(0) == 0);
+		REQUIRE(queue.high_water(1) == Queue_t::CAPACITY);
+		REQUIRE(queue.high_water(0) == 1);
+		REQUIRE(queue.dropped(7) == 0);
+		REQUIRE(queue.high_water(7) == 0);
+		(void) queue.push({.source=0, .code=0, .data=0}, 7);
+		REQUIRE(queue.high_water(7) == 1);
+
+		// The high water mark stays after the queue empties, until it's cleared
+		while (queue.pop(event)) {}
+		REQUIRE(queue.high_water(1) == Queue_t::CAPACITY);
+		REQUIRE(queue.push({.source=0, .code=0, .data=0}, 1));
+		REQUIRE(queue.pop(event));
+		REQUIRE(queue.high_water(1) == Queue_t::CAPACITY);
+		queue.clear_statistics();
+		REQUIRE(queue.high_water(1) == 0);
+		REQUIRE(queue.dropped(1) == 0);
+	}
+
+
+	SECTION("MPSC Queue Threads") {
+		uint32_t received[NUM_PRODUCERS] = {};
+		uint32_t failed[NUM_PRODUCERS] = {};
+		queue.clear_statistics();
+		REQUIRE(hammer(queue, received, failed) == 0);
+
+		uint32_t dropped[3] = {};
+		for (uint_fast8_t i = 0; i < NUM_PRODUCERS; i++) {
+			REQUIRE(received[i] + failed[i] == EVENTS_PER_PRODUCER);
+			dropped[i % 3] += failed[i];
+		}
+		for (uint_fast8_t level = 0; level < 3; level++) {
+			REQUIRE(queue.dropped(level) == dropped[level]);
+			REQUIRE(queue.high_water(level) <= Queue_t::CAPACITY);
+		}
+		REQUIRE(queue.empty());
+		queue.clear_statistics();
+	}
+}
+
+
+TEST_CASE("Chip MPSC queue benchmark", "[Chip][MPSCQueue][.benchmark]")
+{
+	static Queue_t queue;
+
+	BENCHMARK("Push & pop, one thread") {
+		(void) queue.push({.source=0, .code=0, .data=1}, 1);
+		Event_t event;
+		return queue.pop(event);
+	};
+
+	BENCHMARK("8 producers, 100000 events each") {
+		uint32_t received[NUM_PRODUCERS] = {};
+		uint32_t failed[NUM_PRODUCERS] = {};
+		return hammer(queue, received, failed);
+	};
+}
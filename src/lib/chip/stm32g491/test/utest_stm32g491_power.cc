@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_stm32g491_power.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include "../stm32g491_chip.hh"
+
+
+
+TEST_CASE("Chip performance levels", "[Chip][Power]")
+{
+	using Level = Chip::Power::Level;
+	using Domain = Chip::Clock::Domain;
+
+	// Doc: RM0440-6.1.5 & 7.4.1 | Out of reset the chip runs range 1 normal mode from HSI16
+	RCC->CR = (1 << 8) | (1 << 10);
+	RCC->CFGR = 0;
+	RCC->PLLCFGR = 0;
+	PWR->CR1 = (0b01 << 9);
+	PWR->CR5 = (1 << 8);
+	FLASH->ACR = 0;
+	Chip::Clock::update();
+	Chip::HAL::start_cycle_counter();
+
+
+	SECTION("Power Level Trees") {
+		// Doc: RM0440-5.3.3 | Each level runs at the top of its range with the wait states it needs
+		static_assert(Chip::Clock::frequency(Chip::Power::tree(Level::RANGE_1_BOOST), Domain::SYSCLK) == 170000000, "");
+		static_assert(Chip::Clock::frequency(Chip::Power::tree(Level::RANGE_1), Domain::SYSCLK) == 150000000, "");
+		static_assert(Chip::Clock::frequency(Chip::Power::tree(Level::RANGE_2), Domain::HCLK) == 16000000, "");
+		static_assert(Chip::Clock::frequency(Chip::Power::tree(Level::LOW_POWER_RUN), Domain::HCLK) == 2000000, "");
+		static_assert(Chip::Power::flash_latency(Level::RANGE_1_BOOST, 170000000) == 4, "");
+		static_assert(Chip::Power::flash_latency(Level::RANGE_1_BOOST, 34000000) == 0, "");
+		static_assert(Chip::Power::flash_latency(Level::RANGE_1, 150000000) == 4, "");
+		static_assert(Chip::Power::flash_latency(Level::RANGE_2, 16000000) == 1, "");
+		static_assert(Chip::Power::flash_latency(Level::LOW_POWER_RUN, 2000000) == 0, "");
+
+		REQUIRE(Chip::Power::performance_level() == Level::RANGE_1);
+	}
+
+
+	SECTION("Power Level Switching") {
+		auto from = GENERATE(Level::RANGE_1_BOOST, Level::RANGE_1, Level::RANGE_2, Level::LOW_POWER_RUN);
+		auto to = GENERATE(Level::RANGE_1_BOOST, Level::RANGE_1, Level::RANGE_2, Level::LOW_POWER_RUN);
+		// The kernel clock selections are kept across levels, as set_performance_level() does
+		const Chip::Clock::Tree_t TREE = Chip::Power::tree(to, RCC->CCIPR);
+
+		REQUIRE(Chip::Power::set_performance_level(from));
+		REQUIRE(Chip::Power::set_performance_level(to));
+		REQUIRE(Chip::Power::performance_level() == to);
+
+		// Doc: RM0440-6.4.1, 6.4.22 & 5.7.1
+		const bool RANGE_1 = (to == Level::RANGE_1_BOOST || to == Level::RANGE_1);
+		REQUIRE(((PWR->CR1 >> 9) & 0b11) == (RANGE_1 ? 0b01u : 0b10u));
+		REQUIRE(((PWR->CR1 >> 14) & 1) == (to == Level::LOW_POWER_RUN));
+		REQUIRE((FLASH->ACR & 0b1111) == Chip::Power::flash_latency(to, Chip::Clock::frequency(TREE, Domain::HCLK)));
+		if (RANGE_1) {
+			REQUIRE(((PWR->CR5 >> 8) & 1) == (to == Level::RANGE_1));
+		}
+
+		// The PLL only runs when it is the system clock & the boost step through AHB / 2 is undone
+		REQUIRE(((RCC->CR >> 24) & 1) == RANGE_1);
+		REQUIRE(((RCC->CFGR >> 4) & 0b1111) == ((to == Level::LOW_POWER_RUN) ? 0b1010u : 0u));
+		for (uint8_t domain = 0; domain < Chip::Clock::NUM_DOMAINS; domain++) {
+			REQUIRE(Chip::Clock::frequency(static_cast<Domain>(domain))
+			        == Chip::Clock::frequency(TREE, static_cast<Domain>(domain)));
+		}
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::PWREN) == 0);
+	}
+
+
+	SECTION("Power Level Notifications & Latency") {
+		uint32_t changed = 0;
+		const auto LISTENER = [](const uint32_t changed_domains, void *const context) {
+			*static_cast<uint32_t *>(context) |= changed_domains;
+		};
+		REQUIRE(Chip::Clock::subscribe(LISTENER, &changed));
+
+		const Chip::Power::Switch_Stats_t BEFORE = Chip::Power::switch_stats();
+		REQUIRE(Chip::Power::set_performance_level(Level::RANGE_1_BOOST));
+		REQUIRE((changed & (1 << static_cast<uint8_t>(Domain::HCLK))) != 0);
+		REQUIRE(Chip::Clock::frequency(Domain::TIMER_PCLK1) == 170000000);
+
+		// Waiting on the PLL & the 1 us boost step both take time
+		const Chip::Power::Switch_Stats_t STATS = Chip::Power::switch_stats();
+		REQUIRE(STATS.switches == BEFORE.switches + 1);
+		REQUIRE(STATS.last_cycles >= 170 / 2);
+		REQUIRE(STATS.max_cycles >= STATS.last_cycles);
+
+		// Staying at a level still goes through the sequence, but no frequency changes
+		changed = 0;
+		REQUIRE(Chip::Power::set_performance_level(Level::RANGE_1_BOOST));
+		REQUIRE(changed == 0);
+		Chip::Clock::unsubscribe(LISTENER, &changed);
+	}
+
+
+	// Back to the reset tree for the other tests
+	RCC->CR = (1 << 8) | (1 << 10);
+	RCC->CFGR = 0;
+	RCC->PLLCFGR = 0;
+	FLASH->ACR = 0;
+	Chip::Clock::update();
+}
@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_stm32g491_spsc_ring.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <thread>
+#include "../stm32g491_chip.hh"
+
+
+
+namespace {
+	constexpr uint32_t STRESS_COUNT = 1000000;
+
+	// The producer pushes 0, 1, 2, ... in runs of 1 to 13, the consumer checks every value arrives once & in order,
+	// popping one at a time, in bulk or through the read span depending on where it is in the stream.
+	// Either side yields when it can't move, so the test still runs on a single core
+	template<uint32_t N>
+	uint32_t transfer(Chip::SPSCRing<uint32_t, N> &ring, const uint32_t count)
+	{
+		std::thread producer([&ring, count]() {
+			uint32_t values[13];
+			uint32_t next = 0;
+			while (next < count) {
+				const uint32_t RUN = std::min<uint32_t>(1 + next % 13, count - next);
+				for (uint32_t i = 0; i < RUN; i++) {
+					values[i] = next + i;
+				}
+				const uint32_t PUSHED = ring.push(values, RUN);
+				if (PUSHED == 0) {
+					std::this_thread::yield();
+				}
+				next += PUSHED;
+			}
+		});
+
+		uint32_t errors = 0;
+		uint32_t expected = 0;
+		uint32_t values[16];
+		while (expected < count) {
+			if (ring.empty()) {
+				std::this_thread::yield();
+			} else if (expected % 3 == 0) {
+				uint32_t value;
+				if (ring.pop(value)) {
+					errors += (value != expected++);
+				}
+			} else if (expected % 3 == 1) {
+				const uint32_t POPPED = ring.pop(values, 16);
+				for (uint32_t i = 0; i < POPPED; i++) {
+					errors += (values[i] != expected++);
+				}
+			} else {
+				const auto SPAN = ring.read_span();
+				for (uint32_t i = 0; i < SPAN.length; i++) {
+					errors += (SPAN.data[i] != expected++);
+				}
+				ring.consume(SPAN.length);
+			}
+		}
+		producer.join();
+		return errors;
+	}
+}
+
+
+TEST_CASE("Chip SPSC ring", "[Chip][SPSCRing]")
+{
+	SECTION("SPSC Ring Single Elements") {
+		Chip::SPSCRing<uint16_t, 4> ring;
+		REQUIRE(ring.empty());
+		REQUIRE(ring.space() == 4);
+
+		for (uint16_t i = 0; i < 4; i++) {
+			REQUIRE(ring.push(static_cast<uint16_t>(100 + i)));
+		}
+		REQUIRE(ring.full());
+		REQUIRE(!ring.push(200));
+
+		// Around the end of the storage a few times
+		uint16_t value = 0;
+		for (uint16_t i = 0; i < 10; i++) {
+			REQUIRE(ring.pop(value));
+			REQUIRE(value == 100 + i);
+			REQUIRE(ring.push(static_cast<uint16_t>(104 + i)));
+		}
+		REQUIRE(ring.size() == 4);
+		while (ring.pop(value)) {}
+		REQUIRE(value == 113);
+		REQUIRE(ring.empty());
+	}
+
+
+	SECTION("SPSC Ring Bulk") {
+		// Bulk copies split at the end of the storage & stop at what fits or what there is
+		Chip::SPSCRing<uint32_t, 8> ring;
+		const uint32_t VALUES[11] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+		uint32_t popped[10] = {};
+
+		REQUIRE(ring.push(VALUES, 5) == 5);
+		REQUIRE(ring.pop(popped, 3) == 3);
+		REQUIRE(ring.push(&VALUES[5], 6) == 6);
+		REQUIRE(ring.full());
+		REQUIRE(ring.push(VALUES, 1) == 0);
+
+		REQUIRE(ring.pop(popped, 10) == 8);
+		for (uint32_t i = 0; i < 8; i++) {
+			REQUIRE(popped[i] == i + 3);
+		}
+		REQUIRE(ring.pop(popped, 10) == 0);
+	}
+
+
+	SECTION("SPSC Ring Spans") {
+		// A DMA filling the free space in place, in as many parts as it takes to go around the storage
+		Chip::SPSCRing<uint8_t, 8> ring;
+		uint8_t value = 0;
+		for (uint8_t i = 0; i < 6; i++) {
+			REQUIRE(ring.push(i));
+			REQUIRE(ring.pop(value));
+		}
+
+		auto write = ring.write_span();
+		REQUIRE(write.length == 2);
+		write.data[0] = 'a';
+		write.data[1] = 'b';
+		ring.commit(2);
+		write = ring.write_span();
+		REQUIRE(write.length == 6);
+		write.data[0] = 'c';
+		ring.commit(1);
+
+		auto read = ring.read_span();
+		REQUIRE(read.length == 2);
+		REQUIRE(read.data[0] == 'a');
+		REQUIRE(read.data[1] == 'b');
+		ring.consume(2);
+		read = ring.read_span();
+		REQUIRE(read.length == 1);
+		REQUIRE(read.data[0] == 'c');
+		ring.consume(1);
+		REQUIRE(ring.read_span().length == 0);
+		REQUIRE(ring.write_span().length == 7);
+	}
+
+
+	SECTION("SPSC Ring Threads") {
+		// Small rings keep both sides on the full & empty edges most of the time
+		static Chip::SPSCRing<uint32_t, 16> small;
+		static Chip::SPSCRing<uint32_t, 1024> large;
+		REQUIRE(transfer(small, STRESS_COUNT) == 0);
+		REQUIRE(small.empty());
+		REQUIRE(transfer(large, STRESS_COUNT) == 0);
+		REQUIRE(large.empty());
+	}
+}
+
+
+TEST_CASE("Chip SPSC ring benchmark", "[Chip][SPSCRing][.benchmark]")
+{
+	static Chip::SPSCRing<uint32_t, 256> ring;
+	static uint32_t values[64];
+
+	BENCHMARK("64 elements, one at a time") {
+		for (uint32_t i = 0; i < 64; i++) {
+			(void) ring.push(i);
+		}
+		uint32_t sum = 0;
+		uint32_t value;
+		while (ring.pop(value)) {
+			sum += value;
+		}
+		return sum;
+	};
+
+	BENCHMARK("64 elements, bulk") {
+		(void) ring.push(values, 64);
+		return ring.pop(values, 64);
+	};
+
+	BENCHMARK("100000 elements across 2 threads") {
+		return transfer(ring, STRESS_COUNT / 10);
+	};
+}
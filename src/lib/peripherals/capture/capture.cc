@@ -0,0 +1,271 @@
+//------------------------------------------------------------------------------
+// File Name    : capture.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "capture.hh"
+#include "../timer/timer.hh"
+#include "../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+/*
+ * Capture functions
+ */
+// Returns false when something else holds the DMA channel, or the ring can't be split into halves for a callback
+bool Capture_Class::start(Capture_t &capture, const uint16_t prescaler, const uint32_t auto_reload)
+{
+	stop(capture);
+	if (capture.length == 0 || (capture.length & 1) != 0 || capture.callback == nullptr
+	    || !DMA_Class::reserve(capture.dma_channel)) {
+		return false;
+	}
+
+	Timer_Class::set_clock(capture.timer, Timer_Class::Clock_Status::ENABLED);
+	capture.started = true;
+	Timer_Class::set_time_base(capture.timer, prescaler, auto_reload);
+
+	// Doc: RM0440-9.4.5 | IDR only holds 16 pins, so half-word transfers halve the buffer size
+	const DMA_Class::Transfer_Config_t CONFIG = {
+		.request=Timer_Class::update_request(capture.timer),
+		.direction=DMA_Class::Direction::PERIPHERAL_TO_MEMORY,
+		.peripheral_width=DMA_Class::Data_Width::HALF_WORD,
+		.memory_width=DMA_Class::Data_Width::HALF_WORD,
+		.peripheral_increment=false,
+		.memory_increment=true,
+		.mode=DMA_Class::Transfer_Mode::CIRCULAR,
+		.priority=DMA_Class::Priority::VERY_HIGH
+	};
+	DMA_Class::set_callback(capture.dma_channel, dma_callback, &capture, true);
+	DMA_Class::configure(capture.dma_channel, CONFIG);
+	DMA_Class::start(capture.dma_channel, &capture.port->IDR, capture.buffer, capture.length);
+
+	Timer_Class::set_update_dma(capture.timer, true);
+	Timer_Class::start(capture.timer);
+	return true;
+}
+
+
+// Only undoes what start() did, the timer & channel may be someone else's or the counter may have stopped by itself
+void Capture_Class::stop(Capture_t &capture)
+{
+	if (!capture.started) {
+		return;
+	}
+	capture.started = false;
+	Timer_Class::stop(capture.timer);
+	Timer_Class::set_update_dma(capture.timer, false);
+	DMA_Class::free(capture.dma_channel);
+	Timer_Class::set_clock(capture.timer, Timer_Class::Clock_Status::DISABLED);
+}
+
+
+void Capture_Class::dma_callback(const uint_fast8_t, const DMA_Class::Event event, void *const context)
+{
+	const Capture_t &capture = *static_cast<const Capture_t *>(context);
+	const uint16_t HALF = capture.length / 2;
+
+	switch (event) {
+		case DMA_Class::Event::HALF_TRANSFER:
+			capture.callback(capture.buffer, HALF, capture.context);
+			break;
+		case DMA_Class::Event::TRANSFER_COMPLETE:
+			capture.callback(capture.buffer + HALF, HALF, capture.context);
+			break;
+		case DMA_Class::Event::TRANSFER_ERROR:
+		default:
+			break;
+	}
+}
+
+
+
+/*
+ * Pulse capture functions
+ */
+// prescaler sets the tick, a period must be shorter than one counter wrap, 65536 ticks on a 16-bit timer.
+// filter is ICxF, applied to both edges. Returns false when the timer can't DMA the edges asked for or something
+// else holds a DMA channel
+bool Capture_Class::start_pulses(Pulse_Capture_t &capture, const uint16_t prescaler, const uint8_t filter)
+{
+	stop_pulses(capture);
+	const bool FALLING = (capture.falling != nullptr);
+	if (Timer_Class::capture_request_channels(capture.timer) < (FALLING ? 2 : 1)
+	    || !DMA_Class::reserve(capture.rising_dma_channel)) {
+		return false;
+	}
+	if (FALLING && !DMA_Class::reserve(capture.falling_dma_channel)) {
+		DMA_Class::free(capture.rising_dma_channel);
+		return false;
+	}
+
+	// Doc: RM0440-29.3.6 | A free running counter over its whole range, so deltas wrap the way the counter does
+	capture.counter_max = (capture.timer == TIM2) ? UINT32_MAX : UINT16_MAX;
+	capture.rising_read = 0;
+	capture.falling_read = 0;
+	capture.has_last_rising = false;
+	Timer_Class::set_clock(capture.timer, Timer_Class::Clock_Status::ENABLED);
+	capture.started = true;
+	Timer_Class::set_time_base(capture.timer, prescaler, capture.counter_max);
+
+	// Doc: RM0440-29.3.7 | Channel 2 captures TI1 as well, on the opposite edge
+	Timer_Class::set_input_capture(capture.timer, 1, Timer_Class::Capture_Edge::RISING, filter);
+	if (FALLING) {
+		Timer_Class::set_input_capture(capture.timer, 2, Timer_Class::Capture_Edge::FALLING, filter,
+		                               Timer_Class::Capture_Input::INDIRECT);
+	}
+
+	// Doc: RM0440-12.4.7 | Whole words so TIM2's 32-bit captures fit, reading CCRx also clears CCxIF
+	DMA_Class::Transfer_Config_t config = {
+		.request=Timer_Class::capture_request(capture.timer, 1),
+		.direction=DMA_Class::Direction::PERIPHERAL_TO_MEMORY,
+		.peripheral_width=DMA_Class::Data_Width::WORD,
+		.memory_width=DMA_Class::Data_Width::WORD,
+		.peripheral_increment=false,
+		.memory_increment=true,
+		.mode=DMA_Class::Transfer_Mode::CIRCULAR,
+		.priority=DMA_Class::Priority::VERY_HIGH
+	};
+	DMA_Class::configure(capture.rising_dma_channel, config);
+	DMA_Class::start(capture.rising_dma_channel, &capture.timer->CCR1, capture.rising, capture.length);
+	Timer_Class::set_capture_dma(capture.timer, 1, true);
+
+	if (FALLING) {
+		config.request = Timer_Class::capture_request(capture.timer, 2);
+		DMA_Class::configure(capture.falling_dma_channel, config);
+		DMA_Class::start(capture.falling_dma_channel, &capture.timer->CCR2, capture.falling, capture.length);
+		Timer_Class::set_capture_dma(capture.timer, 2, true);
+	}
+	Timer_Class::start(capture.timer);
+	return true;
+}
+
+
+void Capture_Class::stop_pulses(Pulse_Capture_t &capture)
+{
+	if (!capture.started) {
+		return;
+	}
+	capture.started = false;
+	Timer_Class::stop(capture.timer);
+	Timer_Class::set_capture_dma(capture.timer, 1, false);
+	Timer_Class::set_capture_dma(capture.timer, 2, false);
+	DMA_Class::free(capture.rising_dma_channel);
+	if (capture.falling != nullptr) {
+		DMA_Class::free(capture.falling_dma_channel);
+	}
+	Timer_Class::set_clock(capture.timer, Timer_Class::Clock_Status::DISABLED);
+}
+
+
+// Consumes every edge captured since the last call. The rising ring is read up to where the DMA is before the
+// falling one, so the falling edge of each period read is already in its ring.
+Capture_Class::Pulse_Stats_t Capture_Class::measure(Pulse_Capture_t &capture, const uint32_t tick_frequency)
+{
+	Pulse_Stats_t stats = {.periods=0, .period=0, .min_period=0, .max_period=0, .frequency=0, .duty=0};
+	uint64_t total_ticks = 0;
+	uint64_t total_duty = 0;
+	uint32_t duty_periods = 0;
+
+	// Doc: RM0440-12.6.4 | A circular channel's CNDTR counts down to the end of the ring & reloads
+	const uint16_t RISING_END = static_cast<uint16_t>(capture.length - DMA_Class::remaining(capture.rising_dma_channel));
+	const uint16_t FALLING_END = (capture.falling == nullptr) ? 0
+		: static_cast<uint16_t>(capture.length - DMA_Class::remaining(capture.falling_dma_channel));
+
+	while (capture.rising_read != RISING_END) {
+		const uint32_t EDGE = capture.rising[capture.rising_read];
+		capture.rising_read = static_cast<uint16_t>((capture.rising_read + 1) % capture.length);
+
+		if (capture.has_last_rising) {
+			// Unsigned subtraction masked to the counter's width takes care of the counter wrapping in between
+			const uint32_t PERIOD = (EDGE - capture.last_rising) & capture.counter_max;
+			stats.min_period = (stats.periods == 0 || PERIOD < stats.min_period) ? PERIOD : stats.min_period;
+			stats.max_period = (PERIOD > stats.max_period) ? PERIOD : stats.max_period;
+			stats.periods++;
+			total_ticks += PERIOD;
+
+			uint32_t high = 0;
+			if (capture.falling != nullptr && PERIOD != 0
+			    && pair_falling_edge(capture, FALLING_END, capture.last_rising, PERIOD, high)) {
+				total_duty += static_cast<uint64_t>(high) * 10000 / PERIOD;
+				duty_periods++;
+			}
+		}
+		capture.last_rising = EDGE;
+		capture.has_last_rising = true;
+	}
+
+	if (stats.periods != 0 && total_ticks != 0) {
+		stats.period = static_cast<uint32_t>((total_ticks + stats.periods / 2) / stats.periods);
+		stats.frequency = static_cast<uint32_t>((static_cast<uint64_t>(tick_frequency) * 1000 * stats.periods
+		                                         + total_ticks / 2) / total_ticks);
+	}
+	if (duty_periods != 0) {
+		stats.duty = static_cast<uint32_t>((total_duty + duty_periods / 2) / duty_periods);
+	}
+	return stats;
+}
+
+
+// Finds the falling edge inside the period that starts at rising, dropping any from before it. Edges closer
+// behind the period's start than ahead of its end are from before it.
+bool Capture_Class::pair_falling_edge(Pulse_Capture_t &capture, const uint16_t falling_end, const uint32_t rising,
+                                      const uint32_t period, uint32_t &high)
+{
+	while (capture.falling_read != falling_end) {
+		const uint32_t EDGE = capture.falling[capture.falling_read];
+		const uint32_t INTO = (EDGE - rising) & capture.counter_max;
+		if (INTO < period) {
+			high = INTO;
+			capture.falling_read = static_cast<uint16_t>((capture.falling_read + 1) % capture.length);
+			return true;
+		}
+
+		const uint32_t BEFORE = (rising - EDGE) & capture.counter_max;
+		if (BEFORE > INTO - period) {
+			return false;
+		}
+		capture.falling_read = static_cast<uint16_t>((capture.falling_read + 1) % capture.length);
+	}
+	return false;
+}
+
+
+
+/*
+ * Run-length compression
+ */
+// Collapses consecutive identical samples into runs, an idle bus becomes a single run.
+// runs must have room for length entries, the worst case when every sample differs from the previous one.
+uint32_t Capture_Class::compress(const uint16_t *const samples, const uint32_t length, Run_t *const runs)
+{
+	uint32_t num_runs = 0;
+
+	for (uint32_t i = 0; i < length; i++) {
+		if (num_runs > 0 && runs[num_runs - 1].value == samples[i] && runs[num_runs - 1].count < UINT16_MAX) {
+			runs[num_runs - 1].count++;
+		} else {
+			runs[num_runs++] = {.value=samples[i], .count=1};
+		}
+	}
+	return num_runs;
+}
+
+
+uint32_t Capture_Class::expand(const Run_t *const runs, const uint32_t num_runs, uint16_t *const samples)
+{
+	uint32_t length = 0;
+
+	for (uint32_t i = 0; i < num_runs; i++) {
+		for (uint16_t j = 0; j < runs[i].count; j++) {
+			samples[length++] = runs[i].value;
+		}
+	}
+	return length;
+}
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+// File Name    : capture.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_CAPTURE_HH
+#define STM32G4_MODULE_LIBRARY_CAPTURE_HH
+
+#include <cstdint>
+#include "../dma/dma.hh"
+
+#ifdef UNIT_TEST
+#include "../../chip/stm32g491/stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+// Samples a whole GPIO port on every timer update event, like a logic analyzer.
+// The timer's update DMA request copies IDR into a circular buffer split into two halves; while the DMA fills
+// one half, the callback is handed the other, so the CPU never touches individual samples as they arrive.
+class Capture_Class {
+public:
+	typedef void (*Block_Callback_t)(const uint16_t *samples, uint16_t length, void *context);
+
+	typedef struct {
+		GPIO_TypeDef *port;             // Port whose IDR is sampled
+		TIM_TypeDef *timer;             // Update event paces the sampling
+		uint8_t dma_channel;            // 0-7 DMA1, 8-15 DMA2
+		uint16_t *buffer;               // Ring holding both halves
+		uint16_t length;                // Samples in the whole ring, must be even, 0 or odd is refused
+		Block_Callback_t callback;      // Called from the DMA interrupt with the half that just filled, required
+		void *context;
+		bool started;                   // Set while start() holds the timer clock & the DMA channel
+	} Capture_t;
+
+	typedef struct {
+		uint16_t value;                 // Port level
+		uint16_t count;                 // Consecutive samples at that level
+	} Run_t;
+
+	// Pulse train timestamps. Channel 1 captures the counter on every rising edge of the timer's first input &
+	// its DMA request copies CCR1 into a ring, channel 2 does the same for the falling edges when duty is measured.
+	// No interrupt runs per edge, measure() turns the edges since its last call into a batch of statistics.
+	// TIM15-17 have no request for a second channel, so they only capture rising edges, falling set to nullptr.
+	typedef struct {
+		TIM_TypeDef *timer;             // Free running, TIM2 counts 32 bits & the rest 16
+		uint8_t rising_dma_channel;     // 0-7 DMA1, 8-15 DMA2
+		uint8_t falling_dma_channel;
+		uint32_t *rising;               // Ring of counter values at rising edges
+		uint32_t *falling;              // Ring of counter values at falling edges, nullptr skips duty
+		uint16_t length;                // Entries in each ring, measure() must run before either fills
+		uint16_t rising_read;           // The rest is state kept by start_pulses() & measure()
+		uint16_t falling_read;
+		uint32_t counter_max;
+		uint32_t last_rising;
+		bool has_last_rising;
+		bool started;                   // Set while start_pulses() holds the timer clock & the DMA channels
+	} Pulse_Capture_t;
+
+	typedef struct {
+		uint32_t periods;               // Complete periods in the batch
+		uint32_t period;                // Mean, in counter ticks
+		uint32_t min_period;
+		uint32_t max_period;
+		uint32_t frequency;             // mHz, from the mean period
+		uint32_t duty;                  // Mean high time in 0.01% of the period, 0 when falling edges aren't captured
+	} Pulse_Stats_t;
+
+	static bool start(Capture_t &capture, uint16_t prescaler, uint32_t auto_reload);
+	static void stop(Capture_t &capture);
+
+	static bool start_pulses(Pulse_Capture_t &capture, uint16_t prescaler, uint8_t filter);
+	static void stop_pulses(Pulse_Capture_t &capture);
+	static Pulse_Stats_t measure(Pulse_Capture_t &capture, uint32_t tick_frequency);
+
+	static uint32_t compress(const uint16_t *samples, uint32_t length, Run_t *runs);
+	static uint32_t expand(const Run_t *runs, uint32_t num_runs, uint16_t *samples);
+
+private:
+	static void dma_callback(uint_fast8_t channel, DMA_Class::Event event, void *context);
+	static bool pair_falling_edge(Pulse_Capture_t &capture, uint16_t falling_end, uint32_t rising, uint32_t period,
+	                              uint32_t &high);
+};
+
+
+#endif //STM32G4_MODULE_LIBRARY_CAPTURE_HH
@@ -0,0 +1,297 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_capture.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+#include "../capture.hh"
+#include "../../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+namespace {
+	void record_block(const uint16_t *const samples, const uint16_t length, void *const context)
+	{
+		auto &blocks = *static_cast<std::vector<std::vector<uint16_t>> *>(context);
+		blocks.emplace_back(samples, samples + length);
+	}
+}
+
+
+TEST_CASE("Capture functions", "[Capture][PERIPHERAL]")
+{
+	using Capture = Chip::Capture;
+	const uint16_t REQUEST = static_cast<uint16_t>(DMA_Class::Request::TIM7_UP);
+
+
+	SECTION("Capture Double-Buffered Sampling") {
+		std::vector<std::vector<uint16_t>> blocks;
+		uint16_t ring[8] = {};
+		Capture::Capture_t capture = {
+			.port=GPIOD, .timer=TIM7, .dma_channel=9, .buffer=ring, .length=8,
+			.callback=record_block, .context=&blocks, .started=false
+		};
+		const uint8_t HELD = Chip::Clock::references(Chip::Clock::Gate::TIM7EN);
+		const uint32_t SAVED_IDR = GPIOD->IDR;
+		REQUIRE(Capture::start(capture, 0, 16));
+		REQUIRE(Capture::start(capture, 0, 16));
+		REQUIRE((TIM7->DIER & (1 << 8)) != 0);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM7EN) == HELD + 1);
+
+		// Synthetic bus traffic, every half of the ring must reach the callback in order
+		uint16_t samples[24];
+		for (uint16_t i = 0; i < 24; i++) {
+			samples[i] = static_cast<uint16_t>(i * 0x0101);
+		}
+		feed_GPIO_IDR(GPIOD, samples, 24, REQUEST);
+
+		REQUIRE(blocks.size() == 6);
+		for (uint16_t i = 0; i < 24; i++) {
+			REQUIRE(blocks[i / 4][i % 4] == samples[i]);
+		}
+
+		// No more callbacks once stopped
+		Capture::stop(capture);
+		feed_GPIO_IDR(GPIOD, samples, 8, REQUEST);
+		REQUIRE(blocks.size() == 6);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM7EN) == HELD);
+
+		// The last sample fed stays on the mock's inputs, where a GPIO test would read it
+		GPIOD->IDR = SAVED_IDR;
+	}
+
+
+	SECTION("Capture Ring Validation") {
+		// The ring is reported in halves to a callback, so an empty or odd ring & a missing callback are refused
+		uint16_t ring[8] = {};
+		Capture::Capture_t capture = {
+			.port=GPIOD, .timer=TIM7, .dma_channel=9, .buffer=ring, .length=7,
+			.callback=record_block, .context=nullptr, .started=false
+		};
+		const uint8_t HELD = Chip::Clock::references(Chip::Clock::Gate::TIM7EN);
+		REQUIRE(!Capture::start(capture, 0, 16));
+		capture.length = 0;
+		REQUIRE(!Capture::start(capture, 0, 16));
+		capture.length = 8;
+		capture.callback = nullptr;
+		REQUIRE(!Capture::start(capture, 0, 16));
+		REQUIRE(!capture.started);
+		REQUIRE(!DMA_Class::allocated(9));
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM7EN) == HELD);
+	}
+
+
+	SECTION("Capture Run-Length Compression") {
+		const uint16_t SAMPLES[] = {0, 0, 0, 0, 0, 1, 3, 3, 0, 0, 0, 0, 0, 0, 0, 0};
+		const uint32_t LENGTH = sizeof(SAMPLES) / sizeof(SAMPLES[0]);
+		Capture::Run_t runs[LENGTH];
+
+		const uint32_t num_runs = Capture::compress(SAMPLES, LENGTH, runs);
+		REQUIRE(num_runs == 4);
+		REQUIRE(runs[0].value == 0);
+		REQUIRE(runs[0].count == 5);
+		REQUIRE(runs[3].count == 8);
+
+		uint16_t expanded[LENGTH];
+		REQUIRE(Capture::expand(runs, num_runs, expanded) == LENGTH);
+		for (uint32_t i = 0; i < LENGTH; i++) {
+			REQUIRE(expanded[i] == SAMPLES[i]);
+		}
+	}
+
+
+	SECTION("Capture Run-Length Saturation") {
+		// Runs longer than a uint16_t can count are split rather than wrapped
+		std::vector<uint16_t> idle(UINT16_MAX + 10, 0x00FF);
+		std::vector<Capture::Run_t> runs(idle.size());
+
+		REQUIRE(Capture::compress(idle.data(), static_cast<uint32_t>(idle.size()), runs.data()) == 2);
+		REQUIRE(runs[0].count == UINT16_MAX);
+		REQUIRE(runs[1].count == 10);
+	}
+}
+
+
+
+namespace {
+	// Edges of a pulse train as a free running counter sees them, wrapped to the counter's width
+	void pulse_train(const uint64_t start, const uint32_t period, const uint32_t high, const uint32_t counter_max,
+	                 const uint32_t count, std::vector<uint32_t> &rising, std::vector<uint32_t> &falling)
+	{
+		for (uint32_t i = 0; i < count; i++) {
+			rising.push_back(static_cast<uint32_t>((start + static_cast<uint64_t>(i) * period) & counter_max));
+			falling.push_back(static_cast<uint32_t>((start + static_cast<uint64_t>(i) * period + high) & counter_max));
+		}
+	}
+
+	// Feeds the edges in the order they happen, rising then falling
+	void feed_edges(TIM_TypeDef *const timer, const std::vector<uint32_t> &rising, const std::vector<uint32_t> &falling,
+	                const uint16_t rising_request, const uint16_t falling_request)
+	{
+		for (size_t i = 0; i < rising.size(); i++) {
+			feed_TIM_capture(timer, 1, &rising[i], 1, rising_request);
+			feed_TIM_capture(timer, 2, &falling[i], 1, falling_request);
+		}
+	}
+}
+
+
+TEST_CASE("Capture pulse measurement", "[Capture][PERIPHERAL]")
+{
+	using Capture = Chip::Capture;
+	uint32_t rising[64] = {};
+	uint32_t falling[64] = {};
+
+
+	SECTION("Capture 16-Bit Pulse Train") {
+		// 1 MHz at 170 MHz, 25% duty, starting just before the counter wraps
+		Capture::Pulse_Capture_t capture = {};
+		capture.timer = TIM3;
+		capture.rising_dma_channel = 10;
+		capture.falling_dma_channel = 11;
+		capture.rising = rising;
+		capture.falling = falling;
+		capture.length = 64;
+		const uint8_t HELD = Chip::Clock::references(Chip::Clock::Gate::TIM3EN);
+		REQUIRE(Capture::start_pulses(capture, 0, 0));
+		REQUIRE(TIM3->ARR == 0xFFFF);
+		REQUIRE((TIM3->DIER & (0b11 << 9)) == (0b11 << 9));
+		REQUIRE((TIM3->CCMR1 & 0x0303) == 0x0201);
+		REQUIRE((TIM3->CCER & 0xFF) == 0x31);
+
+		std::vector<uint32_t> rising_edges;
+		std::vector<uint32_t> falling_edges;
+		pulse_train(0xFF00, 170, 42, 0xFFFF, 40, rising_edges, falling_edges);
+		feed_edges(TIM3, rising_edges, falling_edges, static_cast<uint16_t>(DMA_Class::Request::TIM3_CH1),
+		           static_cast<uint16_t>(DMA_Class::Request::TIM3_CH2));
+
+		const Capture::Pulse_Stats_t STATS = Capture::measure(capture, 170000000);
+		REQUIRE(STATS.periods == 39);
+		REQUIRE(STATS.period == 170);
+		REQUIRE(STATS.min_period == 170);
+		REQUIRE(STATS.max_period == 170);
+		REQUIRE(STATS.frequency == 1000000000);
+		REQUIRE(STATS.duty == 2470);
+
+		// The next batch carries on from the last edge & goes round the ring
+		rising_edges.clear();
+		falling_edges.clear();
+		pulse_train(0xFF00 + 40 * 170, 340, 170, 0xFFFF, 50, rising_edges, falling_edges);
+		feed_edges(TIM3, rising_edges, falling_edges, static_cast<uint16_t>(DMA_Class::Request::TIM3_CH1),
+		           static_cast<uint16_t>(DMA_Class::Request::TIM3_CH2));
+		const Capture::Pulse_Stats_t NEXT = Capture::measure(capture, 170000000);
+		REQUIRE(NEXT.periods == 50);
+		REQUIRE(NEXT.min_period == 170);
+		REQUIRE(NEXT.max_period == 340);
+		REQUIRE(NEXT.duty > 4900);
+
+		// Nothing new, nothing measured
+		REQUIRE(Capture::measure(capture, 170000000).periods == 0);
+		Capture::stop_pulses(capture);
+		REQUIRE((TIM3->DIER & (0b11 << 9)) == 0);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM3EN) == HELD);
+
+		// A restart keeps one reference, & a timer that stopped by itself still gives it back
+		REQUIRE(Capture::start_pulses(capture, 0, 0));
+		REQUIRE(Capture::start_pulses(capture, 0, 0));
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM3EN) == HELD + 1);
+		Chip::HAL::clear_register(&TIM3->CR1, 1 << 0);
+		Capture::stop_pulses(capture);
+		Capture::stop_pulses(capture);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM3EN) == HELD);
+	}
+
+
+	SECTION("Capture 32-Bit Pulse Train") {
+		// TIM2 measures slow tachometer pulses without a prescaler, across its 32-bit wrap
+		Capture::Pulse_Capture_t capture = {};
+		capture.timer = TIM2;
+		capture.rising_dma_channel = 12;
+		capture.rising = rising;
+		capture.falling = nullptr;
+		capture.length = 64;
+		REQUIRE(Capture::start_pulses(capture, 0, 4));
+		REQUIRE(TIM2->ARR == UINT32_MAX);
+		REQUIRE((TIM2->DIER & (0b11 << 9)) == (1 << 9));
+
+		std::vector<uint32_t> rising_edges;
+		std::vector<uint32_t> falling_edges;
+		pulse_train(0xFFF00000ull, 1700000, 0, UINT32_MAX, 20, rising_edges, falling_edges);
+		feed_TIM_capture(TIM2, 1, rising_edges.data(), 20, static_cast<uint16_t>(DMA_Class::Request::TIM2_CH1));
+
+		const Capture::Pulse_Stats_t STATS = Capture::measure(capture, 170000000);
+		REQUIRE(STATS.periods == 19);
+		REQUIRE(STATS.period == 1700000);
+		REQUIRE(STATS.frequency == 100000);
+		REQUIRE(STATS.duty == 0);
+		Capture::stop_pulses(capture);
+	}
+
+
+	SECTION("Capture Single Channel Timers") {
+		// TIM16 has no channel 2 & TIM15's has no request, so only the rising edges can be captured there
+		Capture::Pulse_Capture_t capture = {};
+		capture.timer = TIM16;
+		capture.rising_dma_channel = 12;
+		capture.falling_dma_channel = 13;
+		capture.rising = rising;
+		capture.falling = falling;
+		capture.length = 64;
+		const uint8_t HELD = Chip::Clock::references(Chip::Clock::Gate::TIM16EN);
+		REQUIRE(!Capture::start_pulses(capture, 0, 0));
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM16EN) == HELD);
+		capture.timer = TIM15;
+		REQUIRE(!Capture::start_pulses(capture, 0, 0));
+		capture.timer = TIM6;
+		capture.falling = nullptr;
+		REQUIRE(!Capture::start_pulses(capture, 0, 0));
+
+		capture.timer = TIM16;
+		REQUIRE(Capture::start_pulses(capture, 0, 0));
+		REQUIRE((TIM16->DIER & (0b11 << 9)) == (1 << 9));
+		std::vector<uint32_t> rising_edges;
+		std::vector<uint32_t> falling_edges;
+		pulse_train(100, 500, 0, 0xFFFF, 6, rising_edges, falling_edges);
+		feed_TIM_capture(TIM16, 1, rising_edges.data(), 6, static_cast<uint16_t>(DMA_Class::Request::TIM16_CH1));
+		const Capture::Pulse_Stats_t STATS = Capture::measure(capture, 1000000);
+		REQUIRE(STATS.periods == 5);
+		REQUIRE(STATS.period == 500);
+		REQUIRE(STATS.duty == 0);
+		Capture::stop_pulses(capture);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM16EN) == HELD);
+	}
+
+
+	SECTION("Capture Falling Edge Before The First Period") {
+		// The input was high when capture started, its first falling edge belongs to no period
+		Capture::Pulse_Capture_t capture = {};
+		capture.timer = TIM4;
+		capture.rising_dma_channel = 13;
+		capture.falling_dma_channel = 14;
+		capture.rising = rising;
+		capture.falling = falling;
+		capture.length = 64;
+		REQUIRE(Capture::start_pulses(capture, 0, 0));
+
+		const uint32_t EARLY = 900;
+		feed_TIM_capture(TIM4, 2, &EARLY, 1, static_cast<uint16_t>(DMA_Class::Request::TIM4_CH2));
+		std::vector<uint32_t> rising_edges;
+		std::vector<uint32_t> falling_edges;
+		pulse_train(1000, 1000, 750, 0xFFFF, 5, rising_edges, falling_edges);
+		feed_edges(TIM4, rising_edges, falling_edges, static_cast<uint16_t>(DMA_Class::Request::TIM4_CH1),
+		           static_cast<uint16_t>(DMA_Class::Request::TIM4_CH2));
+
+		const Capture::Pulse_Stats_t STATS = Capture::measure(capture, 1000000);
+		REQUIRE(STATS.periods == 4);
+		REQUIRE(STATS.frequency == 1000000);
+		REQUIRE(STATS.duty == 7500);
+		Capture::stop_pulses(capture);
+	}
+}
@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+// File Name    : chain.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "chain.hh"
+#include "../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+/*
+ * Chain functions
+ */
+// Returns false when the chain is already running, has nothing in it or something else holds the DMA channel
+bool Chain_Class::start(Chain_t &chain)
+{
+	if (chain.busy || chain.num_segments == 0) {
+		return false;
+	}
+	if (!chain.reserved) {
+		if (!DMA_Class::reserve(chain.dma_channel)) {
+			return false;
+		}
+		chain.reserved = true;
+	}
+
+	DMA_Class::Transfer_Config_t config = chain.config;
+	config.mode = DMA_Class::Transfer_Mode::NORMAL;
+	DMA_Class::stop(chain.dma_channel);
+	DMA_Class::set_callback(chain.dma_channel, dma_callback, &chain, false);
+	DMA_Class::configure(chain.dma_channel, config);
+
+	chain.segment = 0;
+	chain.busy = true;
+	chain.reload_cycles = 0;
+	chain.max_reload_cycles = 0;
+	DMA_Class::start(chain.dma_channel, chain.peripheral, chain.segments[0].memory, chain.segments[0].count);
+	return true;
+}
+
+
+// Stops in the middle of a segment without the callback & frees the channel. A chain that finished keeps the
+// channel & its clocks until then, so it can be started again straight away
+void Chain_Class::stop(Chain_t &chain)
+{
+	chain.busy = false;
+	if (chain.reserved) {
+		chain.reserved = false;
+		DMA_Class::free(chain.dma_channel);
+	}
+}
+
+
+bool Chain_Class::busy(const Chain_t &chain)
+{
+	return chain.busy;
+}
+
+
+uint32_t Chain_Class::remaining(const Chain_t &chain)
+{
+	if (!chain.busy) {
+		return 0;
+	}
+	uint32_t items = DMA_Class::remaining(chain.dma_channel);
+	for (uint16_t i = static_cast<uint16_t>(chain.segment + 1); i < chain.num_segments; i++) {
+		items += chain.segments[i].count;
+	}
+	return items;
+}
+
+
+
+/*
+ * Chain interrupt functions
+ */
+// Doc: RM0440-12.4.6 | Only CMAR & CNDTR change between segments, they can be written as soon as EN is cleared.
+// The channel is idle from its last item to the write that enables it again, which is what reload_cycles counts
+// after the 12 cycle interrupt entry.
+void Chain_Class::dma_callback(const uint_fast8_t channel, const DMA_Class::Event event, void *const context)
+{
+	const uint32_t ENTERED = Chip::HAL::read_cycle_counter();
+	Chain_t &chain = *static_cast<Chain_t *>(context);
+	if (event == DMA_Class::Event::TRANSFER_ERROR) {
+		DMA_Class::stop(channel);
+		finish(chain, false);
+		return;
+	}
+	if (event != DMA_Class::Event::TRANSFER_COMPLETE || !chain.busy) {
+		return;
+	}
+
+	uint16_t next = static_cast<uint16_t>(chain.segment + 1);
+	if (next == chain.num_segments) {
+		if (!chain.repeat) {
+			finish(chain, true);
+			return;
+		}
+		next = 0;
+	}
+	chain.segment = next;
+
+	DMA_Channel_TypeDef *const CHANNEL = DMA_Class::channel_registers(channel);
+	const Segment_t &SEGMENT = chain.segments[next];
+	Chip::HAL::clear_register(&CHANNEL->CCR, 1 << 0);
+	Chip::HAL::write_address(&CHANNEL->CMAR, SEGMENT.memory);
+	Chip::HAL::write_register(&CHANNEL->CNDTR, SEGMENT.count);
+	Chip::HAL::set_register(&CHANNEL->CCR, 1 << 0);
+
+	chain.reload_cycles = Chip::HAL::read_cycle_counter() - ENTERED;
+	chain.max_reload_cycles = (chain.reload_cycles > chain.max_reload_cycles) ? chain.reload_cycles
+	                                                                          : chain.max_reload_cycles;
+}
+
+
+void Chain_Class::finish(Chain_t &chain, const bool completed)
+{
+	chain.busy = false;
+	if (chain.callback != nullptr) {
+		chain.callback(completed, chain.context);
+	}
+}
@@ -0,0 +1,68 @@
+//------------------------------------------------------------------------------
+// File Name    : chain.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_CHAIN_HH
+#define STM32G4_MODULE_LIBRARY_CHAIN_HH
+
+#include <cstdint>
+#include "../dma/dma.hh"
+
+#ifdef UNIT_TEST
+#include "../../chip/stm32g491/stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+// Scatter-gather over a list of memory segments & one peripheral register. The G4 DMA has no descriptor fetch,
+// so the transfer complete interrupt points the channel at the next segment, e.g. a header, payload & CRC sent
+// from where they already are or a received frame split into them. Nothing is copied.
+class Chain_Class {
+public:
+	typedef struct {
+		volatile void *memory;
+		uint16_t count;             // Items, at least 1
+	} Segment_t;
+
+	typedef void (*Done_t)(bool completed, void *context);
+
+	typedef struct {
+		uint8_t dma_channel;
+		DMA_Class::Transfer_Config_t config;        // The mode is always NORMAL, the chain does the reloading
+		volatile void *peripheral;
+		const Segment_t *segments;
+		uint16_t num_segments;
+		bool repeat;                // Back to the first segment after the last one, until stop()
+		Done_t callback;
+		void *context;
+
+		volatile uint16_t segment;  // Segment the DMA is on
+		volatile bool busy;
+		bool reserved;              // Set while the chain holds its DMA channel, from start() until stop()
+		uint32_t reload_cycles;     // Core cycles from the interrupt handler to the next segment running
+		uint32_t max_reload_cycles;
+	} Chain_t;
+
+	static bool start(Chain_t &chain);
+	static void stop(Chain_t &chain);
+	static bool busy(const Chain_t &chain);
+
+	// Items the chain has still to move, counting the segment in progress
+	static uint32_t remaining(const Chain_t &chain);
+
+private:
+	static void dma_callback(uint_fast8_t channel, DMA_Class::Event event, void *context);
+	static void finish(Chain_t &chain, bool completed);
+};
+
+
+#endif //STM32G4_MODULE_LIBRARY_CHAIN_HH
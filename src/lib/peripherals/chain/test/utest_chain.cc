@@ -0,0 +1,151 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_chain.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "../chain.hh"
+#include "../../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+namespace {
+	constexpr DMA_Class::Transfer_Config_t byte_config(const DMA_Class::Request request,
+	                                                   const DMA_Class::Direction direction)
+	{
+		return {.request=request, .direction=direction, .peripheral_width=DMA_Class::Data_Width::BYTE,
+		        .memory_width=DMA_Class::Data_Width::BYTE, .peripheral_increment=false, .memory_increment=true,
+		        .mode=DMA_Class::Transfer_Mode::NORMAL, .priority=DMA_Class::Priority::HIGH};
+	}
+}
+
+
+TEST_CASE("Chain functions", "[Chain][PERIPHERAL]")
+{
+	using Chain = Chip::Chain;
+	const uint_fast8_t CHANNEL = 2;
+	Mock_DMA_Done_t done = {0, false};
+
+
+	SECTION("Chain Gather") {
+		// A packet sent from three places without being assembled first
+		uint8_t header[3] = {0xAA, 0x03, 0x10};
+		uint8_t payload[5] = {1, 2, 3, 4, 5};
+		uint8_t crc[2] = {0x5C, 0xC5};
+		const Chain::Segment_t SEGMENTS[] = {{header, 3}, {payload, 5}, {crc, 2}};
+		uint8_t data_register = 0;
+		const uint16_t REQUEST = static_cast<uint16_t>(DMA_Class::Request::USART1_TX);
+
+		Chain::Chain_t chain = {};
+		chain.dma_channel = static_cast<uint8_t>(CHANNEL);
+		chain.config = byte_config(DMA_Class::Request::USART1_TX, DMA_Class::Direction::MEMORY_TO_PERIPHERAL);
+		chain.peripheral = &data_register;
+		chain.segments = SEGMENTS;
+		chain.num_segments = 3;
+		chain.callback = record_DMA_done;
+		chain.context = &done;
+		REQUIRE(Chain::start(chain));
+		REQUIRE(!Chain::start(chain));
+		REQUIRE(Chain::remaining(chain) == 10);
+
+		const uint8_t EXPECTED[] = {0xAA, 0x03, 0x10, 1, 2, 3, 4, 5, 0x5C, 0xC5};
+		for (uint_fast8_t i = 0; i < sizeof(EXPECTED); i++) {
+			REQUIRE(Chain::busy(chain));
+			trigger_DMA_request(REQUEST);
+			REQUIRE(data_register == EXPECTED[i]);
+			REQUIRE(Chain::remaining(chain) == (Chain::busy(chain) ? sizeof(EXPECTED) - 1 - i : 0));
+		}
+		REQUIRE(!Chain::busy(chain));
+		REQUIRE(done.count == 1);
+		REQUIRE(done.completed);
+		REQUIRE((DMA_Class::channel_registers(CHANNEL)->CCR & (1 << 5)) == 0);
+
+		// Nothing more goes out once the chain is done
+		trigger_DMA_request(REQUEST);
+		REQUIRE(data_register == 0xC5);
+
+		// The channel is the chain's until it is stopped
+		Chain::Chain_t other = chain;
+		other.reserved = false;
+		REQUIRE(!Chain::start(other));
+		REQUIRE(DMA_Class::allocated(CHANNEL));
+		Chain::stop(chain);
+		REQUIRE(!DMA_Class::allocated(CHANNEL));
+	}
+
+
+	SECTION("Chain Scatter") {
+		// A frame received straight into the buffers its parts belong in, over & over
+		uint8_t header[2] = {};
+		uint8_t body[4] = {};
+		const Chain::Segment_t SEGMENTS[] = {{header, 2}, {body, 4}};
+		uint8_t data_register = 0;
+
+		Chain::Chain_t chain = {};
+		chain.dma_channel = static_cast<uint8_t>(CHANNEL);
+		chain.config = byte_config(DMA_Class::Request::SPI2_RX, DMA_Class::Direction::PERIPHERAL_TO_MEMORY);
+		chain.peripheral = &data_register;
+		chain.segments = SEGMENTS;
+		chain.num_segments = 2;
+		chain.repeat = true;
+		REQUIRE(Chain::start(chain));
+
+		for (uint8_t i = 0; i < 9; i++) {
+			data_register = static_cast<uint8_t>(10 + i);
+			trigger_DMA_request(static_cast<uint16_t>(DMA_Class::Request::SPI2_RX));
+		}
+		REQUIRE(header[0] == 16);
+		REQUIRE(header[1] == 17);
+		REQUIRE(body[0] == 18);
+		REQUIRE(body[1] == 13);
+		REQUIRE(body[3] == 15);
+		REQUIRE(chain.segment == 1);
+		REQUIRE(Chain::busy(chain));
+
+		Chain::stop(chain);
+		REQUIRE(!Chain::busy(chain));
+		REQUIRE(Chain::remaining(chain) == 0);
+	}
+}
+
+
+TEST_CASE("Chain benchmark", "[Chain][PERIPHERAL][.benchmark]")
+{
+	// The same 64 bytes as one segment & as 64, the difference over 63 is the cost of each segment reload
+	using Chain = Chip::Chain;
+	const uint_fast8_t CHANNEL = 2;
+	static uint8_t buffer[64];
+	static Chain::Segment_t whole[1] = {{buffer, 64}};
+	static Chain::Segment_t bytes[64];
+	for (uint_fast8_t i = 0; i < 64; i++) {
+		bytes[i] = {&buffer[i], 1};
+	}
+	uint8_t data_register = 0;
+
+	Chain::Chain_t chain = {};
+	chain.dma_channel = static_cast<uint8_t>(CHANNEL);
+	chain.config = byte_config(DMA_Class::Request::USART2_TX, DMA_Class::Direction::MEMORY_TO_PERIPHERAL);
+	chain.peripheral = &data_register;
+
+	auto send = [&chain](const Chain::Segment_t *segments, const uint16_t num_segments) {
+		chain.segments = segments;
+		chain.num_segments = num_segments;
+		(void) Chain::start(chain);
+		while (Chain::busy(chain)) {
+			trigger_DMA_request(static_cast<uint16_t>(DMA_Class::Request::USART2_TX));
+		}
+		return chain.max_reload_cycles;
+	};
+
+	BENCHMARK("One segment, 64 bytes") { return send(whole, 1); };
+	BENCHMARK("64 segments, 64 bytes") { return send(bytes, 64); };
+
+	Chain::stop(chain);
+}
@@ -0,0 +1,196 @@
+//------------------------------------------------------------------------------
+// File Name    : copy.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <cstring>
+#include "copy.hh"
+#include "../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+/*
+ * Copy setup functions
+ */
+// Returns false when there is no DMA channel left
+bool Copy_Class::init(Copy_t &copy, const DMA_Class::Priority priority)
+{
+	copy = {};
+	copy.dma_channel = static_cast<uint8_t>(DMA_Class::allocate(priority));
+	if (copy.dma_channel == DMA_Class::NO_CHANNEL) {
+		return false;
+	}
+	copy.cpu_threshold = DEFAULT_CPU_THRESHOLD;
+	copy.priority = priority;
+	DMA_Class::set_callback(copy.dma_channel, dma_callback, &copy, false);
+	return true;
+}
+
+
+// A job still running is stopped without its callback
+void Copy_Class::deinit(Copy_t &copy)
+{
+	DMA_Class::free(copy.dma_channel);
+	copy.busy = false;
+}
+
+
+
+/*
+ * Copy job functions
+ */
+// A job under cpu_threshold is done before this returns & its callback is run from here
+bool Copy_Class::async_copy(Copy_t &copy, void *const destination, const void *const source, const size_t bytes,
+                            const Done_t callback, void *const context)
+{
+	if (copy.busy) {
+		return false;
+	}
+	copy.callback = callback;
+	copy.context = context;
+	if (bytes < copy.cpu_threshold) {
+		memcpy(destination, source, bytes);
+		finish(copy, true);
+		return true;
+	}
+	start(copy, reinterpret_cast<uintptr_t>(destination), reinterpret_cast<uintptr_t>(source), bytes, false);
+	return true;
+}
+
+
+bool Copy_Class::async_fill(Copy_t &copy, void *const destination, const uint8_t value, const size_t bytes,
+                            const Done_t callback, void *const context)
+{
+	if (copy.busy) {
+		return false;
+	}
+	copy.callback = callback;
+	copy.context = context;
+	if (bytes < copy.cpu_threshold) {
+		memset(destination, value, bytes);
+		finish(copy, true);
+		return true;
+	}
+	copy.fill = value * 0x01010101u;
+	start(copy, reinterpret_cast<uintptr_t>(destination), reinterpret_cast<uintptr_t>(&copy.fill), bytes, true);
+	return true;
+}
+
+
+bool Copy_Class::busy(const Copy_t &copy)
+{
+	return copy.busy;
+}
+
+
+// Sleeps until the job is done rather than spin on busy, which would share the bus with the DMA.
+// Returns false when it stopped on a transfer error
+bool Copy_Class::wait(const Copy_t &copy)
+{
+	while (copy.busy) {
+		// Doc: PM0214-3.11.11 | The DMA interrupt still wakes the core with PRIMASK set, & runs once it's cleared,
+		// so it can't slip in between the check & the WFI
+		const uint32_t PRIMASK = Chip::HAL::enter_critical();
+		if (copy.busy) {
+			Chip::HAL::wait_for_interrupt();
+		}
+		Chip::HAL::exit_critical(PRIMASK);
+	}
+	return !copy.failed;
+}
+
+
+
+/*
+ * Copy transfer functions
+ */
+// Whatever doesn't fill a whole item at the end is copied on the CPU, so the DMA only sees whole items
+void Copy_Class::start(Copy_t &copy, const uintptr_t destination, const uintptr_t source, const size_t bytes,
+                       const bool is_fill)
+{
+	const DMA_Class::Data_Width WIDTH = item_width(destination, is_fill ? 0 : source, 0);
+	const uint32_t ITEM_SIZE = 1u << static_cast<uint32_t>(WIDTH);
+	const size_t TAIL = bytes % ITEM_SIZE;
+	const size_t BULK = bytes - TAIL;
+	if (is_fill) {
+		memset(reinterpret_cast<void *>(destination + BULK), static_cast<uint8_t>(copy.fill), TAIL);
+	} else {
+		memcpy(reinterpret_cast<void *>(destination + BULK), reinterpret_cast<const void *>(source + BULK), TAIL);
+	}
+
+	copy.destination = destination;
+	copy.source = source;
+	copy.remaining = static_cast<uint32_t>(BULK / ITEM_SIZE);
+	copy.width = WIDTH;
+	copy.is_fill = is_fill;
+	copy.failed = false;
+	if (copy.remaining == 0) {
+		finish(copy, true);
+		return;
+	}
+	copy.busy = true;
+
+	// Doc: RM0440-12.4.5 | MEM2MEM runs as fast as the bus allows, CPAR is the destination & CMAR the source.
+	// A fill reads the same word over & over
+	const DMA_Class::Transfer_Config_t CONFIG = {
+		.request=DMA_Class::Request::MEM2MEM,
+		.direction=DMA_Class::Direction::MEMORY_TO_PERIPHERAL,
+		.peripheral_width=WIDTH,
+		.memory_width=WIDTH,
+		.peripheral_increment=true,
+		.memory_increment=!is_fill,
+		.mode=DMA_Class::Transfer_Mode::NORMAL,
+		.priority=copy.priority
+	};
+	DMA_Class::stop(copy.dma_channel);
+	DMA_Class::configure(copy.dma_channel, CONFIG);
+	start_transfer(copy);
+}
+
+
+void Copy_Class::start_transfer(Copy_t &copy)
+{
+	const uint32_t ITEMS = (copy.remaining > MAX_ITEMS) ? MAX_ITEMS : copy.remaining;
+	const uintptr_t DESTINATION = copy.destination;
+	const uintptr_t SOURCE = copy.source;
+	const uint32_t BYTES = ITEMS << static_cast<uint32_t>(copy.width);
+
+	copy.remaining -= ITEMS;
+	copy.destination += BYTES;
+	copy.source += copy.is_fill ? 0 : BYTES;
+	DMA_Class::start(copy.dma_channel, reinterpret_cast<volatile void *>(DESTINATION),
+	                 reinterpret_cast<volatile void *>(SOURCE), static_cast<uint16_t>(ITEMS));
+}
+
+
+void Copy_Class::finish(Copy_t &copy, const bool completed)
+{
+	copy.failed = !completed;
+	copy.busy = false;
+	if (copy.callback != nullptr) {
+		copy.callback(completed, copy.context);
+	}
+}
+
+
+// Doc: RM0440-12.4.6 | The next part of a long job is started straight from the transfer complete interrupt
+void Copy_Class::dma_callback(const uint_fast8_t channel, const DMA_Class::Event event, void *const context)
+{
+	Copy_t &copy = *static_cast<Copy_t *>(context);
+	if (event == DMA_Class::Event::TRANSFER_ERROR) {
+		DMA_Class::stop(channel);
+		finish(copy, false);
+	} else if (event == DMA_Class::Event::TRANSFER_COMPLETE && copy.busy) {
+		if (copy.remaining != 0) {
+			start_transfer(copy);
+		} else {
+			finish(copy, true);
+		}
+	}
+}
@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+// File Name    : copy.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_COPY_HH
+#define STM32G4_MODULE_LIBRARY_COPY_HH
+
+#include <cstddef>
+#include <cstdint>
+#include "../dma/dma.hh"
+
+#ifdef UNIT_TEST
+#include "../../chip/stm32g491/stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+// Memory to memory copies & fills on a DMA channel, so the CPU carries on while a large buffer moves.
+// A job is started with async_copy() or async_fill() & is done when busy() goes false, its callback runs from the
+// DMA interrupt. Jobs smaller than cpu_threshold aren't worth setting a channel up for & are done on the CPU.
+class Copy_Class {
+public:
+	// Doc: RM0440-12.6.4 | CNDTR is 16 bits, longer jobs are split into transfers of at most this many items
+	static constexpr uint32_t MAX_ITEMS = 0xFFFF;
+
+	// Bytes below which jobs go to memcpy(). A starting point rather than a measured break-even, which depends on
+	// the clocks, flash wait states & bus load, so set cpu_threshold from timings on the board
+	static constexpr uint32_t DEFAULT_CPU_THRESHOLD = 128;
+
+	typedef void (*Done_t)(bool completed, void *context);
+
+	typedef struct {
+		uint8_t dma_channel;        // Allocated by init()
+		uint32_t cpu_threshold;     // Bytes
+		DMA_Class::Priority priority;
+		volatile bool busy;
+		volatile bool failed;       // The last job stopped on a transfer error
+		Done_t callback;
+		void *context;
+
+		// The job in progress
+		uintptr_t destination;
+		uintptr_t source;
+		uint32_t remaining;         // Items still to be transferred after the current transfer
+		uint32_t fill;              // Fill byte repeated across the item width, the source of a fill
+		DMA_Class::Data_Width width;
+		bool is_fill;
+	} Copy_t;
+
+	// Widest item every address & the length are aligned to. Doc: RM0440-12.4.4 | The same width on both sides
+	// is never packed or split
+	static constexpr DMA_Class::Data_Width item_width(const uintptr_t destination, const uintptr_t source,
+	                                                  const size_t bytes)
+	{
+		const uintptr_t ALIGNMENT = destination | source | static_cast<uintptr_t>(bytes);
+		if ((ALIGNMENT & 0b11) == 0) {
+			return DMA_Class::Data_Width::WORD;
+		}
+		if ((ALIGNMENT & 0b1) == 0) {
+			return DMA_Class::Data_Width::HALF_WORD;
+		}
+		return DMA_Class::Data_Width::BYTE;
+	}
+
+	static bool init(Copy_t &copy, DMA_Class::Priority priority);
+	static void deinit(Copy_t &copy);
+
+	// Return false when the previous job is still running, the buffers must stay put until the job is done
+	static bool async_copy(Copy_t &copy, void *destination, const void *source, size_t bytes, Done_t callback,
+	                       void *context);
+	static bool async_fill(Copy_t &copy, void *destination, uint8_t value, size_t bytes, Done_t callback,
+	                       void *context);
+
+	static bool busy(const Copy_t &copy);
+	static bool wait(const Copy_t &copy);
+
+private:
+	static void start(Copy_t &copy, uintptr_t destination, uintptr_t source, size_t bytes, bool is_fill);
+	static void start_transfer(Copy_t &copy);
+	static void finish(Copy_t &copy, bool completed);
+	static void dma_callback(uint_fast8_t channel, DMA_Class::Event event, void *context);
+};
+
+
+#endif //STM32G4_MODULE_LIBRARY_COPY_HH
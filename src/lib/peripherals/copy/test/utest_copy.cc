@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_copy.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstring>
+#include <vector>
+#include "../copy.hh"
+#include "../../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+TEST_CASE("Copy functions", "[Copy][PERIPHERAL]")
+{
+	using Copy = Chip::Copy;
+	using Width = DMA_Class::Data_Width;
+	Copy::Copy_t copy;
+	REQUIRE(Copy::init(copy, DMA_Class::Priority::MEDIUM));
+	REQUIRE(DMA_Class::allocated(copy.dma_channel));
+	Mock_DMA_Done_t done = {0, false};
+
+
+	SECTION("Copy Item Width") {
+		static_assert(Copy::item_width(0x20000000, 0x20001000, 64) == Width::WORD, "");
+		static_assert(Copy::item_width(0x20000002, 0x20001000, 64) == Width::HALF_WORD, "");
+		static_assert(Copy::item_width(0x20000000, 0x20001000, 6) == Width::HALF_WORD, "");
+		static_assert(Copy::item_width(0x20000000, 0x20001001, 64) == Width::BYTE, "");
+	}
+
+
+	SECTION("Copy Small Jobs") {
+		// Under the threshold the CPU copies, the job is done before async_copy() returns
+		const char SOURCE[] = "short";
+		char destination[sizeof(SOURCE)] = {};
+		REQUIRE(Copy::async_copy(copy, destination, SOURCE, sizeof(SOURCE), record_DMA_done, &done));
+		REQUIRE(!Copy::busy(copy));
+		REQUIRE(done.count == 1);
+		REQUIRE(strcmp(destination, SOURCE) == 0);
+		REQUIRE((DMA_Class::channel_registers(copy.dma_channel)->CCR & 1) == 0);
+	}
+
+
+	SECTION("Copy Word Aligned") {
+		std::vector<uint32_t> source(1024);
+		std::vector<uint32_t> destination(1024, 0);
+		for (uint32_t i = 0; i < source.size(); i++) {
+			source[i] = i * 0x9E3779B9u;
+		}
+
+		// Doc: RM0440-12.6.3 | Word items on both sides, the DMA runs in the background
+		REQUIRE(Copy::async_copy(copy, destination.data(), source.data(), 4096, record_DMA_done, &done));
+		REQUIRE(Copy::busy(copy));
+		REQUIRE(((DMA_Class::channel_registers(copy.dma_channel)->CCR >> 8) & 0b1111) == 0b1010);
+		REQUIRE(DMA_Class::channel_registers(copy.dma_channel)->CNDTR == 1024);
+		REQUIRE(!Copy::async_copy(copy, destination.data(), source.data(), 4096, record_DMA_done, &done));
+
+		REQUIRE(Copy::wait(copy));
+		REQUIRE(done.count == 1);
+		REQUIRE(done.completed);
+		REQUIRE(destination == source);
+	}
+
+
+	SECTION("Copy Long Unaligned") {
+		// Byte items from an odd address, more than one transfer's worth
+		const size_t BYTES = 2 * Copy::MAX_ITEMS + 1000;
+		std::vector<uint8_t> source(BYTES + 1);
+		std::vector<uint8_t> destination(BYTES + 1, 0);
+		for (size_t i = 0; i < source.size(); i++) {
+			source[i] = static_cast<uint8_t>(i * 7);
+		}
+		REQUIRE(Copy::async_copy(copy, destination.data(), source.data() + 1, BYTES, record_DMA_done, &done));
+		REQUIRE(((DMA_Class::channel_registers(copy.dma_channel)->CCR >> 8) & 0b1111) == 0);
+		REQUIRE(DMA_Class::channel_registers(copy.dma_channel)->CNDTR == Copy::MAX_ITEMS);
+		REQUIRE(Copy::wait(copy));
+		REQUIRE(done.count == 1);
+		REQUIRE(memcmp(destination.data(), source.data() + 1, BYTES) == 0);
+		REQUIRE(destination[BYTES] == 0);
+	}
+
+
+	SECTION("Copy Fill") {
+		// Half-word aligned with an odd length, the last byte is filled on the CPU
+		std::vector<uint8_t> destination(1000, 0);
+		REQUIRE(Copy::async_fill(copy, destination.data() + 2, 0xA5, 997, record_DMA_done, &done));
+		REQUIRE(((DMA_Class::channel_registers(copy.dma_channel)->CCR >> 7) & 1) == 0);
+		REQUIRE(destination[998] == 0xA5);
+		REQUIRE(Copy::wait(copy));
+		REQUIRE(done.count == 1);
+		REQUIRE(destination[1] == 0);
+		for (size_t i = 2; i < 999; i++) {
+			REQUIRE(destination[i] == 0xA5);
+		}
+		REQUIRE(destination[999] == 0);
+	}
+
+
+	Copy::deinit(copy);
+	REQUIRE(!DMA_Class::allocated(copy.dma_channel));
+}
+
+
+TEST_CASE("Copy benchmark", "[Copy][PERIPHERAL][.benchmark]")
+{
+	// CPU time to hand a job to the DMA against copying it outright. On the host this only compares the code paths,
+	// the break-even for cpu_threshold has to be timed on the chip. The DMA job is cancelled straight away through
+	// deinit(), which with the init() that follows is timed as well.
+	using Copy = Chip::Copy;
+	Copy::Copy_t copy;
+	REQUIRE(Copy::init(copy, DMA_Class::Priority::MEDIUM));
+	copy.cpu_threshold = 0;
+	static uint32_t source[1024];
+	static uint32_t destination[1024];
+
+	auto dma_setup = [&copy](const size_t bytes) {
+		(void) Copy::async_copy(copy, destination, source, bytes, nullptr, nullptr);
+		const uint32_t REMAINING = copy.remaining;
+		Copy::deinit(copy);
+		(void) Copy::init(copy, DMA_Class::Priority::MEDIUM);
+		copy.cpu_threshold = 0;
+		return REMAINING;
+	};
+
+	BENCHMARK("memcpy, 32 bytes") { memcpy(destination, source, 32); return destination[0]; };
+	BENCHMARK("async_copy setup, 32 bytes") { return dma_setup(32); };
+	BENCHMARK("memcpy, 128 bytes") { memcpy(destination, source, 128); return destination[0]; };
+	BENCHMARK("async_copy setup, 128 bytes") { return dma_setup(128); };
+	BENCHMARK("memcpy, 512 bytes") { memcpy(destination, source, 512); return destination[0]; };
+	BENCHMARK("async_copy setup, 512 bytes") { return dma_setup(512); };
+	BENCHMARK("memcpy, 4096 bytes") { memcpy(destination, source, 4096); return destination[0]; };
+	BENCHMARK("async_copy setup, 4096 bytes") { return dma_setup(4096); };
+
+	Copy::deinit(copy);
+}
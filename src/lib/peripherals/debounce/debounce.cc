@@ -0,0 +1,72 @@
+//------------------------------------------------------------------------------
+// File Name    : debounce.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "debounce.hh"
+#include "../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+Debounce_Class::Debounce_Class()
+{
+	reset();
+}
+
+
+void Debounce_Class::reset()
+{
+	for (uint_fast8_t i = 0; i < NUM_PORTS; i++) {
+		active_low[i] = 0;
+		count_bit0[i] = UINT16_MAX;     // Counters idle at 0b11 and count down on every differing sample
+		count_bit1[i] = UINT16_MAX;
+		port_events[i] = {.state=0, .changed=0, .pressed=0, .released=0};
+	}
+}
+
+
+void Debounce_Class::set_active_low(GPIO_TypeDef *const port, const uint16_t mask)
+{
+	active_low[GPIO_Class::port_index(port)] = mask;
+}
+
+
+void Debounce_Class::scan()
+{
+	// Doc: RM0440-9.4.5 | Snapshot every IDR back to back so all ports are sampled at (nearly) the same instant
+	uint16_t samples[NUM_PORTS];
+	for (uint_fast8_t i = 0; i < NUM_PORTS; i++) {
+		GPIO_TypeDef *const PORT = GPIO_Class::port(static_cast<GPIO_Class::Port>(i));
+		samples[i] = static_cast<uint16_t>(Chip::HAL::read_register(&PORT->IDR));
+	}
+
+	for (uint_fast8_t i = 0; i < NUM_PORTS; i++) {
+		Port_Events_t &port = port_events[i];
+		const uint16_t sample = samples[i] ^ active_low[i];
+
+		// Pins that disagree with their debounced state count down, every other pin is reloaded to 0b11
+		const uint16_t delta = sample ^ port.state;
+		count_bit0[i] = static_cast<uint16_t>(~(count_bit0[i] & delta));
+		count_bit1[i] = static_cast<uint16_t>(count_bit0[i] ^ (count_bit1[i] & delta));
+
+		// A counter that rolled over from 0b00 back to 0b11 while still disagreeing toggles its pin
+		const uint16_t toggle = delta & count_bit0[i] & count_bit1[i];
+		port.state ^= toggle;
+		port.changed = toggle;
+		port.pressed = toggle & port.state;
+		port.released = toggle & static_cast<uint16_t>(~port.state);
+	}
+}
+
+
+const Debounce_Class::Port_Events_t &Debounce_Class::events(GPIO_TypeDef *const port) const
+{
+	return port_events[GPIO_Class::port_index(port)];
+}
+
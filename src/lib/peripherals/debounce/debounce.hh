@@ -0,0 +1,57 @@
+//------------------------------------------------------------------------------
+// File Name    : debounce.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_DEBOUNCE_HH
+#define STM32G4_MODULE_LIBRARY_DEBOUNCE_HH
+
+#include <cstdint>
+
+#ifdef UNIT_TEST
+#include "../../chip/stm32g491/stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+// Debounces every pin of GPIOA-GPIOG at once using 2-bit vertical counters.
+// Each port keeps its counter bits in two 16-bit words (one bit-plane per counter bit), so a single
+// scan() updates all 16 pins of a port with a handful of bitwise operations instead of 16 per-pin counters.
+// A pin's debounced state flips after it has read the opposite level on SAMPLES_TO_TOGGLE consecutive scans.
+class Debounce_Class {
+public:
+	static constexpr uint_fast8_t NUM_PORTS = 7;            // Doc: RM0440-9.3.4 | A, B, C, D, E, F, & G
+	static constexpr uint_fast8_t SAMPLES_TO_TOGGLE = 4;    // 2-bit counter, rolls over after 4 samples
+
+	typedef struct {
+		uint16_t state;         // Debounced level of each pin, 1 = active
+		uint16_t changed;       // Pins whose debounced level flipped on the last scan
+		uint16_t pressed;       // Pins that became active on the last scan
+		uint16_t released;      // Pins that became inactive on the last scan
+	} Port_Events_t;
+
+	Debounce_Class();
+
+	void reset();
+	void set_active_low(GPIO_TypeDef *port, uint16_t mask);
+	void scan();
+
+	const Port_Events_t &events(GPIO_TypeDef *port) const;
+
+private:
+	uint16_t active_low[NUM_PORTS];
+	uint16_t count_bit0[NUM_PORTS];
+	uint16_t count_bit1[NUM_PORTS];
+	Port_Events_t port_events[NUM_PORTS];
+};
+
+
+#endif //STM32G4_MODULE_LIBRARY_DEBOUNCE_HH
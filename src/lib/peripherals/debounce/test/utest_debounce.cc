@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_debounce.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include "../debounce.hh"
+#include "../../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+namespace {
+	GPIO_TypeDef *const TEST_PORTS[Debounce_Class::NUM_PORTS] = {GPIOA, GPIOB, GPIOC, GPIOD, GPIOE, GPIOF, GPIOG};
+	const uint_fast8_t PINS_PER_PORT = 16;
+
+	// Single pin debouncer used as the reference model, one counter per pin
+	struct Reference_Pin {
+		uint16_t state = 0;
+		uint_fast8_t count = 0;
+
+		uint16_t update(uint16_t sample)
+		{
+			if (sample == state) {
+				count = 0;
+				return 0;
+			}
+			if (++count < Debounce_Class::SAMPLES_TO_TOGGLE) {
+				return 0;
+			}
+			count = 0;
+			state ^= 1;
+			return 1;
+		}
+	};
+}
+
+
+TEST_CASE("Debounce functions", "[Debounce][PERIPHERAL]")
+{
+	using Debounce = Chip::Debounce;
+	Debounce debounce;
+	uint32_t saved_idr[Debounce_Class::NUM_PORTS];
+	for (uint_fast8_t p = 0; p < Debounce_Class::NUM_PORTS; p++) {
+		saved_idr[p] = TEST_PORTS[p]->IDR;
+		TEST_PORTS[p]->IDR = 0;
+	}
+
+
+	SECTION("Debounce Exhaustive Bounce Patterns") {
+		// Every 12-sample pattern is fed to its own pin, 112 patterns run in parallel per batch
+		const uint_fast8_t PATTERN_LENGTH = 12;
+		const uint32_t NUM_PATTERNS = 1 << PATTERN_LENGTH;
+		const uint32_t PINS_PER_BATCH = Debounce_Class::NUM_PORTS * PINS_PER_PORT;
+
+		for (uint32_t first = 0; first < NUM_PATTERNS; first += PINS_PER_BATCH) {
+			debounce.reset();
+			Reference_Pin reference[PINS_PER_BATCH];
+
+			for (uint_fast8_t step = 0; step < PATTERN_LENGTH; step++) {
+				for (uint_fast8_t p = 0; p < Debounce_Class::NUM_PORTS; p++) {
+					uint32_t idr = 0;
+					for (uint_fast8_t pin = 0; pin < PINS_PER_PORT; pin++) {
+						uint32_t pattern = (first + p * PINS_PER_PORT + pin) % NUM_PATTERNS;
+						idr |= ((pattern >> step) & 1) << pin;
+					}
+					TEST_PORTS[p]->IDR = idr;
+				}
+
+				debounce.scan();
+
+				for (uint_fast8_t p = 0; p < Debounce_Class::NUM_PORTS; p++) {
+					const Debounce_Class::Port_Events_t &events = debounce.events(TEST_PORTS[p]);
+					for (uint_fast8_t pin = 0; pin < PINS_PER_PORT; pin++) {
+						Reference_Pin &ref = reference[p * PINS_PER_PORT + pin];
+						uint16_t toggled = ref.update(static_cast<uint16_t>((TEST_PORTS[p]->IDR >> pin) & 1));
+
+						REQUIRE(((events.state >> pin) & 1) == ref.state);
+						REQUIRE(((events.changed >> pin) & 1) == toggled);
+						REQUIRE(((events.pressed >> pin) & 1) == (toggled & ref.state));
+						REQUIRE(((events.released >> pin) & 1) == (toggled & (ref.state ^ 1)));
+					}
+				}
+			}
+		}
+	}
+
+
+	SECTION("Debounce Press & Release") {
+		GPIOC->IDR = 1 << 13;
+		for (uint_fast8_t i = 1; i < Debounce_Class::SAMPLES_TO_TOGGLE; i++) {
+			debounce.scan();
+			REQUIRE(debounce.events(GPIOC).changed == 0);
+		}
+		debounce.scan();
+		REQUIRE(debounce.events(GPIOC).pressed == (1 << 13));
+		REQUIRE(debounce.events(GPIOC).state == (1 << 13));
+
+		debounce.scan();
+		REQUIRE(debounce.events(GPIOC).pressed == 0);
+
+		GPIOC->IDR = 0;
+		for (uint_fast8_t i = 0; i < Debounce_Class::SAMPLES_TO_TOGGLE; i++) {
+			debounce.scan();
+		}
+		REQUIRE(debounce.events(GPIOC).released == (1 << 13));
+		REQUIRE(debounce.events(GPIOC).state == 0);
+	}
+
+
+	SECTION("Debounce Active Low Pins") {
+		// Pulled-up buttons read 1 when idle and must not report a press
+		debounce.set_active_low(GPIOB, 0x00FF);
+		GPIOB->IDR = 0x00FF;
+		for (uint_fast8_t i = 0; i < Debounce_Class::SAMPLES_TO_TOGGLE; i++) {
+			debounce.scan();
+			REQUIRE(debounce.events(GPIOB).changed == 0);
+		}
+
+		GPIOB->IDR = 0x00FE;
+		for (uint_fast8_t i = 0; i < Debounce_Class::SAMPLES_TO_TOGGLE; i++) {
+			debounce.scan();
+		}
+		REQUIRE(debounce.events(GPIOB).pressed == 0x0001);
+		REQUIRE(debounce.events(GPIOA).state == 0);
+	}
+
+	// Puts the mock inputs back, a pin left high reads as 1 in the GPIO tests
+	for (uint_fast8_t p = 0; p < Debounce_Class::NUM_PORTS; p++) {
+		TEST_PORTS[p]->IDR = saved_idr[p];
+	}
+}
+
+
+TEST_CASE("Debounce benchmark", "[Debounce][PERIPHERAL][.benchmark]")
+{
+	using GPIO = Chip::GPIO;
+	Chip::Debounce debounce;
+
+	// Per-pin counters driven through GPIO::read(), the approach the vertical counters replace
+	Reference_Pin per_pin[Debounce_Class::NUM_PORTS * PINS_PER_PORT];
+	uint32_t saved_idr[Debounce_Class::NUM_PORTS];
+	uint32_t saved_moder[Debounce_Class::NUM_PORTS];
+	for (uint_fast8_t p = 0; p < Debounce_Class::NUM_PORTS; p++) {
+		saved_idr[p] = TEST_PORTS[p]->IDR;
+		saved_moder[p] = TEST_PORTS[p]->MODER;
+		TEST_PORTS[p]->IDR = 0x5A5A;
+		for (uint16_t pin = 0; pin < PINS_PER_PORT; pin++) {
+			GPIO::set_mode({.port=TEST_PORTS[p], .number=pin}, GPIO::Pin_Mode::INPUT);
+		}
+	}
+
+	BENCHMARK("Vertical counter scan, 112 pins") {
+		debounce.scan();
+		return debounce.events(GPIOG).state;
+	};
+
+	BENCHMARK("Per-pin counter scan, 112 pins") {
+		uint16_t changed = 0;
+		for (uint_fast8_t p = 0; p < Debounce_Class::NUM_PORTS; p++) {
+			for (uint16_t pin = 0; pin < PINS_PER_PORT; pin++) {
+				changed |= per_pin[p * PINS_PER_PORT + pin].update(GPIO::read({.port=TEST_PORTS[p], .number=pin}));
+			}
+		}
+		return changed;
+	};
+
+	// Analog drops the port clock references, then the mock registers go back as found
+	for (uint_fast8_t p = 0; p < Debounce_Class::NUM_PORTS; p++) {
+		for (uint16_t pin = 0; pin < PINS_PER_PORT; pin++) {
+			GPIO::set_mode({.port=TEST_PORTS[p], .number=pin}, GPIO::Pin_Mode::ANALOG);
+		}
+		TEST_PORTS[p]->MODER = saved_moder[p];
+		TEST_PORTS[p]->IDR = saved_idr[p];
+	}
+}
@@ -0,0 +1,357 @@
+//------------------------------------------------------------------------------
+// File Name    : dma.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "dma.hh"
+#include "../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+DMA_Class::Callback_t DMA_Class::callbacks[NUM_CHANNELS] = {};
+void *DMA_Class::callback_contexts[NUM_CHANNELS] = {};
+uint32_t DMA_Class::interrupt_enables[NUM_CHANNELS] = {};
+uint16_t DMA_Class::clocked_channels = 0;
+uint16_t DMA_Class::allocated_channels = 0;
+DMA_Class::Overrun_Callback_t DMA_Class::overrun_callback = nullptr;
+void *DMA_Class::overrun_context = nullptr;
+
+
+
+/*
+ * DMA allocation functions
+ */
+// Returns NO_CHANNEL when every channel is taken. Doc: RM0440-12.4.3 | Requests of the same priority are served
+// lowest channel first, so high priorities get the lowest free channel & low priorities the highest
+uint_fast8_t DMA_Class::allocate(const Priority priority)
+{
+	const bool LOWEST_FIRST = (priority == Priority::HIGH || priority == Priority::VERY_HIGH);
+	const uint32_t primask = Chip::HAL::enter_critical();
+	for (uint_fast8_t i = 0; i < NUM_CHANNELS; i++) {
+		const uint_fast8_t CHANNEL = LOWEST_FIRST ? i : static_cast<uint_fast8_t>(NUM_CHANNELS - 1 - i);
+		if (!((allocated_channels | clocked_channels) & (1 << CHANNEL))) {
+			allocated_channels = static_cast<uint16_t>(allocated_channels | (1 << CHANNEL));
+			Chip::HAL::exit_critical(primask);
+			return CHANNEL;
+		}
+	}
+	Chip::HAL::exit_critical(primask);
+	return NO_CHANNEL;
+}
+
+
+bool DMA_Class::reserve(const uint_fast8_t channel)
+{
+	const uint32_t primask = Chip::HAL::enter_critical();
+	// A clocked channel is in use even if it was never allocated, the same as allocate() sees it
+	const bool FREE = !((allocated_channels | clocked_channels) & (1 << channel));
+	if (FREE) {
+		allocated_channels = static_cast<uint16_t>(allocated_channels | (1 << channel));
+	}
+	Chip::HAL::exit_critical(primask);
+	return FREE;
+}
+
+
+// Releases the channel's clocks as well, its callback is removed
+void DMA_Class::free(const uint_fast8_t channel)
+{
+	release(channel);
+	set_callback(channel, nullptr, nullptr, false);
+
+	const uint32_t primask = Chip::HAL::enter_critical();
+	allocated_channels = static_cast<uint16_t>(allocated_channels & ~(1 << channel));
+	Chip::HAL::exit_critical(primask);
+}
+
+
+bool DMA_Class::allocated(const uint_fast8_t channel)
+{
+	return (allocated_channels & (1 << channel)) != 0;
+}
+
+
+
+/*
+ * DMA channel functions
+ */
+void DMA_Class::configure(const uint_fast8_t channel, const Transfer_Config_t &config)
+{
+	// Doc: RM0440-7.4.14 | Reconfiguring a channel doesn't take another reference
+	const uint32_t primask = Chip::HAL::enter_critical();
+	if (!(clocked_channels & (1 << channel))) {
+		clocked_channels = static_cast<uint16_t>(clocked_channels | (1 << channel));
+		Chip::Clock::acquire(clock_gate(channel));
+		Chip::Clock::acquire(Chip::Clock::Gate::DMAMUX1EN);
+	}
+	Chip::HAL::exit_critical(primask);
+
+	// Doc: RM0440-12.6.3 | Both halves of a double buffer are reported, with or without set_callback()'s half_transfer
+	if (config.mode == Transfer_Mode::DOUBLE_BUFFER && callbacks[channel] != nullptr) {
+		interrupt_enables[channel] |= (1 << 2);
+	}
+
+	// Doc: RM0440-12.6.3 | The channel must be disabled while it is configured
+	stop(channel);
+	volatile uint32_t *const REGISTER = &channel_registers(channel)->CCR;
+	Chip::HAL::write_register(REGISTER,
+		(static_cast<uint32_t>(config.direction) << 4)
+		| ((static_cast<uint32_t>(config.mode) & 0b1) << 5)
+		| (static_cast<uint32_t>(config.peripheral_increment) << 6)
+		| (static_cast<uint32_t>(config.memory_increment) << 7)
+		| (static_cast<uint32_t>(config.peripheral_width) << 8)
+		| (static_cast<uint32_t>(config.memory_width) << 10)
+		| (static_cast<uint32_t>(config.priority) << 12)
+		| (static_cast<uint32_t>(config.request == Request::MEM2MEM) << 14)
+		| interrupt_enables[channel]);
+
+	// Doc: RM0440-13.6.1 | DMAMUX channel x maps 1:1 to DMA channel x
+	volatile uint32_t *const MUX_REGISTER = &(DMAMUX1_Channel0 + channel)->CCR;
+	Chip::HAL::write_register(MUX_REGISTER, static_cast<uint32_t>(config.request));
+}
+
+
+void DMA_Class::start(const uint_fast8_t channel, volatile const void *const peripheral, volatile const void *const memory,
+                      const uint16_t count)
+{
+	// Doc: RM0440-12.6.4-12.6.6 | Addresses & count can only be written while the channel is disabled
+	DMA_Channel_TypeDef *const CHANNEL = channel_registers(channel);
+	const uint_fast8_t FLAG_WIDTH = 4;
+	constexpr uint32_t FLAG_MASK = Chip::HAL::generate_bitmask(FLAG_WIDTH);
+
+	Chip::HAL::clear_register(&CHANNEL->CCR, 1 << 0);
+	Chip::HAL::write_register(&controller(channel)->IFCR, FLAG_MASK << ((channel % CHANNELS_PER_DMA) * FLAG_WIDTH));
+
+	Chip::HAL::write_address(&CHANNEL->CPAR, peripheral);
+	Chip::HAL::write_address(&CHANNEL->CMAR, memory);
+	Chip::HAL::write_register(&CHANNEL->CNDTR, count);
+	Chip::HAL::set_register(&CHANNEL->CCR, 1 << 0);
+}
+
+
+void DMA_Class::stop(const uint_fast8_t channel)
+{
+	// Doc: RM0440-12.6.3
+	Chip::HAL::clear_register(&channel_registers(channel)->CCR, 1 << 0);
+}
+
+
+void DMA_Class::release(const uint_fast8_t channel)
+{
+	stop(channel);
+
+	const uint32_t primask = Chip::HAL::enter_critical();
+	if (clocked_channels & (1 << channel)) {
+		clocked_channels = static_cast<uint16_t>(clocked_channels & ~(1 << channel));
+		Chip::Clock::release(clock_gate(channel));
+		Chip::Clock::release(Chip::Clock::Gate::DMAMUX1EN);
+	}
+	Chip::HAL::exit_critical(primask);
+}
+
+
+uint16_t DMA_Class::remaining(const uint_fast8_t channel)
+{
+	// Doc: RM0440-12.6.4
+	return static_cast<uint16_t>(Chip::HAL::read_register(&channel_registers(channel)->CNDTR));
+}
+
+
+
+/*
+ * DMAMUX event functions
+ */
+// Doc: RM0440-13.6.4 | GNBREQ + 1 requests per edge, GNBREQ can only be changed while GE is cleared.
+// An edge that comes before the last edge's requests have all been served sets the generator's overrun flag
+void DMA_Class::set_generator(const uint_fast8_t generator, const Signal signal, const Signal_Edge edge,
+                              const uint_fast8_t requests)
+{
+	volatile uint32_t *const REGISTER = &(DMAMUX1_RequestGenerator0 + generator)->RGCR;
+	const uint32_t CONTROL = static_cast<uint32_t>(signal) | (1 << 8)
+	                         | ((static_cast<uint32_t>(requests - 1) & 0x1F) << 19);
+	Chip::HAL::write_register(REGISTER, CONTROL);
+	Chip::HAL::write_register(&DMAMUX1_RequestGenStatus->RGCFR, 1u << generator);
+	Chip::HAL::write_register(REGISTER, CONTROL | (1 << 16) | (static_cast<uint32_t>(edge) << 17));
+}
+
+
+void DMA_Class::clear_generator(const uint_fast8_t generator)
+{
+	Chip::HAL::write_register(&(DMAMUX1_RequestGenerator0 + generator)->RGCR, 0);
+}
+
+
+// Doc: RM0440-13.6.1 | NBREQ + 1 requests are let through per edge & the channel's event output pulses after them.
+// configure() resets the DMAMUX channel, so this comes after it
+void DMA_Class::set_sync(const uint_fast8_t channel, const Signal signal, const Signal_Edge edge,
+                         const uint_fast8_t requests, const bool event_output)
+{
+	volatile uint32_t *const REGISTER = &(DMAMUX1_Channel0 + channel)->CCR;
+	const uint32_t REQUEST = Chip::HAL::read_register(REGISTER) & 0x7F;
+	const uint32_t CONTROL = REQUEST | (1 << 8) | (static_cast<uint32_t>(event_output) << 9)
+	                         | ((static_cast<uint32_t>(requests - 1) & 0x1F) << 19)
+	                         | (static_cast<uint32_t>(signal) << 24);
+	Chip::HAL::write_register(REGISTER, CONTROL);
+	Chip::HAL::write_register(&DMAMUX1_ChannelStatus->CFR, 1u << channel);
+	Chip::HAL::write_register(REGISTER, CONTROL | (1 << 16) | (static_cast<uint32_t>(edge) << 17));
+}
+
+
+void DMA_Class::clear_sync(const uint_fast8_t channel)
+{
+	volatile uint32_t *const REGISTER = &(DMAMUX1_Channel0 + channel)->CCR;
+	Chip::HAL::write_register(REGISTER, Chip::HAL::read_register(REGISTER) & 0x7F);
+}
+
+
+
+/*
+ * DMA interrupt functions
+ */
+// Registers the function called from the channel's interrupt, the channel must be stopped & is configured after
+void DMA_Class::set_callback(const uint_fast8_t channel, const Callback_t callback, void *const context,
+                             const bool half_transfer)
+{
+	// Doc: RM0440-12.6.3 | TCIE, HTIE & TEIE
+	volatile uint32_t *const REGISTER = &channel_registers(channel)->CCR;
+	const uint32_t INTERRUPT_MASK = 0b1110;
+
+	callbacks[channel] = callback;
+	callback_contexts[channel] = context;
+	interrupt_enables[channel] = (callback == nullptr) ? 0 : ((1 << 1) | (static_cast<uint32_t>(half_transfer) << 2) | (1 << 3));
+
+	Chip::HAL::clear_register(REGISTER, INTERRUPT_MASK);
+	Chip::HAL::set_register(REGISTER, interrupt_enables[channel]);
+
+	if (callback == nullptr) {
+		Chip::HAL::disable_irq(irq(channel));
+	} else {
+		Chip::HAL::enable_irq(irq(channel));
+	}
+}
+
+
+// Called from DMAMUX_OVR with the channels & generators that overran
+void DMA_Class::set_overrun_callback(const Overrun_Callback_t callback, void *const context)
+{
+	overrun_callback = callback;
+	overrun_context = context;
+	if (callback == nullptr) {
+		Chip::HAL::disable_irq(DMAMUX_OVR_IRQn);
+	} else {
+		Chip::HAL::enable_irq(DMAMUX_OVR_IRQn);
+	}
+}
+
+
+void DMA_Class::handle_interrupt(const uint_fast8_t channel)
+{
+	// Doc: RM0440-12.6.1-12.6.2 | Flags are cleared by writing IFCR before the callback so none are lost
+	const uint_fast8_t FLAG_WIDTH = 4;
+	constexpr uint32_t FLAG_MASK = Chip::HAL::generate_bitmask(FLAG_WIDTH);
+	const uint32_t FLAG_SHIFT = (channel % CHANNELS_PER_DMA) * FLAG_WIDTH;
+	DMA_TypeDef *const DMA = controller(channel);
+
+	const uint32_t flags = (Chip::HAL::read_register(&DMA->ISR) >> FLAG_SHIFT) & FLAG_MASK
+	                       & (interrupt_enables[channel] | 0b0001);
+	Chip::HAL::write_register(&DMA->IFCR, flags << FLAG_SHIFT);
+
+	const Callback_t CALLBACK = callbacks[channel];
+	if (CALLBACK == nullptr) {
+		return;
+	}
+	const Event EVENTS[] = {Event::HALF_TRANSFER, Event::TRANSFER_COMPLETE, Event::TRANSFER_ERROR};
+	for (auto event: EVENTS) {
+		if (flags & static_cast<uint32_t>(event)) {
+			CALLBACK(channel, event, callback_contexts[channel]);
+		}
+	}
+}
+
+
+
+// Doc: RM0440-13.6.2-13.6.3 & 13.6.5-13.6.6 | SOFx & OFx, cleared through CFR & RGCFR
+void DMA_Class::handle_overrun_interrupt()
+{
+	const uint32_t CHANNELS = Chip::HAL::read_register(&DMAMUX1_ChannelStatus->CSR) & 0xFFFF;
+	const uint32_t GENERATORS = Chip::HAL::read_register(&DMAMUX1_RequestGenStatus->RGSR) & 0b1111;
+	Chip::HAL::write_register(&DMAMUX1_ChannelStatus->CFR, CHANNELS);
+	Chip::HAL::write_register(&DMAMUX1_RequestGenStatus->RGCFR, GENERATORS);
+
+	if (overrun_callback != nullptr && (CHANNELS | GENERATORS) != 0) {
+		overrun_callback(CHANNELS, GENERATORS, overrun_context);
+	}
+}
+
+
+
+/*
+ * DMA register lookup functions
+ */
+DMA_Channel_TypeDef *DMA_Class::channel_registers(const uint_fast8_t channel)
+{
+	// Doc: RM0440-12.6 | Channel register blocks are 0x14 apart, so they are looked up rather than indexed
+	DMA_Channel_TypeDef *const CHANNELS[NUM_CHANNELS] = {
+		DMA1_Channel1, DMA1_Channel2, DMA1_Channel3, DMA1_Channel4,
+		DMA1_Channel5, DMA1_Channel6, DMA1_Channel7, DMA1_Channel8,
+		DMA2_Channel1, DMA2_Channel2, DMA2_Channel3, DMA2_Channel4,
+		DMA2_Channel5, DMA2_Channel6, DMA2_Channel7, DMA2_Channel8
+	};
+	return CHANNELS[channel];
+}
+
+
+DMA_TypeDef *DMA_Class::controller(const uint_fast8_t channel)
+{
+	return (channel < CHANNELS_PER_DMA) ? DMA1 : DMA2;
+}
+
+
+IRQn_Type DMA_Class::irq(const uint_fast8_t channel)
+{
+	const IRQn_Type IRQS[NUM_CHANNELS] = {
+		DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+		DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn, DMA1_Channel8_IRQn,
+		DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn, DMA2_Channel4_IRQn,
+		DMA2_Channel5_IRQn, DMA2_Channel6_IRQn, DMA2_Channel7_IRQn, DMA2_Channel8_IRQn
+	};
+	return IRQS[channel];
+}
+
+
+Chip::Clock::Gate DMA_Class::clock_gate(const uint_fast8_t channel)
+{
+	// Doc: RM0440-7.4.14
+	return (channel < CHANNELS_PER_DMA) ? Chip::Clock::Gate::DMA1EN : Chip::Clock::Gate::DMA2EN;
+}
+
+
+
+/*
+ * DMA interrupt handlers, these replace the weak aliases in the startup file
+ */
+extern "C" {
+void DMA1_Channel1_IRQHandler() { DMA_Class::handle_interrupt(0); }
+void DMA1_Channel2_IRQHandler() { DMA_Class::handle_interrupt(1); }
+void DMA1_Channel3_IRQHandler() { DMA_Class::handle_interrupt(2); }
+void DMA1_Channel4_IRQHandler() { DMA_Class::handle_interrupt(3); }
+void DMA1_Channel5_IRQHandler() { DMA_Class::handle_interrupt(4); }
+void DMA1_Channel6_IRQHandler() { DMA_Class::handle_interrupt(5); }
+void DMA1_Channel7_IRQHandler() { DMA_Class::handle_interrupt(6); }
+void DMA1_Channel8_IRQHandler() { DMA_Class::handle_interrupt(7); }
+void DMA2_Channel1_IRQHandler() { DMA_Class::handle_interrupt(8); }
+void DMA2_Channel2_IRQHandler() { DMA_Class::handle_interrupt(9); }
+void DMA2_Channel3_IRQHandler() { DMA_Class::handle_interrupt(10); }
+void DMA2_Channel4_IRQHandler() { DMA_Class::handle_interrupt(11); }
+void DMA2_Channel5_IRQHandler() { DMA_Class::handle_interrupt(12); }
+void DMA2_Channel6_IRQHandler() { DMA_Class::handle_interrupt(13); }
+void DMA2_Channel7_IRQHandler() { DMA_Class::handle_interrupt(14); }
+void DMA2_Channel8_IRQHandler() { DMA_Class::handle_interrupt(15); }
+void DMAMUX_OVR_IRQHandler() { DMA_Class::handle_overrun_interrupt(); }
+}
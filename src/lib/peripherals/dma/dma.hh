@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+// File Name    : dma.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_DMA_HH
+#define STM32G4_MODULE_LIBRARY_DMA_HH
+
+#include <cstdint>
+#include "../../chip/stm32g491/stm32g491_clock.hh"
+
+#ifdef UNIT_TEST
+#include "../../chip/stm32g491/stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+// Channels are numbered the way DMAMUX numbers them, 0-7 are DMA1 channels 1-8 and 8-15 are DMA2 channels 1-8
+class DMA_Class {
+public:
+	static constexpr uint_fast8_t NUM_CHANNELS = 16;    // Doc: RM0440-12.3.1 | 8 channels per controller
+	static constexpr uint_fast8_t CHANNELS_PER_DMA = 8;
+	static constexpr uint_fast8_t NO_CHANNEL = UINT8_MAX;
+	static constexpr uint_fast8_t NUM_GENERATORS = 4;        // Doc: RM0440-13.3.1
+	static constexpr uint_fast8_t MAX_EVENT_REQUESTS = 32;   // NBREQ & GNBREQ are 5 bits, plus one
+
+	enum class Request : uint8_t {
+		// Doc: RM0440-13.3.2 | DMAMUX request line multiplexer inputs
+		MEM2MEM = 0,
+		GENERATOR_0 = 1,
+		GENERATOR_1 = 2,
+		GENERATOR_2 = 3,
+		GENERATOR_3 = 4,
+		TIM6_UP = 8,
+		TIM7_UP = 9,
+		SPI1_RX = 10,
+		SPI1_TX = 11,
+		SPI2_RX = 12,
+		SPI2_TX = 13,
+		SPI3_RX = 14,
+		SPI3_TX = 15,
+		USART1_RX = 24,
+		USART1_TX = 25,
+		USART2_RX = 26,
+		USART2_TX = 27,
+		USART3_RX = 28,
+		USART3_TX = 29,
+		UART4_RX = 30,
+		UART4_TX = 31,
+		UART5_RX = 32,
+		UART5_TX = 33,
+		LPUART1_RX = 34,
+		LPUART1_TX = 35,
+		TIM1_CH1 = 42,
+		TIM1_CH2 = 43,
+		TIM1_CH3 = 44,
+		TIM1_CH4 = 45,
+		TIM1_UP = 46,
+		TIM8_CH1 = 49,
+		TIM8_CH2 = 50,
+		TIM8_CH3 = 51,
+		TIM8_CH4 = 52,
+		TIM8_UP = 53,
+		TIM2_CH1 = 56,
+		TIM2_CH2 = 57,
+		TIM2_CH3 = 58,
+		TIM2_CH4 = 59,
+		TIM2_UP = 60,
+		TIM3_CH1 = 61,
+		TIM3_CH2 = 62,
+		TIM3_CH3 = 63,
+		TIM3_CH4 = 64,
+		TIM3_UP = 65,
+		TIM4_CH1 = 67,
+		TIM4_CH2 = 68,
+		TIM4_CH3 = 69,
+		TIM4_CH4 = 70,
+		TIM4_UP = 71,
+		TIM15_CH1 = 78,
+		TIM15_UP = 79,
+		TIM16_CH1 = 82,
+		TIM16_UP = 83,
+		TIM17_CH1 = 84,
+		TIM17_UP = 85,
+		TIM20_CH1 = 86,
+		TIM20_CH2 = 87,
+		TIM20_CH3 = 88,
+		TIM20_CH4 = 89,
+		TIM20_UP = 90
+	};
+
+	enum class Signal : uint8_t {
+		// Doc: RM0440-13.3.3-13.3.4 | DMAMUX trigger & synchronization inputs, the same list for both
+		EXTI_LINE_0 = 0,                // EXTI lines 0-15 are EXTI_LINE_0 + n
+		EXTI_LINE_15 = 15,
+		CHANNEL_0_EVENT = 16,           // dmamux_evt0-3, DMAMUX channels 0-3 with their event output on
+		CHANNEL_1_EVENT = 17,
+		CHANNEL_2_EVENT = 18,
+		CHANNEL_3_EVENT = 19,
+		LPTIM1_OUTPUT = 20
+	};
+
+	enum class Signal_Edge {
+		// Doc: RM0440-13.6.1 & 13.6.4 | SPOL & GPOL
+		RISING = 0b01,
+		FALLING = 0b10,
+		BOTH = 0b11
+	};
+
+	enum class Direction {
+		// Doc: RM0440-12.6.3
+		PERIPHERAL_TO_MEMORY = 0b0,
+		MEMORY_TO_PERIPHERAL = 0b1
+	};
+
+	enum class Data_Width {
+		// Doc: RM0440-12.6.3
+		BYTE = 0b00,
+		HALF_WORD = 0b01,
+		WORD = 0b10
+	};
+
+	enum class Priority {
+		// Doc: RM0440-12.6.3
+		LOW = 0b00,
+		MEDIUM = 0b01,
+		HIGH = 0b10,
+		VERY_HIGH = 0b11
+	};
+
+	enum class Transfer_Mode {
+		// Doc: RM0440-12.6.3 | Bit 0 is CIRC. There is no double buffer mode on the G4, so it is a circular transfer
+		// over both buffers back to back & the callback is given each half as soon as it completes
+		NORMAL = 0b00,
+		CIRCULAR = 0b01,
+		DOUBLE_BUFFER = 0b11
+	};
+
+	enum class Event {
+		// Doc: RM0440-12.6.1
+		TRANSFER_COMPLETE = 0b0010,
+		HALF_TRANSFER = 0b0100,
+		TRANSFER_ERROR = 0b1000
+	};
+
+	typedef void (*Callback_t)(uint_fast8_t channel, Event event, void *context);
+	typedef void (*Overrun_Callback_t)(uint32_t channels, uint32_t generators, void *context);
+
+	typedef struct {
+		Request request;
+		Direction direction;
+		Data_Width peripheral_width;
+		Data_Width memory_width;
+		bool peripheral_increment;
+		bool memory_increment;
+		Transfer_Mode mode;
+		Priority priority;
+	} Transfer_Config_t;
+
+	// Channels handed out at runtime, drivers given a fixed channel reserve it so nothing else is allocated on it
+	static uint_fast8_t allocate(Priority priority);
+	static bool reserve(uint_fast8_t channel);
+	static void free(uint_fast8_t channel);
+	static bool allocated(uint_fast8_t channel);
+
+	// A configured channel holds its DMA & DMAMUX clocks until it is released
+	static void configure(uint_fast8_t channel, const Transfer_Config_t &config);
+	static void release(uint_fast8_t channel);
+	static void start(uint_fast8_t channel, volatile const void *peripheral, volatile const void *memory, uint16_t count);
+	static void stop(uint_fast8_t channel);
+	static uint16_t remaining(uint_fast8_t channel);
+
+	// Requests sent by a generator on every edge of its signal, routed to a channel with Request::GENERATOR_x
+	static void set_generator(uint_fast8_t generator, Signal signal, Signal_Edge edge, uint_fast8_t requests);
+	static void clear_generator(uint_fast8_t generator);
+
+	// Holds a configured channel's requests back until an edge of the signal, then lets requests through
+	static void set_sync(uint_fast8_t channel, Signal signal, Signal_Edge edge, uint_fast8_t requests, bool event_output);
+	static void clear_sync(uint_fast8_t channel);
+
+	static void set_callback(uint_fast8_t channel, Callback_t callback, void *context, bool half_transfer);
+	static void set_overrun_callback(Overrun_Callback_t callback, void *context);
+	static void handle_interrupt(uint_fast8_t channel);
+	static void handle_overrun_interrupt();
+
+	// The half of a double buffer that is done with, 0 for the first & 1 for the second
+	static constexpr uint_fast8_t completed_half(const Event event)
+	{
+		return (event == Event::HALF_TRANSFER) ? 0 : 1;
+	}
+
+	static DMA_Channel_TypeDef *channel_registers(uint_fast8_t channel);
+	static DMA_TypeDef *controller(uint_fast8_t channel);
+	static IRQn_Type irq(uint_fast8_t channel);
+	static Chip::Clock::Gate clock_gate(uint_fast8_t channel);
+
+private:
+	static Callback_t callbacks[NUM_CHANNELS];
+	static void *callback_contexts[NUM_CHANNELS];
+	static uint32_t interrupt_enables[NUM_CHANNELS];
+	static uint16_t clocked_channels;
+	static uint16_t allocated_channels;
+	static Overrun_Callback_t overrun_callback;
+	static void *overrun_context;
+};
+
+
+#endif //STM32G4_MODULE_LIBRARY_DMA_HH
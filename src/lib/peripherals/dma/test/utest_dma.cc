@@ -0,0 +1,319 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_dma.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include "../dma.hh"
+#include "../../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+TEST_CASE("DMA functions", "[DMA][PERIPHERAL]")
+{
+	using DMA = Chip::DMA;
+	auto channel = static_cast<uint_fast8_t>(GENERATE(range(0, 16)));
+	DMA_Channel_TypeDef *const CHANNEL = DMA::channel_registers(channel);
+
+
+	SECTION("DMA Configure Channel") {
+		// Doc: RM0440-12.6.3 & RM0440-13.6.1
+		const DMA::Transfer_Config_t CONFIG = {
+			.request=DMA::Request::TIM2_UP,
+			.direction=DMA::Direction::MEMORY_TO_PERIPHERAL,
+			.peripheral_width=DMA::Data_Width::HALF_WORD,
+			.memory_width=DMA::Data_Width::WORD,
+			.peripheral_increment=false,
+			.memory_increment=true,
+			.mode=DMA::Transfer_Mode::CIRCULAR,
+			.priority=DMA::Priority::HIGH
+		};
+		DMA::configure(channel, CONFIG);
+
+		REQUIRE(Chip::HAL::read_field(&RCC->AHB1ENR, (channel < DMA::CHANNELS_PER_DMA) ? 0 : 1, 1) == 1);
+		REQUIRE(Chip::HAL::read_field(&RCC->AHB1ENR, 2, 1) == 1);
+		REQUIRE(CHANNEL->CCR == ((1 << 4) | (1 << 5) | (1 << 7) | (0b01 << 8) | (0b10 << 10) | (0b10 << 12)));
+		REQUIRE((DMAMUX1_Channel0 + channel)->CCR == static_cast<uint32_t>(DMA::Request::TIM2_UP));
+	}
+
+
+	SECTION("DMA Transfer") {
+		uint16_t source[4] = {0x1111, 0x2222, 0x3333, 0x4444};
+		uint16_t destination = 0;
+		const DMA::Transfer_Config_t CONFIG = {
+			.request=DMA::Request::TIM6_UP,
+			.direction=DMA::Direction::MEMORY_TO_PERIPHERAL,
+			.peripheral_width=DMA::Data_Width::HALF_WORD,
+			.memory_width=DMA::Data_Width::HALF_WORD,
+			.peripheral_increment=false,
+			.memory_increment=true,
+			.mode=DMA::Transfer_Mode::NORMAL,
+			.priority=DMA::Priority::LOW
+		};
+		DMA::configure(channel, CONFIG);
+		DMA::start(channel, &destination, source, 4);
+		REQUIRE(DMA::remaining(channel) == 4);
+
+		for (auto value: source) {
+			trigger_DMA_request(static_cast<uint16_t>(DMA::Request::TIM6_UP));
+			REQUIRE(destination == value);
+		}
+		REQUIRE(DMA::remaining(channel) == 0);
+
+		// Doc: RM0440-12.6.1 | TCIF
+		const uint32_t FLAG_SHIFT = 4 * (channel % DMA::CHANNELS_PER_DMA);
+		REQUIRE(((DMA::controller(channel)->ISR >> FLAG_SHIFT) & 0b0010) == 0b0010);
+
+		DMA::stop(channel);
+		REQUIRE((CHANNEL->CCR & 1) == 0);
+	}
+
+
+	SECTION("DMA Interrupt Callbacks") {
+		// Doc: RM0440-12.4.6
+		uint8_t source[4] = {1, 2, 3, 4};
+		uint8_t destination = 0;
+		uint32_t events = 0;
+		const DMA::Transfer_Config_t CONFIG = {
+			.request=DMA::Request::TIM3_UP,
+			.direction=DMA::Direction::MEMORY_TO_PERIPHERAL,
+			.peripheral_width=DMA::Data_Width::BYTE,
+			.memory_width=DMA::Data_Width::BYTE,
+			.peripheral_increment=false,
+			.memory_increment=true,
+			.mode=DMA::Transfer_Mode::CIRCULAR,
+			.priority=DMA::Priority::MEDIUM
+		};
+		auto callback = [](uint_fast8_t, DMA::Event event, void *context) {
+			*static_cast<uint32_t *>(context) = (*static_cast<uint32_t *>(context) << 4) | static_cast<uint32_t>(event);
+		};
+		DMA::set_callback(channel, callback, &events, true);
+		DMA::configure(channel, CONFIG);
+		DMA::start(channel, &destination, source, 4);
+
+		for (uint_fast8_t i = 0; i < 8; i++) {
+			trigger_DMA_request(static_cast<uint16_t>(DMA::Request::TIM3_UP));
+		}
+		REQUIRE(events == 0x4242);
+
+		DMA::stop(channel);
+		DMA::set_callback(channel, nullptr, nullptr, false);
+		REQUIRE((CHANNEL->CCR & 0b1110) == 0);
+	}
+
+	// Gives the DMA & DMAMUX clocks back, a clocked channel is never allocated
+	DMA::release(channel);
+}
+
+
+TEST_CASE("DMA allocation", "[DMA][PERIPHERAL]")
+{
+	using DMA = Chip::DMA;
+
+	// The channels the other tests configured are given back first
+	for (uint_fast8_t channel = 0; channel < DMA::NUM_CHANNELS; channel++) {
+		DMA::free(channel);
+	}
+
+
+	SECTION("DMA Channel Allocator") {
+		// Doc: RM0440-12.4.3 | Ties go to the lower channel, so high priorities are given the low channels
+		const uint_fast8_t FAST = DMA::allocate(DMA::Priority::VERY_HIGH);
+		const uint_fast8_t SLOW = DMA::allocate(DMA::Priority::LOW);
+		REQUIRE(FAST == 0);
+		REQUIRE(SLOW == DMA::NUM_CHANNELS - 1);
+		REQUIRE(DMA::allocated(FAST));
+
+		// Reserved & configured channels are skipped
+		REQUIRE(DMA::reserve(1));
+		REQUIRE(!DMA::reserve(1));
+		DMA::configure(2, {.request=DMA::Request::MEM2MEM, .direction=DMA::Direction::MEMORY_TO_PERIPHERAL,
+		                   .peripheral_width=DMA::Data_Width::BYTE, .memory_width=DMA::Data_Width::BYTE,
+		                   .peripheral_increment=true, .memory_increment=true, .mode=DMA::Transfer_Mode::NORMAL,
+		                   .priority=DMA::Priority::LOW});
+		REQUIRE(!DMA::reserve(2));
+		REQUIRE(DMA::allocate(DMA::Priority::HIGH) == 3);
+
+		// Reconfiguring a running channel disables it first
+		Chip::HAL::set_register(&DMA1_Channel3->CCR, 1 << 0);
+		DMA::configure(2, {.request=DMA::Request::MEM2MEM, .direction=DMA::Direction::MEMORY_TO_PERIPHERAL,
+		                   .peripheral_width=DMA::Data_Width::BYTE, .memory_width=DMA::Data_Width::BYTE,
+		                   .peripheral_increment=true, .memory_increment=true, .mode=DMA::Transfer_Mode::NORMAL,
+		                   .priority=DMA::Priority::LOW});
+		REQUIRE((DMA1_Channel3->CCR & (1 << 0)) == 0);
+		DMA::release(2);
+
+		// Running out is reported rather than sharing a channel
+		uint_fast8_t taken = 4;
+		while (DMA::allocate(DMA::Priority::MEDIUM) != DMA::NO_CHANNEL) {
+			taken++;
+		}
+		REQUIRE(taken == DMA::NUM_CHANNELS);
+
+		DMA::free(FAST);
+		REQUIRE(!DMA::allocated(FAST));
+		REQUIRE(DMA::allocate(DMA::Priority::HIGH) == FAST);
+		for (uint_fast8_t channel = 0; channel < DMA::NUM_CHANNELS; channel++) {
+			DMA::free(channel);
+		}
+		REQUIRE(!Chip::Clock::is_running(Chip::Clock::Gate::DMAMUX1EN));
+	}
+
+
+	SECTION("DMA Double Buffer") {
+		// Each half is handed back as soon as the DMA moves on to the other one
+		struct Halves {
+			uint32_t count;
+			uint_fast8_t last;
+		} halves = {0, 0};
+		auto callback = [](uint_fast8_t, DMA::Event event, void *context) {
+			Halves &done = *static_cast<Halves *>(context);
+			done.count++;
+			done.last = DMA::completed_half(event);
+		};
+
+		uint16_t buffer[8] = {};
+		uint16_t sample = 0;
+		const uint_fast8_t CHANNEL = DMA::allocate(DMA::Priority::HIGH);
+		REQUIRE(CHANNEL != DMA::NO_CHANNEL);
+		DMA::set_callback(CHANNEL, callback, &halves, false);
+		DMA::configure(CHANNEL, {.request=DMA::Request::TIM4_UP, .direction=DMA::Direction::PERIPHERAL_TO_MEMORY,
+		                         .peripheral_width=DMA::Data_Width::HALF_WORD, .memory_width=DMA::Data_Width::HALF_WORD,
+		                         .peripheral_increment=false, .memory_increment=true,
+		                         .mode=DMA::Transfer_Mode::DOUBLE_BUFFER, .priority=DMA::Priority::HIGH});
+		REQUIRE((DMA::channel_registers(CHANNEL)->CCR & ((1 << 5) | (1 << 2))) == ((1 << 5) | (1 << 2)));
+		DMA::start(CHANNEL, &sample, buffer, 8);
+
+		for (uint16_t i = 0; i < 12; i++) {
+			sample = static_cast<uint16_t>(100 + i);
+			trigger_DMA_request(static_cast<uint16_t>(DMA::Request::TIM4_UP));
+			if (i == 3) {
+				REQUIRE(halves.count == 1);
+				REQUIRE(halves.last == 0);
+				REQUIRE(buffer[3] == 103);
+			} else if (i == 7) {
+				REQUIRE(halves.count == 2);
+				REQUIRE(halves.last == 1);
+			}
+		}
+		REQUIRE(halves.count == 3);
+		REQUIRE(halves.last == 0);
+		REQUIRE(buffer[0] == 108);
+		REQUIRE(buffer[7] == 107);
+		DMA::free(CHANNEL);
+	}
+}
+
+
+TEST_CASE("DMAMUX events", "[DMA][PERIPHERAL]")
+{
+	using DMA = Chip::DMA;
+	struct Overruns {
+		uint32_t count;
+		uint32_t channels;
+		uint32_t generators;
+	} overruns = {0, 0, 0};
+	auto on_overrun = [](uint32_t channels, uint32_t generators, void *context) {
+		Overruns &seen = *static_cast<Overruns *>(context);
+		seen.count++;
+		seen.channels = channels;
+		seen.generators = generators;
+	};
+	DMA::set_overrun_callback(on_overrun, &overruns);
+
+	uint16_t sample = 0;
+	uint16_t samples[8] = {};
+	const DMA::Transfer_Config_t CONFIG = {
+		.request=DMA::Request::GENERATOR_0,
+		.direction=DMA::Direction::PERIPHERAL_TO_MEMORY,
+		.peripheral_width=DMA::Data_Width::HALF_WORD,
+		.memory_width=DMA::Data_Width::HALF_WORD,
+		.peripheral_increment=false,
+		.memory_increment=true,
+		.mode=DMA::Transfer_Mode::NORMAL,
+		.priority=DMA::Priority::HIGH
+	};
+	const uint_fast8_t CHANNEL = DMA::allocate(DMA::Priority::HIGH);
+	REQUIRE(CHANNEL != DMA::NO_CHANNEL);
+
+
+	SECTION("DMAMUX Request Generator") {
+		// Doc: RM0440-13.6.4 | Four requests on every rising edge of EXTI line 3, no CPU in between
+		DMA::configure(CHANNEL, CONFIG);
+		DMA::set_generator(0, static_cast<DMA::Signal>(3), DMA::Signal_Edge::RISING, 4);
+		REQUIRE(DMAMUX1_RequestGenerator0->RGCR == (3 | (1 << 8) | (1 << 16) | (0b01 << 17) | (3 << 19)));
+		DMA::start(CHANNEL, &sample, samples, 8);
+
+		sample = 7;
+		trigger_DMAMUX_signal(3, true);
+		REQUIRE(DMA::remaining(CHANNEL) == 4);
+		REQUIRE(samples[3] == 7);
+		trigger_DMAMUX_signal(3, false);
+		trigger_DMAMUX_signal(4, true);
+		REQUIRE(DMA::remaining(CHANNEL) == 4);
+		sample = 9;
+		trigger_DMAMUX_signal(3, true);
+		REQUIRE(DMA::remaining(CHANNEL) == 0);
+		REQUIRE(samples[7] == 9);
+		REQUIRE(overruns.count == 0);
+
+		// Edges the channel can't keep up with are reported
+		trigger_DMAMUX_signal(3, true);
+		trigger_DMAMUX_signal(3, true);
+		REQUIRE(overruns.count == 1);
+		REQUIRE(overruns.generators == 0b0001);
+		REQUIRE(overruns.channels == 0);
+		update_DMAMUX_status();
+		REQUIRE(DMAMUX1_RequestGenStatus->RGSR == 0);
+
+		DMA::clear_generator(0);
+		REQUIRE(DMAMUX1_RequestGenerator0->RGCR == 0);
+	}
+
+
+	SECTION("DMAMUX Synchronization") {
+		// Doc: RM0440-13.6.1 | The timer's requests only get through two at a time, after each LPTIM1 output edge
+		DMA::Transfer_Config_t synced = CONFIG;
+		synced.request = DMA::Request::TIM6_UP;
+		DMA::configure(CHANNEL, synced);
+		DMA::set_sync(CHANNEL, DMA::Signal::LPTIM1_OUTPUT, DMA::Signal_Edge::BOTH, 2, false);
+		const uint32_t MUX = (DMAMUX1_Channel0 + CHANNEL)->CCR;
+		REQUIRE((MUX & 0x7F) == static_cast<uint32_t>(DMA::Request::TIM6_UP));
+		REQUIRE(((MUX >> 24) & 0x1F) == 20);
+		REQUIRE(((MUX >> 16) & 0b111) == 0b111);
+		REQUIRE(((MUX >> 19) & 0x1F) == 1);
+		DMA::start(CHANNEL, &sample, samples, 8);
+
+		const uint16_t REQUEST = static_cast<uint16_t>(DMA::Request::TIM6_UP);
+		trigger_DMA_request(REQUEST);
+		REQUIRE(DMA::remaining(CHANNEL) == 8);
+		trigger_DMAMUX_signal(20, false);
+		for (uint_fast8_t i = 0; i < 3; i++) {
+			trigger_DMA_request(REQUEST);
+		}
+		REQUIRE(DMA::remaining(CHANNEL) == 6);
+
+		// A sync event while requests from the last one are still outstanding overruns
+		trigger_DMAMUX_signal(20, true);
+		trigger_DMA_request(REQUEST);
+		trigger_DMAMUX_signal(20, true);
+		REQUIRE(overruns.count == 1);
+		REQUIRE(overruns.channels == (1u << CHANNEL));
+
+		DMA::clear_sync(CHANNEL);
+		REQUIRE((DMAMUX1_Channel0 + CHANNEL)->CCR == static_cast<uint32_t>(DMA::Request::TIM6_UP));
+		trigger_DMA_request(REQUEST);
+		REQUIRE(DMA::remaining(CHANNEL) == 4);
+	}
+
+
+	DMA::free(CHANNEL);
+	DMA::set_overrun_callback(nullptr, nullptr);
+}
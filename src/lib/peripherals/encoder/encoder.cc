@@ -0,0 +1,230 @@
+//------------------------------------------------------------------------------
+// File Name    : encoder.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "encoder.hh"
+#include "../timer/timer.hh"
+#include "../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+namespace {
+	// Doc: RM0440-29.5.3 | SMS = 0011, encoder mode 3 counts both edges of both inputs
+	constexpr uint32_t SLAVE_MODE_MASK = 0b111 | (1 << 16);
+	constexpr uint32_t ENCODER_MODE_3 = 0b011;
+
+	// Doc: RM0440-29.5.1 & 29.5.12 | UIFREMAP copies UIF into bit 31 of CNT, so one read gives both
+	constexpr uint32_t UIF_REMAP = 1 << 11;
+	constexpr uint32_t UIF_COPY = 1u << 31;
+	constexpr uint32_t COUNT_MASK = 0xFFFF;
+	constexpr uint32_t HALF_COUNT = 0x8000;
+
+	// Doc: RM0440-29.5.23
+	constexpr uint32_t INDEX_ENABLE = 1 << 0;
+	constexpr uint32_t FIRST_INDEX = 1 << 5;
+
+	using Event = Timer_Class::Event;
+
+
+	bool is_32_bit(const TIM_TypeDef *const timer)
+	{
+		return timer == TIM2;
+	}
+
+	// A wrap lands the counter near one end or the other, which end says which way it went
+	int32_t wrap_direction(const uint32_t count)
+	{
+		return ((count & COUNT_MASK) < HALF_COUNT) ? 1 : -1;
+	}
+
+	int32_t rate(const int32_t counts, const uint32_t cycles)
+	{
+		// mcounts/s, saturated to what fits
+		const int64_t RATE = static_cast<int64_t>(counts) * Chip::Clock::frequency(Chip::Clock::Domain::HCLK) * 1000
+		                     / static_cast<int64_t>(cycles);
+		return static_cast<int32_t>((RATE > INT32_MAX) ? INT32_MAX : ((RATE < -INT32_MAX) ? -INT32_MAX : RATE));
+	}
+}
+
+
+
+/*
+ * Encoder functions
+ */
+void Encoder_Class::start(Encoder_t &encoder)
+{
+	stop(encoder);
+
+	TIM_TypeDef *const TIMER = encoder.timer;
+	Timer_Class::set_clock(TIMER, Timer_Class::Clock_Status::ENABLED);
+	encoder.clocked = true;
+	Timer_Class::set_time_base(TIMER, 0, is_32_bit(TIMER) ? UINT32_MAX : UINT16_MAX);
+
+	// Doc: RM0440-29.3.24 | Both inputs mapped directly & not inverted, CC1E also lets channel 1 timestamp edges
+	Timer_Class::set_input_capture(TIMER, 1, Timer_Class::Capture_Edge::RISING, encoder.filter);
+	Timer_Class::set_input_capture(TIMER, 2, Timer_Class::Capture_Edge::RISING, encoder.filter);
+	volatile uint32_t *const SLAVE_MODE = &TIMER->SMCR;
+	Chip::HAL::write_register(SLAVE_MODE, (Chip::HAL::read_register(SLAVE_MODE) & ~SLAVE_MODE_MASK) | ENCODER_MODE_3);
+
+	// Doc: RM0440-29.3.25 | The index resets the counter when both inputs are low, in either direction
+	const uint32_t INDEX = (encoder.index_mode == Index_Mode::NONE) ? 0
+		: (INDEX_ENABLE | ((encoder.index_mode == Index_Mode::FIRST) ? FIRST_INDEX : 0));
+	Chip::HAL::write_register(&TIMER->ECR, INDEX);
+	if (!is_32_bit(TIMER)) {
+		Chip::HAL::set_register(&TIMER->CR1, UIF_REMAP);
+	}
+
+	encoder.wraps = 0;
+	encoder.velocity = 0;
+	encoder.indexed = false;
+	encoder.edges = 0;
+	encoder.last_position = 0;
+	encoder.last_sample = Chip::HAL::read_cycle_counter();
+	Chip::HAL::write_register(&TIMER->CNT, 0);
+	set_timestamping(encoder, false);
+	Timer_Class::start(TIMER);
+}
+
+
+void Encoder_Class::stop(Encoder_t &encoder)
+{
+	TIM_TypeDef *const TIMER = encoder.timer;
+	Timer_Class::stop(TIMER);
+	Timer_Class::set_callback(Timer_Class::instance(TIMER), nullptr, nullptr, 0);
+	Chip::HAL::write_register(&TIMER->ECR, 0);
+	Chip::HAL::clear_register(&TIMER->SMCR, SLAVE_MODE_MASK);
+	Chip::HAL::clear_register(&TIMER->CR1, UIF_REMAP);
+
+	// Only the reference start() took, the timer may be running for someone else or have stopped by itself
+	if (encoder.clocked) {
+		encoder.clocked = false;
+		Timer_Class::set_clock(TIMER, Timer_Class::Clock_Status::DISABLED);
+	}
+}
+
+
+// Counts from start() or the last index. The wrap count is read on both sides of the counter, so a wrap counted
+// in between is seen & the read tried again. A wrap the update interrupt hasn't counted yet shows in UIFCPY.
+int32_t Encoder_Class::position(const Encoder_t &encoder)
+{
+	if (is_32_bit(encoder.timer)) {
+		return static_cast<int32_t>(Chip::HAL::read_register(&encoder.timer->CNT));
+	}
+
+	int32_t wraps = 0;
+	uint32_t count = 0;
+	do {
+		wraps = encoder.wraps;
+		count = Chip::HAL::read_register(&encoder.timer->CNT);
+	} while (wraps != encoder.wraps);
+
+	if (count & UIF_COPY) {
+		wraps += wrap_direction(count);
+	}
+	return static_cast<int32_t>(static_cast<uint32_t>(wraps) * (COUNT_MASK + 1) + (count & COUNT_MASK));
+}
+
+
+// mcounts/s as of the last sample()
+int32_t Encoder_Class::velocity(const Encoder_t &encoder)
+{
+	return encoder.velocity;
+}
+
+
+bool Encoder_Class::indexed(const Encoder_t &encoder)
+{
+	return encoder.indexed;
+}
+
+
+void Encoder_Class::sample(Encoder_t &encoder)
+{
+	const uint32_t NOW = Chip::HAL::read_cycle_counter();
+	const int32_t POSITION = position(encoder);
+	const int32_t DELTA = static_cast<int32_t>(static_cast<uint32_t>(POSITION) - static_cast<uint32_t>(encoder.last_position));
+	const uint32_t ELAPSED = NOW - encoder.last_sample;
+	const uint32_t DISTANCE = static_cast<uint32_t>((DELTA < 0) ? -static_cast<int64_t>(DELTA) : DELTA);
+	int32_t velocity = (ELAPSED == 0) ? encoder.velocity : rate(DELTA, ELAPSED);
+
+	if (DISTANCE >= encoder.low_speed_counts) {
+		if (encoder.timestamping) {
+			set_timestamping(encoder, false);
+		}
+	} else if (!encoder.timestamping) {
+		set_timestamping(encoder, true);
+	} else {
+		const uint32_t primask = Chip::HAL::enter_critical();
+		const uint32_t EDGES = encoder.edges;
+		const uint32_t FIRST = encoder.edge_cycles[0];
+		const uint32_t LAST = encoder.edge_cycles[1];
+		const int32_t COUNTS = encoder.edge_positions[1] - encoder.edge_positions[0];
+		Chip::HAL::exit_critical(primask);
+
+		// A longer wait since the last edge than between the last two means the encoder is slowing down, the
+		// velocity can be at most one edge's counts over that wait
+		if (EDGES >= 2) {
+			const uint32_t INTERVAL = LAST - FIRST;
+			const uint32_t SINCE = NOW - LAST;
+			const uint64_t STOP_CYCLES = static_cast<uint64_t>(Chip::Clock::frequency(Chip::Clock::Domain::HCLK))
+			                             * encoder.stop_time / 1000000;
+			if (COUNTS == 0 || SINCE > STOP_CYCLES) {
+				velocity = 0;
+			} else {
+				velocity = rate(COUNTS, (SINCE > INTERVAL) ? SINCE : INTERVAL);
+			}
+		}
+	}
+
+	encoder.velocity = velocity;
+	encoder.last_position = POSITION;
+	encoder.last_sample = NOW;
+}
+
+
+
+/*
+ * Encoder interrupt functions
+ */
+// Edge timestamps cost an interrupt per channel 1 edge, so they are only on while the encoder is slow
+void Encoder_Class::set_timestamping(Encoder_t &encoder, const bool enabled)
+{
+	const uint32_t EVENTS = (is_32_bit(encoder.timer) ? 0 : static_cast<uint32_t>(Event::UPDATE))
+	                        | ((encoder.index_mode == Index_Mode::NONE) ? 0 : static_cast<uint32_t>(Event::INDEX))
+	                        | (enabled ? static_cast<uint32_t>(Event::CAPTURE_COMPARE_1) : 0);
+	encoder.edges = 0;
+	encoder.timestamping = enabled;
+	Timer_Class::set_callback(Timer_Class::instance(encoder.timer), timer_callback, &encoder, EVENTS);
+}
+
+
+void Encoder_Class::timer_callback(const uint32_t events, void *const context)
+{
+	Encoder_t &encoder = *static_cast<Encoder_t *>(context);
+	const uint32_t COUNT = Chip::HAL::read_register(&encoder.timer->CNT);
+
+	if (events & static_cast<uint32_t>(Event::UPDATE)) {
+		encoder.wraps = encoder.wraps + wrap_direction(COUNT);
+	}
+
+	// Doc: RM0440-29.3.25 | Counting down, the index reloads ARR rather than 0, which is position -1
+	if (events & static_cast<uint32_t>(Event::INDEX)) {
+		encoder.wraps = (wrap_direction(COUNT) > 0 || is_32_bit(encoder.timer)) ? 0 : -1;
+		encoder.indexed = true;
+	}
+
+	if (events & static_cast<uint32_t>(Event::CAPTURE_COMPARE_1)) {
+		encoder.edge_cycles[0] = encoder.edge_cycles[1];
+		encoder.edge_positions[0] = encoder.edge_positions[1];
+		encoder.edge_cycles[1] = Chip::HAL::read_cycle_counter();
+		encoder.edge_positions[1] = position(encoder);
+		encoder.edges = encoder.edges + 1;
+	}
+}
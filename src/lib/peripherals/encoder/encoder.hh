@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+// File Name    : encoder.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_ENCODER_HH
+#define STM32G4_MODULE_LIBRARY_ENCODER_HH
+
+#include <cstdint>
+
+#ifdef UNIT_TEST
+#include "../../chip/stm32g491/stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+// Quadrature encoder on a timer in encoder mode, counting every edge of A (channel 1) & B (channel 2) in hardware,
+// with an optional index pulse on ETR. 16-bit counters are extended to 32 bits by counting their wraps in the
+// update interrupt, TIM2 counts 32 bits itself. position() & velocity() never block or mask interrupts.
+//
+// sample() runs at a fixed rate, e.g. from a control loop. While the encoder moves at least low_speed_counts per
+// sample the velocity is the count delta over the sample time. Slower than that, the delta is mostly quantization,
+// so channel 1 edges are timestamped with the cycle counter instead & the velocity is taken between edges.
+class Encoder_Class {
+public:
+	enum class Index_Mode {
+		// Doc: RM0440-29.5.23 | IE & FIDX
+		NONE,
+		EVERY,                          // Every index pulse resets the position to 0
+		FIRST                           // Only the first one, to home an axis once
+	};
+
+	typedef struct {
+		TIM_TypeDef *timer;             // TIM1/2/3/4/8/20
+		Index_Mode index_mode;
+		uint8_t filter;                 // ICxF on A & B, 0-15
+		uint32_t low_speed_counts;      // Counts per sample() below which edge timestamps are used
+		uint32_t stop_time;             // us without an edge before a slow encoder counts as stopped
+		volatile int32_t wraps;         // The rest is state kept by the driver
+		volatile int32_t velocity;
+		volatile bool indexed;
+		volatile uint32_t edges;
+		volatile uint32_t edge_cycles[2];       // Latest two channel 1 edges, oldest first
+		volatile int32_t edge_positions[2];
+		bool timestamping;
+		int32_t last_position;
+		uint32_t last_sample;
+		bool clocked;                   // Set while start() holds the timer clock
+	} Encoder_t;
+
+	static void start(Encoder_t &encoder);
+	static void stop(Encoder_t &encoder);
+
+	static int32_t position(const Encoder_t &encoder);
+	static int32_t velocity(const Encoder_t &encoder);
+	static bool indexed(const Encoder_t &encoder);
+	static void sample(Encoder_t &encoder);
+
+private:
+	static void set_timestamping(Encoder_t &encoder, bool enabled);
+	static void timer_callback(uint32_t events, void *context);
+};
+
+
+#endif //STM32G4_MODULE_LIBRARY_ENCODER_HH
@@ -0,0 +1,209 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_encoder.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include "../encoder.hh"
+#include "../../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+namespace {
+	// The counter moving to count & the interrupts that follows it, the mock counter doesn't count by itself
+	void move_to(TIM_TypeDef *const timer, const uint32_t count, const uint32_t flags, const IRQn_Type irq)
+	{
+		timer->CNT = count;
+		timer->SR = flags;
+		raise_IRQ(irq);
+		timer->SR = 0;
+	}
+}
+
+
+TEST_CASE("Encoder functions", "[Encoder][PERIPHERAL]")
+{
+	using Encoder = Chip::Encoder;
+	Chip::HAL::start_cycle_counter();
+	const uint32_t HCLK = Chip::Clock::frequency(Chip::Clock::Domain::HCLK);
+
+	Encoder::Encoder_t encoder = {};
+	encoder.timer = TIM3;
+	encoder.index_mode = Encoder::Index_Mode::EVERY;
+	encoder.filter = 2;
+	encoder.low_speed_counts = 8;
+	encoder.stop_time = 500000;
+	const uint8_t HELD = Chip::Clock::references(Chip::Clock::Gate::TIM3EN);
+	Encoder::start(encoder);
+	// The mock's cycle counter moves on as start() reads the RCC, so the samples are timed from 0 after it
+	DWT->CYCCNT = 0;
+	encoder.last_sample = 0;
+
+
+	SECTION("Encoder Setup") {
+		// Doc: RM0440-29.3.24-29.3.25
+		REQUIRE((TIM3->SMCR & (0b111 | (1 << 16))) == 0b011);
+		REQUIRE((TIM3->CCMR1 & 0xF3F3) == 0x2121);
+		REQUIRE((TIM3->CCER & 0xAA) == 0);
+		REQUIRE(TIM3->ARR == 0xFFFF);
+		REQUIRE((TIM3->ECR & 0b100001) == 0b1);
+		REQUIRE((TIM3->CR1 & ((1 << 11) | 1)) == ((1 << 11) | 1));
+		REQUIRE((TIM3->DIER & ((1 << 20) | 0b11111)) == ((1 << 20) | 1));
+
+		Encoder::stop(encoder);
+		REQUIRE((TIM3->SMCR & 0b111) == 0);
+		REQUIRE(TIM3->ECR == 0);
+		REQUIRE((TIM3->DIER & ((1 << 20) | 0b11111)) == 0);
+		REQUIRE(!Timer_Class::running(TIM3));
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM3EN) == HELD);
+
+		// A restart keeps one reference, & a timer that stopped by itself still gives it back
+		Encoder::start(encoder);
+		Encoder::start(encoder);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM3EN) == HELD + 1);
+		Chip::HAL::clear_register(&TIM3->CR1, 1 << 0);
+		Encoder::stop(encoder);
+		Encoder::stop(encoder);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM3EN) == HELD);
+	}
+
+
+	SECTION("Encoder Position Extension") {
+		move_to(TIM3, 1000, 0, TIM3_IRQn);
+		REQUIRE(Encoder::position(encoder) == 1000);
+
+		// Forwards past the top of the counter, before & after the update interrupt counts the wrap, then back
+		TIM3->CNT = 5 | (1u << 31);
+		REQUIRE(Encoder::position(encoder) == 65541);
+		move_to(TIM3, 5, 1, TIM3_IRQn);
+		REQUIRE(Encoder::position(encoder) == 65541);
+		move_to(TIM3, 0xFFF0, 1, TIM3_IRQn);
+		REQUIRE(Encoder::position(encoder) == 65520);
+
+		// Backwards below 0
+		move_to(TIM3, 0xFFFE, 1, TIM3_IRQn);
+		REQUIRE(Encoder::position(encoder) == -2);
+		TIM3->CNT = 0xFFFE | (1u << 31);
+		REQUIRE(Encoder::position(encoder) == -65538);
+		move_to(TIM3, 0xFFFE, 1, TIM3_IRQn);
+		REQUIRE(Encoder::position(encoder) == -65538);
+		Encoder::stop(encoder);
+	}
+
+
+	SECTION("Encoder Index") {
+		move_to(TIM3, 300, 1, TIM3_IRQn);
+		REQUIRE(Encoder::position(encoder) == 65836);
+		REQUIRE(!Encoder::indexed(encoder));
+
+		// The index zeroes the counter, the wraps counted before it go with it
+		move_to(TIM3, 0, 1 << 20, TIM3_IRQn);
+		REQUIRE(Encoder::indexed(encoder));
+		REQUIRE(Encoder::position(encoder) == 0);
+
+		// Counting down, it reloads ARR instead
+		move_to(TIM3, 0xFFFF, 1 << 20, TIM3_IRQn);
+		REQUIRE(Encoder::position(encoder) == -1);
+		Encoder::stop(encoder);
+
+		// Homing only takes the first index
+		encoder.index_mode = Encoder::Index_Mode::FIRST;
+		Encoder::start(encoder);
+		REQUIRE((TIM3->ECR & 0b100001) == 0b100001);
+		Encoder::stop(encoder);
+	}
+
+
+	SECTION("Encoder 32-Bit Counter") {
+		Encoder::stop(encoder);
+		Encoder::Encoder_t wide = {};
+		wide.timer = TIM2;
+		wide.index_mode = Encoder::Index_Mode::NONE;
+		wide.low_speed_counts = 8;
+		Encoder::start(wide);
+		REQUIRE(TIM2->ARR == UINT32_MAX);
+		REQUIRE((TIM2->CR1 & (1 << 11)) == 0);
+		REQUIRE((TIM2->DIER & ((1 << 20) | 0b11111)) == 0);
+
+		TIM2->CNT = 0xFFFFFFFE;
+		REQUIRE(Encoder::position(wide) == -2);
+		TIM2->CNT = 200000;
+		REQUIRE(Encoder::position(wide) == 200000);
+		Encoder::stop(wide);
+	}
+
+
+	SECTION("Encoder Advanced Timer Index") {
+		// TIM8 raises the index on its trigger & commutation line, not with its updates
+		Encoder::stop(encoder);
+		Encoder::Encoder_t advanced = {};
+		advanced.timer = TIM8;
+		advanced.index_mode = Encoder::Index_Mode::EVERY;
+		advanced.low_speed_counts = 8;
+		Encoder::start(advanced);
+		move_to(TIM8, 0xFFF0, 0, TIM8_UP_IRQn);
+		move_to(TIM8, 10, 1, TIM8_UP_IRQn);
+		REQUIRE(Encoder::position(advanced) == 65546);
+
+		move_to(TIM8, 0, 1 << 20, TIM8_TRG_COM_IRQn);
+		REQUIRE(Encoder::indexed(advanced));
+		REQUIRE(Encoder::position(advanced) == 0);
+		Encoder::stop(advanced);
+	}
+
+
+	SECTION("Encoder Velocity") {
+		// Fast, 1600 counts in 10 ms is plenty of counts for a plain delta
+		move_to(TIM3, 1600, 0, TIM3_IRQn);
+		DWT->CYCCNT = HCLK / 100;
+		Encoder::sample(encoder);
+		REQUIRE(Encoder::velocity(encoder) == 160000000);
+		REQUIRE((TIM3->DIER & (1 << 1)) == 0);
+
+		// Backwards is negative
+		move_to(TIM3, 800, 0, TIM3_IRQn);
+		DWT->CYCCNT = 2 * (HCLK / 100);
+		Encoder::sample(encoder);
+		REQUIRE(Encoder::velocity(encoder) == -80000000);
+
+		// Slow, 2 counts a sample turns on edge timestamps
+		move_to(TIM3, 802, 0, TIM3_IRQn);
+		DWT->CYCCNT = 3 * (HCLK / 100);
+		Encoder::sample(encoder);
+		REQUIRE((TIM3->DIER & (1 << 1)) != 0);
+
+		// Channel 1 edges 4 counts & 100 ms apart, 40 counts/s
+		const uint32_t EDGE = 4 * (HCLK / 100);
+		DWT->CYCCNT = EDGE;
+		move_to(TIM3, 804, 1 << 1, TIM3_IRQn);
+		DWT->CYCCNT = EDGE + HCLK / 10;
+		move_to(TIM3, 808, 1 << 1, TIM3_IRQn);
+		DWT->CYCCNT = EDGE + HCLK / 10 + HCLK / 100;
+		Encoder::sample(encoder);
+		REQUIRE(Encoder::velocity(encoder) == 40000);
+
+		// Waiting longer than an edge interval for the next edge bounds the velocity
+		DWT->CYCCNT = EDGE + HCLK / 10 + HCLK / 5;
+		Encoder::sample(encoder);
+		REQUIRE(Encoder::velocity(encoder) == 20000);
+
+		// No edge for longer than stop_time is stopped
+		DWT->CYCCNT = EDGE + HCLK / 10 + HCLK;
+		Encoder::sample(encoder);
+		REQUIRE(Encoder::velocity(encoder) == 0);
+
+		// Fast again, timestamps go off
+		move_to(TIM3, 2808, 0, TIM3_IRQn);
+		DWT->CYCCNT = EDGE + HCLK / 10 + HCLK + HCLK / 100;
+		Encoder::sample(encoder);
+		REQUIRE(Encoder::velocity(encoder) == 200000000);
+		REQUIRE((TIM3->DIER & (1 << 1)) == 0);
+		Encoder::stop(encoder);
+	}
+}
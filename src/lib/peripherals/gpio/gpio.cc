@@ -6,17 +6,19 @@
 // License      : MIT
 // Copyright    : (C) 2023, Liam Lawrence
 //
-// Updated      : March 5, 2023
+// Updated      : October 19, 2026
 //------------------------------------------------------------------------------
 
-// TODO: Add logging
-// TODO: Doc: R0440-9.3.15-9.3.16 | Warning logged if user is using pin PB8 (boot) or PG10 (reset)
-
 #include "gpio.hh"
 #include "../../chip/stm32g491/stm32g491_chip.hh"
 
 
 
+uint16_t GPIO_Class::configured_pins[NUM_PORTS] = {};
+uint8_t GPIO_Class::clock_requests[NUM_PORTS] = {};
+
+
+
 /*
  * GPIO pin I/O functions
  */
@@ -87,8 +89,29 @@ void GPIO_Class::set_mode(const GPIO_Pin_t GPIO_Pin, const Pin_Mode mode)
 	const uint_fast8_t FIELD_WIDTH = 2;
 	constexpr uint32_t FIELD_MASK = Chip::HAL::generate_bitmask(FIELD_WIDTH);
 
+	// Doc: RM0440-9.4.1 | Analog is the reset state, the port clock is held while any of its pins is out of it
+	const uint_fast8_t PORT = port_index(GPIO_Pin.port);
+	const uint16_t PIN_MASK = static_cast<uint16_t>(1 << GPIO_Pin.number);
+	const uint32_t primask = Chip::HAL::enter_critical();
+	const uint16_t previous_pins = configured_pins[PORT];
+	configured_pins[PORT] = (mode == Pin_Mode::ANALOG) ? static_cast<uint16_t>(previous_pins & ~PIN_MASK)
+	                                                   : static_cast<uint16_t>(previous_pins | PIN_MASK);
+
+	if (previous_pins == 0 && configured_pins[PORT] != 0) {
+		Chip::Clock::acquire(clock_gate(GPIO_Pin.port));
+	}
 	Chip::HAL::clear_register(REGISTER, FIELD_MASK << (GPIO_Pin.number * FIELD_WIDTH));
 	Chip::HAL::set_register(REGISTER, static_cast<uint32_t>(mode) << (GPIO_Pin.number * FIELD_WIDTH));
+	if (previous_pins != 0 && configured_pins[PORT] == 0) {
+		Chip::Clock::release(clock_gate(GPIO_Pin.port));
+	}
+	Chip::HAL::exit_critical(primask);
+
+	// Doc: RM0440-9.3.15-9.3.16 | PB8 is also BOOT0 & PG10 is also NRST, which the option bytes decide between
+	if (mode != Pin_Mode::ANALOG && ((GPIO_Pin.port == GPIOB && GPIO_Pin.number == 8)
+	                                 || (GPIO_Pin.port == GPIOG && GPIO_Pin.number == 10))) {
+		CHIP_LOG("GPIO: P%c%u shares BOOT0 or NRST, check the option bytes", 'A' + PORT, GPIO_Pin.number);
+	}
 }
 
 
@@ -146,34 +169,27 @@ void GPIO_Class::set_alternate_function(GPIO_Pin_t GPIO_Pin, Pin_AF af)
  */
 void GPIO_Class::set_port_clock(GPIO_TypeDef *const port, const GPIO_Class::Clock_Status clock_status)
 {
-	// Doc: RM0440-7.4.15
-	volatile uint32_t *const REGISTER = &RCC->AHB2ENR;
-	const uint_fast8_t FIELD_WIDTH = 1;
-	constexpr uint32_t FIELD_MASK = Chip::HAL::generate_bitmask(FIELD_WIDTH);
-	uint16_t field_position = 0;
-
-	if (port == GPIOA) {
-		field_position = 0;
-	} else if (port == GPIOB) {
-		field_position = 1;
-	} else if (port == GPIOC) {
-		field_position = 2;
-	} else if (port == GPIOD) {
-		field_position = 3;
-	} else if (port == GPIOE) {
-		field_position = 4;
-	} else if (port == GPIOF) {
-		field_position = 5;
-	} else if (port == GPIOG) {
-		field_position = 6;
-	}
-
+	// Only the references taken here are given back here, the configured pins hold their own
+	const uint_fast8_t PORT = port_index(port);
+	const uint32_t primask = Chip::HAL::enter_critical();
 	switch (clock_status) {
 		case Clock_Status::ENABLED:
-			Chip::HAL::set_register(REGISTER, FIELD_MASK << (field_position * FIELD_WIDTH));
+			clock_requests[PORT]++;
+			Chip::Clock::acquire(clock_gate(port));
 			break;
 		case Clock_Status::DISABLED:
-			Chip::HAL::clear_register(REGISTER, FIELD_MASK << (field_position * FIELD_WIDTH));
+			if (clock_requests[PORT] != 0) {
+				clock_requests[PORT]--;
+				Chip::Clock::release(clock_gate(port));
+			}
 			break;
 	}
+	Chip::HAL::exit_critical(primask);
+}
+
+
+Chip::Clock::Gate GPIO_Class::clock_gate(const GPIO_TypeDef *const port)
+{
+	// Doc: RM0440-7.4.15 | GPIOAEN-GPIOGEN are bits 0-6, in port order
+	return static_cast<Chip::Clock::Gate>(static_cast<uint8_t>(Chip::Clock::Gate::GPIOAEN) + port_index(port));
 }
@@ -6,13 +6,14 @@
 // License      : MIT
 // Copyright    : (C) 2023, Liam Lawrence
 //
-// Updated      : February 25, 2023
+// Updated      : October 19, 2026
 //------------------------------------------------------------------------------
 
 #ifndef STM32G4_MODULE_LIBRARY_GPIO_HH
 #define STM32G4_MODULE_LIBRARY_GPIO_HH
 
 #include <cstdint>
+#include "../../chip/stm32g491/stm32g491_clock.hh"
 
 #ifdef UNIT_TEST
 #include "../../chip/stm32g491/stm32g491_mock.hh"
@@ -79,11 +80,44 @@ public:
 		ENABLED = 0b1,
 	};
 
+	enum class Port : uint8_t {
+		// Doc: RM0440-9.3.4
+		A = 0,
+		B = 1,
+		C = 2,
+		D = 3,
+		E = 4,
+		F = 5,
+		G = 6
+	};
+
 	typedef struct {
 		GPIO_TypeDef *port;     // Doc: RM0440-9.3.4 | A, B, C, D, E, F, & G
 		uint16_t number;        // Doc: RM0440-9.3.3 | 0-15
 	} GPIO_Pin_t;
 
+	// One byte pin identifier for pin tables, port index in the high nibble & pin number in the low nibble.
+	// Converts to GPIO_Pin_t, so it can be passed to every GPIO_Class function.
+	class PinId {
+	public:
+		constexpr PinId(const Port port, const uint16_t number)
+			: id(static_cast<uint8_t>((static_cast<uint8_t>(port) << 4) | (number & 0x0F))) {}
+		explicit PinId(const GPIO_Pin_t GPIO_Pin)
+			: id(static_cast<uint8_t>((GPIO_Class::port_index(GPIO_Pin.port) << 4) | (GPIO_Pin.number & 0x0F))) {}
+
+		constexpr Port port_index() const { return static_cast<Port>(id >> 4); }
+		constexpr uint16_t number() const { return id & 0x0F; }
+		constexpr uint8_t raw() const { return id; }
+		GPIO_TypeDef *port() const { return GPIO_Class::port(port_index()); }
+
+		operator GPIO_Pin_t() const { return {.port=port(), .number=number()}; }
+		constexpr bool operator==(const PinId other) const { return id == other.id; }
+		constexpr bool operator!=(const PinId other) const { return id != other.id; }
+
+	private:
+		uint8_t id;
+	};
+
 	static uint16_t read(GPIO_Pin_t GPIO_Pin);
 	static void set(GPIO_Pin_t GPIO_Pin);
 	static void clear(GPIO_Pin_t GPIO_Pin);
@@ -94,10 +128,38 @@ public:
 	static void set_pupd(GPIO_Pin_t GPIO_Pin, Pin_PUPD pupd);
 	static void set_alternate_function(GPIO_Pin_t GPIO_Pin, Pin_AF af);
 
+	// Pins hold their port's clock while they are out of analog mode, so set_port_clock is only needed to keep a
+	// port clocked without configuring a pin. Every ENABLED must be matched by a DISABLED, an unmatched DISABLED is
+	// ignored so it can't take the reference a configured pin holds.
 	static void set_port_clock(GPIO_TypeDef *port, GPIO_Class::Clock_Status clock_status);
+	static Chip::Clock::Gate clock_gate(const GPIO_TypeDef *port);
+
+	// Doc: RM0440-2.2.2 | The port register blocks are evenly spaced from GPIOA, so ports are found by arithmetic
+	static GPIO_TypeDef *port(const Port index)
+	{
+		return reinterpret_cast<GPIO_TypeDef *>(reinterpret_cast<uintptr_t>(GPIOA)
+		                                        + static_cast<uintptr_t>(index) * PORT_STRIDE);
+	}
+
+	static uint_fast8_t port_index(const GPIO_TypeDef *const port)
+	{
+		return static_cast<uint_fast8_t>((reinterpret_cast<uintptr_t>(port) - reinterpret_cast<uintptr_t>(GPIOA))
+		                                 / PORT_STRIDE);
+	}
 
 private:
+	static constexpr uint_fast8_t NUM_PORTS = 7;
+	static uint16_t configured_pins[NUM_PORTS];
+	static uint8_t clock_requests[NUM_PORTS];
+
+#ifdef UNIT_TEST
+	static constexpr uintptr_t PORT_STRIDE = sizeof(GPIO_TypeDef);
+#else
+	static constexpr uintptr_t PORT_STRIDE = GPIOB_BASE - GPIOA_BASE;
+#endif
 };
 
+static_assert(sizeof(GPIO_Class::PinId) == 1, "PinId must pack into one byte");
+
 
 #endif //STM32G4_MODULE_LIBRARY_GPIO_HH
@@ -6,7 +6,7 @@
 // License      : MIT
 // Copyright    : (C) 2023, Liam Lawrence
 //
-// Updated      : February 25, 2023
+// Updated      : October 19, 2026
 //------------------------------------------------------------------------------
 
 #include <catch2/catch_test_macros.hpp>
@@ -29,13 +29,25 @@ TEST_CASE("GPIO functions", "[GPIO][PERIPHERAL]")
 		uint32_t *const REGISTER = &RCC->AHB2ENR;
 		const uint_fast8_t FIELD_WIDTH = 1;
 
+		// Pins configured by earlier sections hold the port clock, so disabling only drops this reference
+		const uint8_t HELD = Chip::Clock::references(GPIO::clock_gate(test_pin.port));
+
 		GPIO::set_port_clock(test_pin.port, GPIO::Clock_Status::ENABLED);
 		field = Chip::HAL::read_field(REGISTER, port2int(test_pin.port), FIELD_WIDTH);
 		REQUIRE(field == static_cast<uint32_t>(GPIO::Clock_Status::ENABLED));
 
 		GPIO::set_port_clock(test_pin.port, GPIO::Clock_Status::DISABLED);
 		field = Chip::HAL::read_field(REGISTER, port2int(test_pin.port), FIELD_WIDTH);
-		REQUIRE(field == static_cast<uint32_t>(GPIO::Clock_Status::DISABLED));
+		REQUIRE(field == static_cast<uint32_t>((HELD != 0) ? GPIO::Clock_Status::ENABLED : GPIO::Clock_Status::DISABLED));
+		REQUIRE(Chip::Clock::references(GPIO::clock_gate(test_pin.port)) == HELD);
+
+		// A DISABLED with no ENABLED before it leaves a configured pin's reference alone
+		GPIO::set_mode(test_pin, GPIO::Pin_Mode::OUTPUT);
+		const uint8_t CONFIGURED = Chip::Clock::references(GPIO::clock_gate(test_pin.port));
+		GPIO::set_port_clock(test_pin.port, GPIO::Clock_Status::DISABLED);
+		REQUIRE(Chip::Clock::references(GPIO::clock_gate(test_pin.port)) == CONFIGURED);
+		REQUIRE(Chip::Clock::is_running(GPIO::clock_gate(test_pin.port)));
+		GPIO::set_mode(test_pin, GPIO::Pin_Mode::ANALOG);
 	}
 
 
@@ -140,4 +152,71 @@ TEST_CASE("GPIO functions", "[GPIO][PERIPHERAL]")
 				return;
 		}
 	}
+
+	SECTION("GPIO Packed Pin IDs") {
+		GPIO::GPIO_Pin_t test_pin = {.port=gpio_ports, .number=static_cast<uint16_t>(pin_numbers)};
+		const GPIO::PinId PIN_ID(test_pin);
+
+		REQUIRE(static_cast<uint16_t>(PIN_ID.port_index()) == port2int(test_pin.port));
+		REQUIRE(PIN_ID.number() == test_pin.number);
+		REQUIRE(PIN_ID.port() == test_pin.port);
+		REQUIRE(PIN_ID.raw() == ((port2int(test_pin.port) << 4) | test_pin.number));
+		REQUIRE(PIN_ID == GPIO::PinId(PIN_ID.port_index(), test_pin.number));
+
+		// PinIds go straight into the GPIO_Pin_t functions
+		GPIO::set_mode(PIN_ID, GPIO::Pin_Mode::OUTPUT);
+		GPIO::set(PIN_ID);
+		update_GPIO_BSRR();
+		REQUIRE(GPIO::read(test_pin) == 1);
+		GPIO::clear(PIN_ID);
+		update_GPIO_BSRR();
+		REQUIRE(GPIO::read(PIN_ID) == 0);
+	}
+}
+
+
+TEST_CASE("GPIO pin tables", "[GPIO][PERIPHERAL]")
+{
+	using GPIO = Chip::GPIO;
+	using Port = GPIO::Port;
+
+	// A board table is one byte per pin & can be built at compile time
+	constexpr GPIO::PinId BOARD_PINS[] = {
+		{Port::A, 5}, {Port::B, 0}, {Port::C, 13}, {Port::G, 10}, {Port::F, 15}
+	};
+	static_assert(sizeof(BOARD_PINS) == 5, "PinId tables are one byte per pin");
+	static_assert(BOARD_PINS[2].port_index() == Port::C && BOARD_PINS[2].number() == 13, "");
+
+	GPIO_TypeDef *const EXPECTED_PORTS[] = {GPIOA, GPIOB, GPIOC, GPIOG, GPIOF};
+	for (uint_fast8_t i = 0; i < 5; i++) {
+		const GPIO::GPIO_Pin_t PIN = BOARD_PINS[i];
+		REQUIRE(PIN.port == EXPECTED_PORTS[i]);
+		REQUIRE(PIN.number == BOARD_PINS[i].number());
+		REQUIRE(GPIO::port_index(PIN.port) == static_cast<uint_fast8_t>(BOARD_PINS[i].port_index()));
+	}
+}
+
+
+TEST_CASE("GPIO port clock gating", "[GPIO][PERIPHERAL]")
+{
+	using GPIO = Chip::GPIO;
+	using Port = GPIO::Port;
+
+	// The port clock follows the pins that are out of analog mode
+	const GPIO::GPIO_Pin_t PIN_0 = GPIO::PinId(Port::D, 0);
+	const GPIO::GPIO_Pin_t PIN_1 = GPIO::PinId(Port::D, 1);
+	for (uint16_t pin = 0; pin < 16; pin++) {
+		GPIO::set_mode({.port=GPIOD, .number=pin}, GPIO::Pin_Mode::ANALOG);
+	}
+	REQUIRE(!Chip::Clock::is_running(Chip::Clock::Gate::GPIODEN));
+
+	GPIO::set_mode(PIN_0, GPIO::Pin_Mode::OUTPUT);
+	GPIO::set_mode(PIN_1, GPIO::Pin_Mode::INPUT);
+	GPIO::set_mode(PIN_1, GPIO::Pin_Mode::OUTPUT);
+	REQUIRE(Chip::Clock::references(Chip::Clock::Gate::GPIODEN) == 1);
+
+	GPIO::set_mode(PIN_0, GPIO::Pin_Mode::ANALOG);
+	REQUIRE(Chip::Clock::is_running(Chip::Clock::Gate::GPIODEN));
+	GPIO::set_mode(PIN_1, GPIO::Pin_Mode::ANALOG);
+	REQUIRE(!Chip::Clock::is_running(Chip::Clock::Gate::GPIODEN));
 }
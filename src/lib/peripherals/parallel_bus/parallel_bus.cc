@@ -0,0 +1,265 @@
+//------------------------------------------------------------------------------
+// File Name    : parallel_bus.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "parallel_bus.hh"
+#include "../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+/*
+ * Parallel bus helpers
+ */
+// Doc: RM0440-9.4.7 | A whole-word store, every bus cycle goes through here
+inline void Parallel_Bus_Class::store(GPIO_TypeDef *const port, const uint32_t value)
+{
+	Chip::HAL::write_register(&port->BSRR, value);
+}
+
+
+uint16_t Parallel_Bus_Class::data_mask(const Bus_t &bus)
+{
+	const uint16_t width = static_cast<uint16_t>(bus.width);
+	return static_cast<uint16_t>(Chip::HAL::generate_bitmask(width) << bus.data_shift);
+}
+
+
+inline uint32_t Parallel_Bus_Class::data_word(const uint16_t value, const uint16_t shift, const uint16_t mask)
+{
+	return Waveform_Class::bsrr_word(static_cast<uint16_t>(value << shift), mask);
+}
+
+
+uint32_t Parallel_Bus_Class::assert_strobe(const Bus_t &bus)
+{
+	// 8080 /WR falls, 6800 E rises
+	const uint32_t PIN = 1u << bus.write_strobe.number;
+	return (bus.protocol == Protocol::INTEL_8080) ? (PIN << 16) : PIN;
+}
+
+
+uint32_t Parallel_Bus_Class::release_strobe(const Bus_t &bus)
+{
+	// 8080 /WR rises, 6800 E falls, this is the edge that latches the data
+	const uint32_t PIN = 1u << bus.write_strobe.number;
+	return (bus.protocol == Protocol::INTEL_8080) ? PIN : (PIN << 16);
+}
+
+
+bool Parallel_Bus_Class::on_data_pins(const Bus_t &bus, const GPIO_Class::GPIO_Pin_t &pin)
+{
+	return pin.port == bus.data_port && (data_mask(bus) & (1u << pin.number)) != 0;
+}
+
+
+// The IDR read that is kept comes after read_setup others, so the device has had its access time to drive the bus
+uint16_t Parallel_Bus_Class::sample_data(const Bus_t &bus)
+{
+	for (uint16_t i = 0; i < bus.read_setup; i++) {
+		(void) Chip::HAL::read_register(&bus.data_port->IDR);
+	}
+	return static_cast<uint16_t>(Chip::HAL::read_register(&bus.data_port->IDR));
+}
+
+
+
+/*
+ * Parallel bus functions
+ */
+// Returns false when the data pins don't fit the port or a control pin is one of them or another control pin
+bool Parallel_Bus_Class::init(const Bus_t &bus)
+{
+	using GPIO = GPIO_Class;
+	const GPIO::GPIO_Pin_t CONTROL_PINS[] = {bus.write_strobe, bus.read_strobe, bus.data_command};
+	if (bus.data_shift + static_cast<uint16_t>(bus.width) > 16) {
+		return false;
+	}
+	for (uint_fast8_t i = 0; i < 3; i++) {
+		if (on_data_pins(bus, CONTROL_PINS[i])) {
+			return false;
+		}
+		for (uint_fast8_t j = 0; j < i; j++) {
+			if (CONTROL_PINS[i].port == CONTROL_PINS[j].port && CONTROL_PINS[i].number == CONTROL_PINS[j].number) {
+				return false;
+			}
+		}
+	}
+
+	// Configuring the pins enables their port clocks
+	for (uint16_t pin = bus.data_shift; pin < bus.data_shift + static_cast<uint16_t>(bus.width); pin++) {
+		GPIO::GPIO_Pin_t data_pin = {.port=bus.data_port, .number=pin};
+		GPIO::set_mode(data_pin, GPIO::Pin_Mode::OUTPUT);
+		GPIO::set_ospeed(data_pin, GPIO::Pin_OSpeed::VERY_HIGH_SPEED);
+	}
+
+	// Idle levels: 8080 /WR & /RD high, 6800 E low & R/W low (write)
+	for (auto pin: CONTROL_PINS) {
+		GPIO::set_mode(pin, GPIO::Pin_Mode::OUTPUT);
+		GPIO::set_ospeed(pin, GPIO::Pin_OSpeed::VERY_HIGH_SPEED);
+	}
+	store(bus.write_strobe.port, release_strobe(bus));
+	if (bus.protocol == Protocol::INTEL_8080) {
+		store(bus.read_strobe.port, 1u << bus.read_strobe.number);
+	} else {
+		store(bus.read_strobe.port, 1u << (bus.read_strobe.number + 16));
+	}
+	return true;
+}
+
+
+void Parallel_Bus_Class::write_command(const Bus_t &bus, const uint16_t command)
+{
+	store(bus.data_command.port, 1u << (bus.data_command.number + 16));
+	write_words(bus, &command, 1);
+}
+
+
+void Parallel_Bus_Class::write_data(const Bus_t &bus, const uint16_t data)
+{
+	store(bus.data_command.port, 1u << bus.data_command.number);
+	write_words(bus, &data, 1);
+}
+
+
+void Parallel_Bus_Class::write_block(const Bus_t &bus, const uint16_t *const data, const uint32_t length)
+{
+	store(bus.data_command.port, 1u << bus.data_command.number);
+	write_words(bus, data, length);
+}
+
+
+void Parallel_Bus_Class::write_block(const Bus_t &bus, const uint8_t *const data, const uint32_t length)
+{
+	store(bus.data_command.port, 1u << bus.data_command.number);
+	write_words(bus, data, length);
+}
+
+
+uint16_t Parallel_Bus_Class::read_data(const Bus_t &bus)
+{
+	// Doc: RM0440-9.4.1 | Turn the whole data field around to input at once, MODER is 2 bits per pin
+	volatile uint32_t *const MODE_REG = &bus.data_port->MODER;
+	const uint_fast8_t FIELD_WIDTH = 2;
+	const uint16_t WIDTH = static_cast<uint16_t>(bus.width);
+	const uint32_t FIELD_MASK = (WIDTH == 16) ? UINT32_MAX
+		: Chip::HAL::generate_bitmask(WIDTH * FIELD_WIDTH) << (bus.data_shift * FIELD_WIDTH);
+	const uint32_t OUTPUT_MODE = 0x55555555 & FIELD_MASK;
+
+	Chip::HAL::clear_register(MODE_REG, FIELD_MASK);
+	store(bus.data_command.port, 1u << bus.data_command.number);
+
+	uint16_t value;
+	if (bus.protocol == Protocol::INTEL_8080) {
+		// Data is valid while /RD is low
+		store(bus.read_strobe.port, 1u << (bus.read_strobe.number + 16));
+		value = sample_data(bus);
+		store(bus.read_strobe.port, 1u << bus.read_strobe.number);
+	} else {
+		// R/W high selects a read, data is valid while E is high
+		store(bus.read_strobe.port, 1u << bus.read_strobe.number);
+		store(bus.write_strobe.port, assert_strobe(bus));
+		value = sample_data(bus);
+		store(bus.write_strobe.port, release_strobe(bus));
+		store(bus.read_strobe.port, 1u << (bus.read_strobe.number + 16));
+	}
+
+	Chip::HAL::set_register(MODE_REG, OUTPUT_MODE);
+	return static_cast<uint16_t>((value & data_mask(bus)) >> bus.data_shift);
+}
+
+
+template<typename T>
+void Parallel_Bus_Class::write_words(const Bus_t &bus, const T *data, uint32_t length)
+{
+	GPIO_TypeDef *const DATA_PORT = bus.data_port;
+	GPIO_TypeDef *const STROBE_PORT = bus.write_strobe.port;
+	const uint16_t SHIFT = bus.data_shift;
+	const uint16_t MASK = data_mask(bus);
+	const uint32_t ASSERT = assert_strobe(bus);
+	const uint32_t RELEASE = release_strobe(bus);
+
+	if (STROBE_PORT == DATA_PORT) {
+		// Data & strobe edge share one store, the releasing store latches it
+		while (length >= 4) {
+			store(DATA_PORT, data_word(data[0], SHIFT, MASK) | ASSERT);
+			store(DATA_PORT, RELEASE);
+			store(DATA_PORT, data_word(data[1], SHIFT, MASK) | ASSERT);
+			store(DATA_PORT, RELEASE);
+			store(DATA_PORT, data_word(data[2], SHIFT, MASK) | ASSERT);
+			store(DATA_PORT, RELEASE);
+			store(DATA_PORT, data_word(data[3], SHIFT, MASK) | ASSERT);
+			store(DATA_PORT, RELEASE);
+			data += 4;
+			length -= 4;
+		}
+		while (length--) {
+			store(DATA_PORT, data_word(*data++, SHIFT, MASK) | ASSERT);
+			store(DATA_PORT, RELEASE);
+		}
+	} else {
+		while (length >= 4) {
+			store(DATA_PORT, data_word(data[0], SHIFT, MASK));
+			store(STROBE_PORT, ASSERT);
+			store(STROBE_PORT, RELEASE);
+			store(DATA_PORT, data_word(data[1], SHIFT, MASK));
+			store(STROBE_PORT, ASSERT);
+			store(STROBE_PORT, RELEASE);
+			store(DATA_PORT, data_word(data[2], SHIFT, MASK));
+			store(STROBE_PORT, ASSERT);
+			store(STROBE_PORT, RELEASE);
+			store(DATA_PORT, data_word(data[3], SHIFT, MASK));
+			store(STROBE_PORT, ASSERT);
+			store(STROBE_PORT, RELEASE);
+			data += 4;
+			length -= 4;
+		}
+		while (length--) {
+			store(DATA_PORT, data_word(*data++, SHIFT, MASK));
+			store(STROBE_PORT, ASSERT);
+			store(STROBE_PORT, RELEASE);
+		}
+	}
+}
+
+
+
+/*
+ * Parallel bus DMA functions
+ */
+// Encodes a block as BSRR words for the waveform engine, two words per bus cycle.
+// Only possible when the write strobe is on the data port, returns the number of words written or 0.
+uint32_t Parallel_Bus_Class::encode_block(const Bus_t &bus, const uint16_t *const data, const uint32_t length,
+                                          uint32_t *const buffer)
+{
+	if (bus.write_strobe.port != bus.data_port) {
+		return 0;
+	}
+
+	const uint16_t SHIFT = bus.data_shift;
+	const uint16_t MASK = data_mask(bus);
+	const uint32_t ASSERT = assert_strobe(bus);
+	const uint32_t RELEASE = release_strobe(bus);
+	for (uint32_t i = 0; i < length; i++) {
+		buffer[2 * i] = data_word(data[i], SHIFT, MASK) | ASSERT;
+		buffer[2 * i + 1] = RELEASE;
+	}
+	return 2 * length;
+}
+
+
+// Plays a block from encode_block() at the timer's update rate, two update events per bus cycle.
+// Returns false when something else holds the waveform's DMA channel
+bool Parallel_Bus_Class::write_block_dma(const Bus_t &bus, Waveform_Class::Waveform_t &waveform,
+                                         const uint32_t *const buffer, const uint16_t length, const uint16_t prescaler,
+                                         const uint32_t auto_reload)
+{
+	store(bus.data_command.port, 1u << bus.data_command.number);
+	return Waveform_Class::start(waveform, buffer, length, Waveform_Class::Playback::ONE_SHOT, prescaler, auto_reload);
+}
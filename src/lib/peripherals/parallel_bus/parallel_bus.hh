@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+// File Name    : parallel_bus.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_PARALLEL_BUS_HH
+#define STM32G4_MODULE_LIBRARY_PARALLEL_BUS_HH
+
+#include <cstdint>
+#include "../gpio/gpio.hh"
+#include "../waveform/waveform.hh"
+
+#ifdef UNIT_TEST
+#include "../../chip/stm32g491/stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+// 8080/6800 style parallel bus, the kind used by TFT panel controllers.
+// The data bus sits on consecutive pins of one port and each word is put on it with a single BSRR store.
+// When the write strobe shares the data port, the data and the strobe edge go out in the same store,
+// so a bus cycle costs two stores instead of three.
+class Parallel_Bus_Class {
+public:
+	enum class Protocol {
+		INTEL_8080,         // Data latched on the rising edge of /WR, /RD active low
+		MOTOROLA_6800       // Data latched on the falling edge of E, R/W low for writes
+	};
+
+	enum class Bus_Width {
+		BITS_8 = 8,
+		BITS_16 = 16
+	};
+
+	typedef struct {
+		GPIO_TypeDef *data_port;
+		uint16_t data_shift;                    // First data pin, 0 or 8 for an 8-bit bus, 0 for a 16-bit bus
+		Bus_Width width;
+		Protocol protocol;
+		GPIO_Class::GPIO_Pin_t write_strobe;    // 8080 /WR, 6800 E
+		GPIO_Class::GPIO_Pin_t read_strobe;     // 8080 /RD, 6800 R/W
+		GPIO_Class::GPIO_Pin_t data_command;    // D/C (RS), high selects data
+		uint16_t read_setup;                    // Extra data port reads with the read strobe active before the
+		                                        // one kept, each a GPIO bus access, to cover the access time
+	} Bus_t;
+
+	static bool init(const Bus_t &bus);
+
+	static void write_command(const Bus_t &bus, uint16_t command);
+	static void write_data(const Bus_t &bus, uint16_t data);
+	static void write_block(const Bus_t &bus, const uint16_t *data, uint32_t length);
+	static void write_block(const Bus_t &bus, const uint8_t *data, uint32_t length);
+	static uint16_t read_data(const Bus_t &bus);
+
+	static uint32_t encode_block(const Bus_t &bus, const uint16_t *data, uint32_t length, uint32_t *buffer);
+	static bool write_block_dma(const Bus_t &bus, Waveform_Class::Waveform_t &waveform, const uint32_t *buffer,
+	                            uint16_t length, uint16_t prescaler, uint32_t auto_reload);
+
+private:
+	static inline void store(GPIO_TypeDef *port, uint32_t value);
+	static uint16_t data_mask(const Bus_t &bus);
+	static inline uint32_t data_word(uint16_t value, uint16_t shift, uint16_t mask);
+	static uint32_t assert_strobe(const Bus_t &bus);
+	static uint32_t release_strobe(const Bus_t &bus);
+	static bool on_data_pins(const Bus_t &bus, const GPIO_Class::GPIO_Pin_t &pin);
+	static uint16_t sample_data(const Bus_t &bus);
+
+	template<typename T>
+	static void write_words(const Bus_t &bus, const T *data, uint32_t length);
+};
+
+
+#endif //STM32G4_MODULE_LIBRARY_PARALLEL_BUS_HH
@@ -0,0 +1,288 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_parallel_bus.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <vector>
+#include "../parallel_bus.hh"
+#include "../../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+namespace {
+	using Bus = Chip::Parallel_Bus;
+
+	typedef struct {
+		uint16_t data_command;
+		uint16_t value;
+	} Transaction_t;
+
+	GPIO_TypeDef *const PORTS[] = {GPIOA, GPIOB, GPIOC, GPIOD, GPIOE, GPIOF, GPIOG};
+	uint32_t initial_levels[7] = {};
+
+	// Mock port registers as a test found them
+	typedef struct {
+		uint32_t moder;
+		uint32_t odr;
+		uint32_t idr;
+	} Saved_Port_t;
+
+	void save_ports(Saved_Port_t (&saved)[7])
+	{
+		for (uint_fast8_t i = 0; i < 7; i++) {
+			saved[i] = {.moder=PORTS[i]->MODER, .odr=PORTS[i]->ODR, .idr=PORTS[i]->IDR};
+		}
+	}
+
+	// Returns every pin to analog, dropping the port clock references init() took, then puts the registers back
+	void restore_ports(const Saved_Port_t (&saved)[7])
+	{
+		for (uint_fast8_t i = 0; i < 7; i++) {
+			for (uint16_t pin = 0; pin < 16; pin++) {
+				Chip::GPIO::set_mode({.port=PORTS[i], .number=pin}, Chip::GPIO::Pin_Mode::ANALOG);
+			}
+			PORTS[i]->MODER = saved[i].moder;
+			PORTS[i]->ODR = saved[i].odr;
+			PORTS[i]->IDR = saved[i].idr;
+		}
+	}
+
+	// Snapshots the pin levels and clears the mock's BSRR log, so only bus cycles after this are decoded
+	void begin_decode()
+	{
+		for (uint_fast8_t i = 0; i < 7; i++) {
+			initial_levels[i] = PORTS[i]->ODR;
+		}
+		mock_GPIO_num_writes = 0;
+	}
+
+	// Replays the mock's BSRR log and returns what a bus device would have latched
+	std::vector<Transaction_t> decode_bus(const Bus::Bus_t &bus)
+	{
+		std::vector<Transaction_t> transactions;
+		uint32_t odr[7] = {};
+		for (uint_fast8_t i = 0; i < 7; i++) {
+			odr[i] = initial_levels[i];
+		}
+		const uint16_t MASK = static_cast<uint16_t>(((1u << static_cast<uint16_t>(bus.width)) - 1) << bus.data_shift);
+
+		for (uint32_t i = 0; i < mock_GPIO_num_writes; i++) {
+			const Mock_GPIO_Write_t &write = mock_GPIO_writes[i];
+			uint32_t &level = odr[port2int(write.port)];
+			const uint32_t before = level;
+			level = (level & ~(write.bsrr >> 16)) | (write.bsrr & 0xFFFF);
+
+			if (write.port != bus.write_strobe.port) {
+				continue;
+			}
+			const uint32_t STROBE = 1u << bus.write_strobe.number;
+			const bool latched = (bus.protocol == Bus::Protocol::INTEL_8080)
+				? (!(before & STROBE) && (level & STROBE))
+				: ((before & STROBE) && !(level & STROBE));
+			if (latched) {
+				const uint32_t data = odr[port2int(bus.data_port)];
+				const uint32_t dc = odr[port2int(bus.data_command.port)] >> bus.data_command.number;
+				transactions.push_back({.data_command=static_cast<uint16_t>(dc & 1),
+				                        .value=static_cast<uint16_t>((data & MASK) >> bus.data_shift)});
+			}
+		}
+		return transactions;
+	}
+}
+
+
+TEST_CASE("Parallel bus functions", "[Parallel_Bus][PERIPHERAL]")
+{
+	// 8-bit 8080 bus on PA0-PA7 with the strobes on the same port
+	const Bus::Bus_t BUS_8080 = {
+		.data_port=GPIOA, .data_shift=0, .width=Bus::Bus_Width::BITS_8, .protocol=Bus::Protocol::INTEL_8080,
+		.write_strobe={.port=GPIOA, .number=8}, .read_strobe={.port=GPIOA, .number=9},
+		.data_command={.port=GPIOA, .number=10}, .read_setup=0
+	};
+
+	// 16-bit 6800 bus on PE0-PE15 with the strobes on GPIOB
+	const Bus::Bus_t BUS_6800 = {
+		.data_port=GPIOE, .data_shift=0, .width=Bus::Bus_Width::BITS_16, .protocol=Bus::Protocol::MOTOROLA_6800,
+		.write_strobe={.port=GPIOB, .number=0}, .read_strobe={.port=GPIOB, .number=1},
+		.data_command={.port=GPIOB, .number=2}, .read_setup=0
+	};
+
+	Saved_Port_t saved[7];
+	save_ports(saved);
+	mock_GPIO_num_writes = 0;
+	mock_GPIO_logging = true;
+
+
+	SECTION("Parallel Bus 8080 Writes") {
+		const uint8_t PIXELS[] = {0x11, 0x22, 0x33, 0x44, 0x55, 0xAA, 0xFF};
+		REQUIRE(Bus::init(BUS_8080));
+		REQUIRE((GPIOA->ODR & (1 << 8)) != 0);
+		begin_decode();
+
+		Bus::write_command(BUS_8080, 0x2C);
+		Bus::write_block(BUS_8080, PIXELS, sizeof(PIXELS));
+
+		const auto transactions = decode_bus(BUS_8080);
+		REQUIRE(transactions.size() == 1 + sizeof(PIXELS));
+		REQUIRE(transactions[0].data_command == 0);
+		REQUIRE(transactions[0].value == 0x2C);
+		for (uint32_t i = 0; i < sizeof(PIXELS); i++) {
+			REQUIRE(transactions[i + 1].data_command == 1);
+			REQUIRE(transactions[i + 1].value == PIXELS[i]);
+		}
+
+		// Data & strobe share a store, so each bus cycle costs two stores
+		uint32_t start = mock_GPIO_num_writes;
+		Bus::write_block(BUS_8080, PIXELS, 4);
+		REQUIRE(mock_GPIO_num_writes - start == 1 + 2 * 4);
+	}
+
+
+	SECTION("Parallel Bus 6800 Writes") {
+		const uint16_t PIXELS[] = {0xF800, 0x07E0, 0x001F, 0xFFFF, 0x0000};
+		REQUIRE(Bus::init(BUS_6800));
+		REQUIRE((GPIOB->ODR & 0b011) == 0);
+		begin_decode();
+
+		Bus::write_data(BUS_6800, 0x1234);
+		Bus::write_block(BUS_6800, PIXELS, 5);
+
+		const auto transactions = decode_bus(BUS_6800);
+		REQUIRE(transactions.size() == 6);
+		REQUIRE(transactions[0].value == 0x1234);
+		for (uint32_t i = 0; i < 5; i++) {
+			REQUIRE(transactions[i + 1].data_command == 1);
+			REQUIRE(transactions[i + 1].value == PIXELS[i]);
+		}
+	}
+
+
+	SECTION("Parallel Bus Reads") {
+		REQUIRE(Bus::init(BUS_6800));
+		GPIOE->IDR = 0xBEEF;
+		REQUIRE(Bus::read_data(BUS_6800) == 0xBEEF);
+		REQUIRE(GPIOE->MODER == 0x55555555);
+		REQUIRE((GPIOB->ODR & 0b011) == 0);
+
+		// The high byte of the port, giving a slow device 3 more reads to drive the bus
+		const Bus::Bus_t BUS_HIGH_BYTE = {
+			.data_port=GPIOC, .data_shift=8, .width=Bus::Bus_Width::BITS_8, .protocol=Bus::Protocol::INTEL_8080,
+			.write_strobe={.port=GPIOC, .number=0}, .read_strobe={.port=GPIOC, .number=1},
+			.data_command={.port=GPIOC, .number=2}, .read_setup=3
+		};
+		REQUIRE(Bus::init(BUS_HIGH_BYTE));
+		GPIOC->IDR = 0xA5FF;
+		REQUIRE(Bus::read_data(BUS_HIGH_BYTE) == 0xA5);
+		REQUIRE((GPIOC->ODR & 0b010) != 0);
+	}
+
+
+	SECTION("Parallel Bus Pin Validation") {
+		// A control pin on the data field would be driven by every word written
+		Bus::Bus_t bus = BUS_8080;
+		bus.write_strobe = {.port=GPIOA, .number=7};
+		REQUIRE(!Bus::init(bus));
+		bus = BUS_8080;
+		bus.data_command = {.port=GPIOA, .number=0};
+		REQUIRE(!Bus::init(bus));
+		bus = BUS_6800;
+		bus.read_strobe = {.port=GPIOE, .number=15};
+		REQUIRE(!Bus::init(bus));
+
+		// The same pin number on another port is fine, two control pins on one pin or data past pin 15 aren't
+		bus = BUS_8080;
+		bus.read_strobe = {.port=GPIOB, .number=0};
+		REQUIRE(Bus::init(bus));
+		bus.read_strobe = bus.write_strobe;
+		REQUIRE(!Bus::init(bus));
+		bus = BUS_8080;
+		bus.data_shift = 9;
+		REQUIRE(!Bus::init(bus));
+	}
+
+
+	SECTION("Parallel Bus DMA Writes") {
+		const uint16_t PIXELS[] = {0x01, 0x02, 0x03};
+		uint32_t buffer[6];
+		REQUIRE(Bus::init(BUS_8080));
+		REQUIRE(Bus::encode_block(BUS_6800, PIXELS, 3, buffer) == 0);
+		REQUIRE(Bus::encode_block(BUS_8080, PIXELS, 3, buffer) == 6);
+
+		Waveform_Class::Waveform_t WAVEFORM = {.port=GPIOA, .timer=TIM16, .dma_channel=5, .started=false};
+		REQUIRE(Bus::write_block_dma(BUS_8080, WAVEFORM, buffer, 6, 0, 1));
+		mock_GPIO_logging = false;
+		for (uint_fast8_t i = 0; i < 6; i++) {
+			trigger_DMA_request(static_cast<uint16_t>(DMA_Class::Request::TIM16_UP));
+			record_GPIO_BSRR(GPIOA, GPIOA->BSRR);
+			if (i % 2) {
+				REQUIRE((GPIOA->ODR & 0xFF) == PIXELS[i / 2]);
+				REQUIRE((GPIOA->ODR & (1 << 8)) != 0);
+			}
+		}
+		REQUIRE(!Waveform_Class::busy(WAVEFORM));
+		Waveform_Class::stop(WAVEFORM);
+	}
+
+	mock_GPIO_logging = false;
+	restore_ports(saved);
+}
+
+
+TEST_CASE("Parallel bus benchmark", "[Parallel_Bus][PERIPHERAL][.benchmark]")
+{
+	using GPIO = Chip::GPIO;
+	// A 16-bit bus fills its port, so the strobe can only share the port with an 8-bit one
+	const Bus::Bus_t BUS = {
+		.data_port=GPIOE, .data_shift=0, .width=Bus::Bus_Width::BITS_8, .protocol=Bus::Protocol::INTEL_8080,
+		.write_strobe={.port=GPIOE, .number=8}, .read_strobe={.port=GPIOB, .number=1},
+		.data_command={.port=GPIOB, .number=2}, .read_setup=0
+	};
+	const Bus::Bus_t BUS_SPLIT = {
+		.data_port=GPIOE, .data_shift=0, .width=Bus::Bus_Width::BITS_8, .protocol=Bus::Protocol::INTEL_8080,
+		.write_strobe={.port=GPIOB, .number=0}, .read_strobe={.port=GPIOB, .number=1},
+		.data_command={.port=GPIOB, .number=2}, .read_setup=0
+	};
+	std::vector<uint16_t> frame(1024);
+	for (uint16_t i = 0; i < frame.size(); i++) {
+		frame[i] = static_cast<uint16_t>(i * 31);
+	}
+	Saved_Port_t saved[7];
+	save_ports(saved);
+	mock_GPIO_logging = false;
+	REQUIRE(Bus::init(BUS));
+
+	BENCHMARK("write_block, 1024 words, shared strobe port") {
+		Bus::write_block(BUS, frame.data(), static_cast<uint32_t>(frame.size()));
+		return GPIOE->ODR;
+	};
+
+	BENCHMARK("write_block, 1024 words, separate strobe port") {
+		Bus::write_block(BUS_SPLIT, frame.data(), static_cast<uint32_t>(frame.size()));
+		return GPIOE->ODR;
+	};
+
+	BENCHMARK("GPIO::set/clear per pin, 1024 words") {
+		for (auto word: frame) {
+			for (uint16_t pin = 0; pin < 8; pin++) {
+				if (word & (1 << pin)) {
+					GPIO::set({.port=GPIOE, .number=pin});
+				} else {
+					GPIO::clear({.port=GPIOE, .number=pin});
+				}
+			}
+			GPIO::clear(BUS_SPLIT.write_strobe);
+			GPIO::set(BUS_SPLIT.write_strobe);
+		}
+		return GPIOE->BSRR;
+	};
+
+	restore_ports(saved);
+}
@@ -0,0 +1,408 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_timer.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
+#include "../timer.hh"
+#include "../../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+TEST_CASE("Timer functions", "[Timer][PERIPHERAL]")
+{
+	using Timer = Timer_Class;
+	auto timer = GENERATE(TIM1, TIM2, TIM3, TIM4, TIM6, TIM7, TIM8, TIM15, TIM16, TIM17, TIM20);
+
+
+	SECTION("Timer Set Clock") {
+		// Doc: RM0440-7.4.17 & RM0440-7.4.19
+		const Chip::Clock::Gate GATE = Timer::clock_gate(timer);
+		const uint8_t HELD = Chip::Clock::references(GATE);
+
+		Timer::set_clock(timer, Timer::Clock_Status::ENABLED);
+		REQUIRE(Chip::Clock::is_running(GATE));
+		REQUIRE(Chip::Clock::references(GATE) == HELD + 1);
+
+		Timer::set_clock(timer, Timer::Clock_Status::DISABLED);
+		REQUIRE(Chip::Clock::references(GATE) == HELD);
+		REQUIRE(Chip::Clock::is_running(GATE) == (HELD != 0));
+	}
+
+
+	SECTION("Timer Time Base") {
+		// Doc: RM0440-29.5.15-29.5.16
+		timer->SR = 1;
+		Timer::set_time_base(timer, 169, 999);
+		REQUIRE(timer->PSC == 169);
+		REQUIRE(timer->ARR == 999);
+		REQUIRE((timer->SR & 1) == 0);
+
+		Timer::set_update_dma(timer, true);
+		REQUIRE((timer->DIER & (1 << 8)) != 0);
+		Timer::set_update_dma(timer, false);
+		REQUIRE((timer->DIER & (1 << 8)) == 0);
+
+		Timer::start(timer);
+		REQUIRE((timer->CR1 & 1) == 1);
+		Timer::stop(timer);
+		REQUIRE((timer->CR1 & 1) == 0);
+	}
+}
+
+
+
+namespace {
+	struct Fired {
+		uint32_t count;
+		uint32_t events;
+	};
+
+	void record(const uint32_t events, void *const context)
+	{
+		Fired &fired = *static_cast<Fired *>(context);
+		fired.count++;
+		fired.events |= events;
+	}
+
+	// Doc: RM0440-7.2.17 | 170 MHz with undivided APBs, the timers run at SYSCLK
+	constexpr Chip::Clock::Tree_t TREE_170MHZ = {
+		.source=Chip::Clock::Source::PLL, .pll_source=Chip::Clock::Source::HSI16, .hse=0, .pll_m=4, .pll_n=85,
+		.pll_r=2, .ahb_divider=1, .apb1_divider=1, .apb2_divider=1, .kernel_select=0
+	};
+}
+
+
+TEST_CASE("Timer instances", "[Timer][PERIPHERAL]")
+{
+	using Instance = Timer_Class::Instance;
+	using Counter_Mode = Timer_Class::Counter_Mode;
+	using Event = Timer_Class::Event;
+
+
+	SECTION("Timer Time Base Solving") {
+		// The prescaler is kept as small as the 16-bit ARR allows, 170 MHz doesn't divide to 1 kHz evenly with it
+		constexpr Timer_Class::Time_Base_t KHZ = Chip::Timer<Instance::TIMER_3>::time_base(TREE_170MHZ, 1000);
+		static_assert(KHZ.prescaler == 2 && KHZ.auto_reload == 56666, "");
+		static_assert(KHZ.frequency == 1000 && KHZ.error == -5, "");
+
+		// TIM2 is 32-bit, one count per timer clock
+		constexpr Timer_Class::Time_Base_t WIDE = Chip::Timer<Instance::TIMER_2>::time_base(TREE_170MHZ, 1000);
+		static_assert(WIDE.prescaler == 0 && WIDE.auto_reload == 169999 && WIDE.error == 0, "");
+
+		// Center aligned periods count up & down
+		constexpr Timer_Class::Time_Base_t CENTER = Chip::Timer<Instance::TIMER_1>::time_base(TREE_170MHZ, 20000,
+		                                                                                     Counter_Mode::CENTER_BOTH);
+		static_assert(CENTER.prescaler == 0 && CENTER.auto_reload == 4250 && CENTER.error == 0, "");
+
+		// A frequency the counter can't divide to evenly reports how far off it is
+		constexpr Timer_Class::Time_Base_t ODD = Chip::Timer<Instance::TIMER_4>::time_base(TREE_170MHZ, 30000);
+		static_assert(ODD.prescaler == 0 && ODD.auto_reload == 5666, "");
+		static_assert(ODD.frequency == 29998 && ODD.error == -58, "");
+
+		// Slow frequencies use the whole prescaler range
+		constexpr Timer_Class::Time_Base_t SLOW = Chip::Timer<Instance::TIMER_6>::time_base(TREE_170MHZ, 1);
+		static_assert(SLOW.prescaler == 2593 && SLOW.auto_reload == 0xFFFF && SLOW.frequency == 1, "");
+
+		// Out of range, the nearest frequency the timer can reach
+		constexpr Timer_Class::Time_Base_t FAST = Chip::Timer<Instance::TIMER_6>::time_base(TREE_170MHZ, 100000000);
+		static_assert(FAST.prescaler == 0 && FAST.auto_reload == 1 && FAST.frequency == 85000000, "");
+		static_assert(FAST.error == -150000, "");
+
+		// The clock domain follows the bus, a divided APB runs its timers at twice PCLK
+		constexpr Chip::Clock::Tree_t DIVIDED = {
+			.source=Chip::Clock::Source::HSI16, .pll_source=Chip::Clock::Source::HSI16, .hse=0, .pll_m=1, .pll_n=8,
+			.pll_r=2, .ahb_divider=1, .apb1_divider=4, .apb2_divider=1, .kernel_select=0
+		};
+		static_assert(Chip::Timer<Instance::TIMER_7>::time_base(DIVIDED, 1000).auto_reload == 7999, "");
+		static_assert(Chip::Timer<Instance::TIMER_17>::time_base(DIVIDED, 1000).auto_reload == 15999, "");
+		static_assert(Chip::Timer<Instance::TIMER_15>::NUM_CHANNELS == 2, "");
+		static_assert(Chip::Timer<Instance::TIMER_6>::NUM_CHANNELS == 0, "");
+	}
+
+
+	SECTION("Timer PWM") {
+		using Timer = Chip::Timer<Instance::TIMER_1>;
+		constexpr Timer_Class::Time_Base_t BASE = Timer::time_base(TREE_170MHZ, 20000, Counter_Mode::CENTER_BOTH);
+		Timer::init(BASE, Counter_Mode::CENTER_BOTH);
+		REQUIRE(Chip::Clock::is_running(Chip::Clock::Gate::TIM1EN));
+		REQUIRE(TIM1->ARR == 4250);
+		REQUIRE((TIM1->CR1 & (0b111 << 4)) == (0b110 << 4));
+		REQUIRE((TIM1->CR1 & (1 << 7)) != 0);
+
+		Timer::set_pwm<1>();
+		Timer::set_pwm<4>(Timer_Class::PWM_Polarity::ACTIVE_LOW, 100);
+		REQUIRE((TIM1->CCMR1 & 0x100FF) == 0x68);
+		REQUIRE(((TIM1->CCMR2 >> 8) & 0x100FF) == 0x68);
+		REQUIRE((TIM1->CCER & 0xF) == 0b0001);
+		REQUIRE(((TIM1->CCER >> 12) & 0xF) == 0b0011);
+		REQUIRE(TIM1->CCR4 == 100);
+		REQUIRE((TIM1->BDTR & (1 << 15)) != 0);
+
+		// Duty cycle updates are a plain store to CCRx
+		Timer::set_duty<1>(2125);
+		Timer::set_duty(4, 300);
+		REQUIRE(TIM1->CCR1 == 2125);
+		REQUIRE(TIM1->CCR4 == 300);
+
+		Timer::start();
+		REQUIRE(Timer_Class::running(TIM1));
+		Timer::deinit();
+		REQUIRE(!Timer_Class::running(TIM1));
+		TIM1->CR1 = 0;
+		TIM1->CCMR1 = 0;
+		TIM1->CCMR2 = 0;
+		TIM1->CCER = 0;
+		TIM1->BDTR = 0;
+	}
+
+
+	SECTION("Timer Periodic & One Shot") {
+		using Timer = Chip::Timer<Instance::TIMER_6>;
+		Fired fired = {0, 0};
+		Timer::init(Timer::time_base(TREE_170MHZ, 1000));
+		Timer::set_callback(record, &fired, static_cast<uint32_t>(Event::UPDATE));
+		REQUIRE((TIM6->DIER & 0b11111) == 0b00001);
+
+		Timer::start();
+		REQUIRE((TIM6->CR1 & 0b1001) == 0b0001);
+		TIM6->SR = 1;
+		raise_IRQ(TIM6_DAC_IRQn);
+		REQUIRE(fired.count == 1);
+		REQUIRE(fired.events == static_cast<uint32_t>(Event::UPDATE));
+		REQUIRE((TIM6->SR & 1) == 0);
+
+		// Nothing pending, nothing runs
+		TIM6->SR = 0;
+		raise_IRQ(TIM6_DAC_IRQn);
+		REQUIRE(fired.count == 1);
+
+		Timer::start_one_shot();
+		REQUIRE((TIM6->CR1 & 0b1001) == 0b1001);
+		Timer::start();
+		REQUIRE((TIM6->CR1 & 0b1001) == 0b0001);
+
+		Timer::deinit();
+		REQUIRE((TIM6->DIER & 0b11111) == 0);
+		TIM6->SR = 1;
+		raise_IRQ(TIM6_DAC_IRQn);
+		REQUIRE(fired.count == 1);
+		TIM6->SR = 0;
+		TIM6->CR1 = 0;
+	}
+
+
+	SECTION("Timer Input Capture") {
+		// TIM16 shares its interrupt with TIM1's update, each only sees its own events
+		using Timer = Chip::Timer<Instance::TIMER_16>;
+		Fired fired = {0, 0};
+		Timer::init(Timer::time_base(TREE_170MHZ, 100));
+		Timer::set_input_capture<1>(Timer_Class::Capture_Edge::BOTH, 3);
+		REQUIRE((TIM16->CCMR1 & 0xFF) == 0x31);
+		REQUIRE((TIM16->CCER & 0xF) == 0b1011);
+		Timer::set_callback(record, &fired, static_cast<uint32_t>(Event::CAPTURE_COMPARE_1));
+
+		TIM16->CCR1 = 1234;
+		TIM16->SR = 1 << 1;
+		TIM1->SR = 1;
+		raise_IRQ(TIM1_UP_TIM16_IRQn);
+		REQUIRE(fired.count == 1);
+		REQUIRE(fired.events == static_cast<uint32_t>(Event::CAPTURE_COMPARE_1));
+		REQUIRE(Timer::capture<1>() == 1234);
+		REQUIRE(TIM1->SR == 1);
+
+		Timer::deinit();
+		TIM1->SR = 0;
+		TIM16->SR = 0;
+		TIM16->CCMR1 = 0;
+		TIM16->CCER = 0;
+	}
+}
+
+
+namespace {
+	struct Frames {
+		uint32_t count;
+		uint32_t next_duty;
+		uint32_t *last;
+	};
+
+	// Fills each frame once it has been sent, the way a control loop would
+	void fill_frame(uint32_t *const frame, void *const context)
+	{
+		Frames &frames = *static_cast<Frames *>(context);
+		frames.count++;
+		frames.last = frame;
+		for (uint_fast8_t channel = 0; channel < 4; channel++) {
+			frame[channel] = frames.next_duty + channel;
+		}
+		frames.next_duty += 100;
+	}
+}
+
+
+TEST_CASE("Timer burst", "[Timer][PERIPHERAL]")
+{
+	using Timer = Chip::Timer<Timer_Class::Instance::TIMER_8>;
+	const uint16_t REQUEST = static_cast<uint16_t>(DMA_Class::Request::TIM8_UP);
+	Frames frames = {0, 1000, nullptr};
+
+	Timer_Class::Burst_t burst = {};
+	burst.dma_channel = 5;
+	burst.callback = fill_frame;
+	burst.context = &frames;
+	const uint32_t INITIAL[2 * Timer_Class::MAX_CHANNELS] = {10, 11, 12, 13, 20, 21, 22, 23};
+	for (uint_fast8_t i = 0; i < 2 * Timer_Class::MAX_CHANNELS; i++) {
+		burst.words[i] = INITIAL[i];
+	}
+
+	Timer::init(Timer::time_base(TREE_170MHZ, 20000));
+	for (uint_fast8_t channel = 1; channel <= 4; channel++) {
+		Timer::set_duty(channel, 0);
+	}
+	REQUIRE(Timer::start_burst(burst));
+
+	// Doc: RM0440-29.5.25 | CCR1 is word 13 from CR1, a burst of 4
+	REQUIRE(TIM8->DCR == ((3 << 8) | 13));
+	REQUIRE((TIM8->DIER & (1 << 8)) != 0);
+	REQUIRE(burst.num_channels == 4);
+	REQUIRE(Timer_Class::frame(burst, 1) == &burst.words[4]);
+
+	// Each update writes all four compare registers from one frame
+	trigger_TIM_burst(TIM8, REQUEST);
+	REQUIRE(TIM8->CCR1 == 10);
+	REQUIRE(TIM8->CCR2 == 11);
+	REQUIRE(TIM8->CCR3 == 12);
+	REQUIRE(TIM8->CCR4 == 13);
+	REQUIRE(frames.count == 1);
+	REQUIRE(frames.last == Timer_Class::frame(burst, 0));
+	REQUIRE(TIM8->BDTR == 0);
+
+	trigger_TIM_burst(TIM8, REQUEST);
+	REQUIRE(TIM8->CCR1 == 20);
+	REQUIRE(TIM8->CCR4 == 23);
+	REQUIRE(frames.count == 2);
+	REQUIRE(frames.last == Timer_Class::frame(burst, 1));
+
+	// The frames the callback prepared go out in order
+	trigger_TIM_burst(TIM8, REQUEST);
+	REQUIRE(TIM8->CCR1 == 1000);
+	REQUIRE(TIM8->CCR4 == 1003);
+	trigger_TIM_burst(TIM8, REQUEST);
+	REQUIRE(TIM8->CCR1 == 1100);
+	REQUIRE(frames.count == 4);
+
+	Timer::stop_burst(burst);
+	REQUIRE(TIM8->DCR == 0);
+	REQUIRE((TIM8->DIER & (1 << 8)) == 0);
+	trigger_TIM_burst(TIM8, REQUEST);
+	REQUIRE(TIM8->CCR1 == 1100);
+	REQUIRE(frames.count == 4);
+	Timer::deinit();
+
+	// A timer with fewer channels bursts fewer registers
+	using Small = Chip::Timer<Timer_Class::Instance::TIMER_15>;
+	Timer_Class::Burst_t small = {};
+	small.dma_channel = 6;
+	small.words[0] = 7;
+	small.words[1] = 8;
+	small.words[2] = 9;
+	Small::init(Small::time_base(TREE_170MHZ, 20000));
+	REQUIRE(Small::start_burst(small));
+	REQUIRE(TIM15->DCR == ((1 << 8) | 13));
+	trigger_TIM_burst(TIM15, static_cast<uint16_t>(DMA_Class::Request::TIM15_UP));
+	REQUIRE(TIM15->CCR1 == 7);
+	REQUIRE(TIM15->CCR2 == 8);
+	REQUIRE(TIM15->CCR3 == 0);
+	Small::stop_burst(small);
+	Small::deinit();
+}
+
+
+TEST_CASE("Timer synchronization", "[Timer][PERIPHERAL]")
+{
+	using Instance = Timer_Class::Instance;
+
+	// Doc: RM0440-28.3.2 | ITR0-ITR9, a timer can't trigger itself & TIM5's slot is empty on the G491
+	static_assert(Timer_Class::trigger_input(Instance::TIMER_8, Instance::TIMER_1) == 0, "");
+	static_assert(Timer_Class::trigger_input(Instance::TIMER_1, Instance::TIMER_8) == 5, "");
+	static_assert(Timer_Class::trigger_input(Instance::TIMER_1, Instance::TIMER_20) == 9, "");
+	static_assert(Timer_Class::trigger_input(Instance::TIMER_1, Instance::TIMER_1) == -1, "");
+	static_assert(Timer_Class::trigger_input(Instance::TIMER_16, Instance::TIMER_1) == -1, "");
+	static_assert(Timer_Class::trigger_input(Instance::TIMER_1, Instance::TIMER_6) == -1, "");
+	static_assert(Timer_Class::can_synchronize(Instance::TIMER_20, Instance::TIMER_1), "");
+	static_assert(!Timer_Class::can_synchronize(Instance::TIMER_1, Instance::TIMER_16), "");
+	static_assert(!Timer_Class::can_synchronize(Instance::TIMER_2, Instance::TIMER_7), "");
+
+
+	SECTION("Timer Group") {
+		// 12 PWM outputs on the three advanced timers, TIM8 a quarter period behind TIM1 & TIM20 half a period
+		using Group = Chip::Timer_Group<Instance::TIMER_1, Instance::TIMER_8, Instance::TIMER_20>;
+		using Master = Chip::Timer<Instance::TIMER_1>;
+		using Eight = Chip::Timer<Instance::TIMER_8>;
+		using Twenty = Chip::Timer<Instance::TIMER_20>;
+		static_assert(Group::NUM_SLAVES == 2, "");
+
+		constexpr Timer_Class::Time_Base_t BASE = Master::time_base(TREE_170MHZ, 20000);
+		Master::init(BASE);
+		Eight::init(BASE);
+		Twenty::init(BASE);
+		Group::synchronize({BASE.auto_reload / 4, BASE.auto_reload / 2});
+
+		// Doc: RM0440-28.6.2-28.6.3 | TRGO on counter enable, the slaves in trigger mode on ITR0
+		REQUIRE(((TIM1->CR2 >> 4) & 0b111) == 0b001);
+		REQUIRE((TIM8->SMCR & ((0b111 << 4) | (0b11 << 20))) == 0);
+		REQUIRE((TIM8->SMCR & (0b111 | (1 << 16))) == 0b110);
+		REQUIRE((TIM20->SMCR & (0b111 | (1 << 16))) == 0b110);
+		REQUIRE(TIM1->CNT == 0);
+		REQUIRE(TIM8->CNT == BASE.auto_reload / 4);
+		REQUIRE(TIM20->CNT == BASE.auto_reload / 2);
+		REQUIRE(!Timer_Class::running(TIM8));
+
+		// Only the master is started in software
+		Group::start();
+		REQUIRE(Timer_Class::running(TIM1));
+		REQUIRE(!Timer_Class::running(TIM8));
+		REQUIRE(!Timer_Class::running(TIM20));
+
+		Group::stop();
+		REQUIRE(!Timer_Class::running(TIM1));
+		Master::deinit();
+		Eight::deinit();
+		Twenty::deinit();
+	}
+
+
+	SECTION("Timer Slave Routing") {
+		// A master on another ITR slot lands in the split TS field
+		Chip::Timer<Instance::TIMER_3>::init(Chip::Timer<Instance::TIMER_3>::time_base(TREE_170MHZ, 1000));
+		REQUIRE(Timer_Class::set_slave(Instance::TIMER_3, Instance::TIMER_20, Timer_Class::Slave_Mode::RESET));
+		REQUIRE(((TIM3->SMCR >> 4) & 0b111) == 0b001);
+		REQUIRE(((TIM3->SMCR >> 20) & 0b11) == 0b01);
+		REQUIRE((TIM3->SMCR & 0b111) == 0b100);
+
+		// Routes the part doesn't have leave the timers alone
+		const uint32_t SMCR = TIM3->SMCR;
+		const uint32_t CR2 = TIM1->CR2;
+		REQUIRE(!Timer_Class::set_slave(Instance::TIMER_3, Instance::TIMER_3, Timer_Class::Slave_Mode::TRIGGER));
+		REQUIRE(!Timer_Class::set_slave(Instance::TIMER_16, Instance::TIMER_1, Timer_Class::Slave_Mode::TRIGGER));
+		const Instance SLAVES[] = {Instance::TIMER_3, Instance::TIMER_17};
+		const uint32_t PHASES[] = {0, 0};
+		REQUIRE(!Timer_Class::synchronize(Instance::TIMER_1, SLAVES, PHASES, 2));
+		REQUIRE(TIM3->SMCR == SMCR);
+		REQUIRE(TIM1->CR2 == CR2);
+
+		Timer_Class::set_trigger_output(TIM3, Timer_Class::Trigger_Output::UPDATE);
+		REQUIRE(((TIM3->CR2 >> 4) & 0b111) == 0b010);
+		Timer_Class::set_trigger_output(TIM3, Timer_Class::Trigger_Output::RESET);
+		TIM3->SMCR = 0;
+		Chip::Timer<Instance::TIMER_3>::deinit();
+	}
+}
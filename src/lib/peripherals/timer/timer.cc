@@ -0,0 +1,591 @@
+//------------------------------------------------------------------------------
+// File Name    : timer.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <cstddef>
+#include "timer.hh"
+#include "../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+namespace {
+	// Doc: RM0440-29.5.1
+	constexpr uint32_t COUNTER_ENABLE = 1 << 0;
+	constexpr uint32_t ONE_PULSE = 1 << 3;
+	constexpr uint32_t COUNTER_MODE_MASK = (1 << 4) | (0b11 << 5);
+	constexpr uint32_t AUTO_RELOAD_PRELOAD = 1 << 7;
+
+	// Doc: RM0440-29.5.2-29.5.3 | MMS & SMS keep their top bit apart from the rest, TS is split the same way
+	constexpr uint32_t MASTER_MODE_MASK = (0b111 << 4) | (1 << 25);
+	constexpr uint32_t SLAVE_MODE_MASK = 0b111 | (1 << 16);
+	constexpr uint32_t TRIGGER_SELECT_MASK = (0b111 << 4) | (0b11 << 20);
+
+	// Doc: RM0440-29.5.4-29.5.5 | UIF, CC1IF-CC4IF & IDXF, DIER enables them with the same bits
+	constexpr uint32_t EVENT_MASK = 0b11111 | (1 << 20);
+
+	// Doc: RM0440-29.5.7-29.5.10 | Per channel byte of CCMRx, OCxM[3] is bit 16 above it
+	constexpr uint32_t PWM_MODE_1 = 0b0110 << 4;
+	constexpr uint32_t OUTPUT_PRELOAD = 1 << 3;
+	constexpr uint32_t CHANNEL_MASK = 0xFF | (1 << 16);
+
+	// Doc: RM0440-29.5.11 | Per channel nibble of CCER
+	constexpr uint32_t CHANNEL_ENABLE = 1 << 0;
+	constexpr uint32_t CHANNEL_POLARITY_MASK = 0b1010;
+
+	// Doc: RM0440-28.6.21 | MOE, outputs of timers with a break input stay off without it
+	constexpr uint32_t MAIN_OUTPUT_ENABLE = 1 << 15;
+
+	// Doc: RM0440-29.5.4 & 29.5.25 | UDE, CC1DE-CC4DE above it & DBA, which counts words from CR1
+	constexpr uint32_t UPDATE_DMA = 1 << 8;
+	constexpr uint32_t CAPTURE_DMA = 1 << 9;
+	constexpr uint32_t BURST_BASE = offsetof(TIM_TypeDef, CCR1) / sizeof(uint32_t);
+
+	Timer_Class::Callback_t timer_callbacks[Timer_Class::NUM_INSTANCES] = {};
+	void *timer_contexts[Timer_Class::NUM_INSTANCES] = {};
+
+
+	volatile uint32_t *capture_compare_mode(TIM_TypeDef *const timer, const uint_fast8_t channel)
+	{
+		return (channel <= 2) ? &timer->CCMR1 : &timer->CCMR2;
+	}
+
+	void set_channel_mode(TIM_TypeDef *const timer, const uint_fast8_t channel, const uint32_t mode)
+	{
+		const uint32_t SHIFT = ((channel - 1) % 2) * 8;
+		volatile uint32_t *const REGISTER = capture_compare_mode(timer, channel);
+		Chip::HAL::write_register(REGISTER, (Chip::HAL::read_register(REGISTER) & ~(CHANNEL_MASK << SHIFT))
+		                                    | (mode << SHIFT));
+	}
+
+	void enable_channel(TIM_TypeDef *const timer, const uint_fast8_t channel, const uint32_t polarity)
+	{
+		const uint32_t SHIFT = (channel - 1) * 4;
+		volatile uint32_t *const REGISTER = &timer->CCER;
+		Chip::HAL::write_register(REGISTER, (Chip::HAL::read_register(REGISTER) & ~(CHANNEL_POLARITY_MASK << SHIFT))
+		                                    | ((polarity | CHANNEL_ENABLE) << SHIFT));
+	}
+
+	bool has_break(const TIM_TypeDef *const timer)
+	{
+		return timer == TIM1 || timer == TIM8 || timer == TIM15 || timer == TIM16 || timer == TIM17 || timer == TIM20;
+	}
+
+	// The first half of the circular buffer is frame 0, so half transfer means frame 0 has been sent
+	void burst_sent(const uint_fast8_t channel, const DMA_Class::Event event, void *const context)
+	{
+		(void) channel;
+		Timer_Class::Burst_t &burst = *static_cast<Timer_Class::Burst_t *>(context);
+		if (burst.callback == nullptr) {
+			return;
+		}
+		if (event == DMA_Class::Event::HALF_TRANSFER) {
+			burst.callback(Timer_Class::frame(burst, 0), burst.context);
+		} else if (event == DMA_Class::Event::TRANSFER_COMPLETE) {
+			burst.callback(Timer_Class::frame(burst, 1), burst.context);
+		}
+	}
+}
+
+
+
+/*
+ * Timer register functions
+ */
+void Timer_Class::set_clock(TIM_TypeDef *const timer, const Clock_Status clock_status)
+{
+	switch (clock_status) {
+		case Clock_Status::ENABLED:
+			Chip::Clock::acquire(clock_gate(timer));
+			break;
+		case Clock_Status::DISABLED:
+			Chip::Clock::release(clock_gate(timer));
+			break;
+	}
+}
+
+
+void Timer_Class::set_time_base(TIM_TypeDef *const timer, const uint16_t prescaler, const uint32_t auto_reload)
+{
+	// Doc: RM0440-29.5.15-29.5.16 | PSC & ARR are preloaded, UG transfers them to the shadow registers right away
+	Chip::HAL::write_register(&timer->PSC, prescaler);
+	Chip::HAL::write_register(&timer->ARR, auto_reload);
+	Chip::HAL::write_register(&timer->EGR, 1 << 0);
+
+	// Doc: RM0440-29.5.5 | UG also sets UIF, which would otherwise look like a real update
+	Chip::HAL::clear_register(&timer->SR, 1 << 0);
+}
+
+
+// Doc: RM0440-29.5.1 | ARR is preloaded so a new period starts cleanly, CMS & DIR are only changed while stopped
+void Timer_Class::set_counter_mode(TIM_TypeDef *const timer, const Counter_Mode mode)
+{
+	volatile uint32_t *const REGISTER = &timer->CR1;
+	Chip::HAL::write_register(REGISTER, (Chip::HAL::read_register(REGISTER) & ~COUNTER_MODE_MASK)
+	                                    | static_cast<uint32_t>(mode) | AUTO_RELOAD_PRELOAD);
+}
+
+
+void Timer_Class::set_update_dma(TIM_TypeDef *const timer, const bool enabled)
+{
+	// Doc: RM0440-29.5.4 | UDE
+	if (enabled) {
+		Chip::HAL::set_register(&timer->DIER, UPDATE_DMA);
+	} else {
+		Chip::HAL::clear_register(&timer->DIER, UPDATE_DMA);
+	}
+}
+
+
+void Timer_Class::start(TIM_TypeDef *const timer)
+{
+	// Doc: RM0440-29.5.1 | CEN
+	Chip::HAL::clear_register(&timer->CR1, ONE_PULSE);
+	Chip::HAL::set_register(&timer->CR1, COUNTER_ENABLE);
+}
+
+
+void Timer_Class::start_one_shot(TIM_TypeDef *const timer)
+{
+	// Doc: RM0440-29.3.19 | OPM clears CEN on the next update, so the counter runs a single period
+	Chip::HAL::set_register(&timer->CR1, ONE_PULSE | COUNTER_ENABLE);
+}
+
+
+void Timer_Class::stop(TIM_TypeDef *const timer)
+{
+	// Doc: RM0440-29.5.1 | CEN
+	Chip::HAL::clear_register(&timer->CR1, 1 << 0);
+}
+
+
+bool Timer_Class::running(const TIM_TypeDef *const timer)
+{
+	// Doc: RM0440-29.5.1 | CEN, reads as 0 while the timer's clock is off
+	return (Chip::HAL::read_register(&timer->CR1) & COUNTER_ENABLE) != 0;
+}
+
+
+
+/*
+ * Timer channel functions
+ */
+// Channels are 1-4. PWM mode 1 drives the output active while the counter is below compare, with CCRx preloaded
+// so duty cycle writes take effect on the next update. The pin still needs its alternate function.
+void Timer_Class::set_pwm(TIM_TypeDef *const timer, const uint_fast8_t channel, const PWM_Polarity polarity,
+                          const uint32_t compare)
+{
+	// Doc: RM0440-29.5.7-29.5.11
+	(&timer->CCR1)[channel - 1] = compare;
+	set_channel_mode(timer, channel, PWM_MODE_1 | OUTPUT_PRELOAD);
+	enable_channel(timer, channel, static_cast<uint32_t>(polarity) << 1);
+	if (has_break(timer)) {
+		Chip::HAL::set_register(&timer->BDTR, MAIN_OUTPUT_ENABLE);
+	}
+}
+
+
+// filter is ICxF, 0-15, longer filters need more samples of the same level before an edge counts.
+// An indirect input is the other channel of the pair, e.g. channel 2 capturing TI1.
+void Timer_Class::set_input_capture(TIM_TypeDef *const timer, const uint_fast8_t channel, const Capture_Edge edge,
+                                    const uint8_t filter, const Capture_Input input)
+{
+	// Doc: RM0440-29.5.7-29.5.11
+	set_channel_mode(timer, channel, static_cast<uint32_t>(input) | ((filter & 0xFu) << 4));
+	enable_channel(timer, channel, static_cast<uint32_t>(edge));
+}
+
+
+void Timer_Class::set_capture_dma(TIM_TypeDef *const timer, const uint_fast8_t channel, const bool enabled)
+{
+	// Doc: RM0440-29.5.4 | CCxDE
+	const uint32_t BIT = CAPTURE_DMA << (channel - 1);
+	if (enabled) {
+		Chip::HAL::set_register(&timer->DIER, BIT);
+	} else {
+		Chip::HAL::clear_register(&timer->DIER, BIT);
+	}
+}
+
+
+uint32_t Timer_Class::capture(const TIM_TypeDef *const timer, const uint_fast8_t channel)
+{
+	// Doc: RM0440-29.5.17-29.5.20 | Reading CCRx also clears CCxIF
+	return Chip::HAL::read_register(&(&timer->CCR1)[channel - 1]);
+}
+
+
+
+/*
+ * Timer burst functions
+ */
+// Both frames should be filled before the burst starts, frame 0 is sent on the next update event.
+// Returns false when something else holds the DMA channel
+bool Timer_Class::start_burst(Burst_t &burst)
+{
+	stop_burst(burst);
+	if (!DMA_Class::reserve(burst.dma_channel)) {
+		return false;
+	}
+	burst.started = true;
+
+	// Doc: RM0440-29.4.26 & 29.5.25 | One update request becomes DBL + 1 DMA requests, each write to DMAR lands in
+	// the next register from DBA
+	Chip::HAL::write_register(&burst.timer->DCR, (static_cast<uint32_t>(burst.num_channels - 1) << 8) | BURST_BASE);
+
+	const DMA_Class::Transfer_Config_t CONFIG = {
+		.request=update_request(burst.timer),
+		.direction=DMA_Class::Direction::MEMORY_TO_PERIPHERAL,
+		.peripheral_width=DMA_Class::Data_Width::WORD,
+		.memory_width=DMA_Class::Data_Width::WORD,
+		.peripheral_increment=false,
+		.memory_increment=true,
+		.mode=DMA_Class::Transfer_Mode::CIRCULAR,
+		.priority=DMA_Class::Priority::VERY_HIGH
+	};
+	DMA_Class::configure(burst.dma_channel, CONFIG);
+	DMA_Class::set_callback(burst.dma_channel, burst_sent, &burst, true);
+	DMA_Class::start(burst.dma_channel, &burst.timer->DMAR, burst.words, static_cast<uint16_t>(burst.num_channels * 2));
+	set_update_dma(burst.timer, true);
+	return true;
+}
+
+
+void Timer_Class::stop_burst(Burst_t &burst)
+{
+	if (!burst.started) {
+		return;
+	}
+	burst.started = false;
+	set_update_dma(burst.timer, false);
+	DMA_Class::free(burst.dma_channel);
+	Chip::HAL::write_register(&burst.timer->DCR, 0);
+}
+
+
+
+/*
+ * Timer synchronization functions
+ */
+void Timer_Class::set_trigger_output(TIM_TypeDef *const timer, const Trigger_Output output)
+{
+	// Doc: RM0440-29.5.2
+	const uint32_t MODE = static_cast<uint32_t>(output);
+	volatile uint32_t *const REGISTER = &timer->CR2;
+	Chip::HAL::write_register(REGISTER, (Chip::HAL::read_register(REGISTER) & ~MASTER_MODE_MASK)
+	                                    | ((MODE & 0b111) << 4) | (((MODE >> 3) & 1) << 25));
+}
+
+
+// Returns false & leaves the slave alone when the part has no route from the master to it
+bool Timer_Class::set_slave(const Instance slave, const Instance master, const Slave_Mode mode)
+{
+	const int_fast8_t ITR = trigger_input(slave, master);
+	if (ITR < 0) {
+		return false;
+	}
+
+	// Doc: RM0440-29.5.3 | TS is only changed while the slave mode is disabled
+	const uint32_t SELECT = ((static_cast<uint32_t>(ITR) & 0b111) << 4) | (((static_cast<uint32_t>(ITR) >> 3) & 0b11) << 20);
+	const uint32_t MODE = static_cast<uint32_t>(mode);
+	volatile uint32_t *const REGISTER = &registers(slave)->SMCR;
+	const uint32_t OTHERS = Chip::HAL::read_register(REGISTER) & ~(SLAVE_MODE_MASK | TRIGGER_SELECT_MASK);
+	Chip::HAL::write_register(REGISTER, OTHERS);
+	Chip::HAL::write_register(REGISTER, OTHERS | SELECT);
+	Chip::HAL::write_register(REGISTER, OTHERS | SELECT | (MODE & 0b111) | (((MODE >> 3) & 1) << 16));
+	return true;
+}
+
+
+// Checks every route before touching a register, so a group that can't be built is left as it was.
+// The trigger reaches the slaves a fixed few timer clocks after the master starts, which phases can absorb.
+bool Timer_Class::synchronize(const Instance master, const Instance *const slaves, const uint32_t *const phases,
+                              const uint_fast8_t num_slaves)
+{
+	for (uint_fast8_t i = 0; i < num_slaves; i++) {
+		if (!can_synchronize(slaves[i], master)) {
+			return false;
+		}
+	}
+
+	TIM_TypeDef *const MASTER = registers(master);
+	stop(MASTER);
+	set_trigger_output(MASTER, Trigger_Output::ENABLE);
+	Chip::HAL::write_register(&MASTER->CNT, 0);
+
+	for (uint_fast8_t i = 0; i < num_slaves; i++) {
+		TIM_TypeDef *const SLAVE = registers(slaves[i]);
+		stop(SLAVE);
+		Chip::HAL::write_register(&SLAVE->CNT, phases[i]);
+		(void) set_slave(slaves[i], master, Slave_Mode::TRIGGER);
+	}
+	return true;
+}
+
+
+
+/*
+ * Timer interrupt functions
+ */
+// The callback runs in interrupt context with the events that happened, a null callback disables the interrupts
+void Timer_Class::set_callback(const Instance instance, const Callback_t callback, void *const context,
+                               const uint32_t events)
+{
+	TIM_TypeDef *const TIMER = registers(instance);
+	const uint8_t INDEX = static_cast<uint8_t>(instance);
+	const uint32_t ENABLED = (callback == nullptr) ? 0 : (events & EVENT_MASK);
+
+	Chip::HAL::clear_register(&TIMER->DIER, EVENT_MASK);
+	timer_callbacks[INDEX] = callback;
+	timer_contexts[INDEX] = context;
+	Chip::HAL::set_register(&TIMER->DIER, ENABLED);
+
+	// The interrupt lines some timers share are left enabled, the handlers only act on enabled events
+	if (ENABLED != 0) {
+		Chip::HAL::enable_irq(update_irq(instance));
+		Chip::HAL::enable_irq(capture_irq(instance));
+		Chip::HAL::enable_irq(trigger_irq(instance));
+	}
+}
+
+
+void Timer_Class::handle_interrupt(const Instance instance)
+{
+	TIM_TypeDef *const TIMER = registers(instance);
+	const uint8_t INDEX = static_cast<uint8_t>(instance);
+	const uint32_t EVENTS = Chip::HAL::read_register(&TIMER->SR) & Chip::HAL::read_register(&TIMER->DIER) & EVENT_MASK;
+	if (EVENTS == 0) {
+		return;
+	}
+
+	// Doc: RM0440-29.5.5 | rc_w0, writing the other flags as 1 leaves them alone
+	Chip::HAL::write_register(&TIMER->SR, ~EVENTS);
+	if (timer_callbacks[INDEX] != nullptr) {
+		timer_callbacks[INDEX](EVENTS, timer_contexts[INDEX]);
+	}
+}
+
+
+
+/*
+ * Timer lookup functions
+ */
+DMA_Class::Request Timer_Class::update_request(const TIM_TypeDef *const timer)
+{
+	// Doc: RM0440-13.3.2
+	using Request = DMA_Class::Request;
+	Request request = Request::TIM1_UP;
+
+	if (timer == TIM1) {
+		request = Request::TIM1_UP;
+	} else if (timer == TIM2) {
+		request = Request::TIM2_UP;
+	} else if (timer == TIM3) {
+		request = Request::TIM3_UP;
+	} else if (timer == TIM4) {
+		request = Request::TIM4_UP;
+	} else if (timer == TIM6) {
+		request = Request::TIM6_UP;
+	} else if (timer == TIM7) {
+		request = Request::TIM7_UP;
+	} else if (timer == TIM8) {
+		request = Request::TIM8_UP;
+	} else if (timer == TIM15) {
+		request = Request::TIM15_UP;
+	} else if (timer == TIM16) {
+		request = Request::TIM16_UP;
+	} else if (timer == TIM17) {
+		request = Request::TIM17_UP;
+	} else if (timer == TIM20) {
+		request = Request::TIM20_UP;
+	}
+	return request;
+}
+
+
+Timer_Class::Instance Timer_Class::instance(const TIM_TypeDef *const timer)
+{
+	Instance instance = Instance::TIMER_1;
+
+	for (uint_fast8_t i = 0; i < NUM_INSTANCES; i++) {
+		if (registers(static_cast<Instance>(i)) == timer) {
+			instance = static_cast<Instance>(i);
+		}
+	}
+	return instance;
+}
+
+
+// A channel without a request of its own gives the timer's CH1 request, see capture_request_channels()
+DMA_Class::Request Timer_Class::capture_request(const TIM_TypeDef *const timer, const uint_fast8_t channel)
+{
+	// Doc: RM0440-13.3.2 | CH1-CH4 requests are consecutive
+	using Request = DMA_Class::Request;
+	Request first = Request::TIM1_CH1;
+
+	if (timer == TIM1) {
+		first = Request::TIM1_CH1;
+	} else if (timer == TIM2) {
+		first = Request::TIM2_CH1;
+	} else if (timer == TIM3) {
+		first = Request::TIM3_CH1;
+	} else if (timer == TIM4) {
+		first = Request::TIM4_CH1;
+	} else if (timer == TIM8) {
+		first = Request::TIM8_CH1;
+	} else if (timer == TIM15) {
+		first = Request::TIM15_CH1;
+	} else if (timer == TIM16) {
+		first = Request::TIM16_CH1;
+	} else if (timer == TIM17) {
+		first = Request::TIM17_CH1;
+	} else if (timer == TIM20) {
+		first = Request::TIM20_CH1;
+	}
+	const uint_fast8_t OFFSET = (channel >= 1 && channel <= capture_request_channels(timer)) ? channel - 1 : 0;
+	return static_cast<Request>(static_cast<uint8_t>(first) + OFFSET);
+}
+
+
+// Channels 1 to the count have a capture/compare DMA request
+uint_fast8_t Timer_Class::capture_request_channels(const TIM_TypeDef *const timer)
+{
+	// Doc: RM0440-13.3.2 | TIM6 & TIM7 have no channels, TIM16 & TIM17 only CH1 & TIM15's CH2 has no request
+	uint_fast8_t channels = 4;
+
+	if (timer == TIM6 || timer == TIM7) {
+		channels = 0;
+	} else if (timer == TIM15 || timer == TIM16 || timer == TIM17) {
+		channels = 1;
+	}
+	return channels;
+}
+
+
+IRQn_Type Timer_Class::update_irq(const Instance instance)
+{
+	// Doc: RM0440-16.3 | The update interrupt, or the timer's only one
+	IRQn_Type irq = TIM1_UP_TIM16_IRQn;
+
+	if (instance == Instance::TIMER_1 || instance == Instance::TIMER_16) {
+		irq = TIM1_UP_TIM16_IRQn;
+	} else if (instance == Instance::TIMER_2) {
+		irq = TIM2_IRQn;
+	} else if (instance == Instance::TIMER_3) {
+		irq = TIM3_IRQn;
+	} else if (instance == Instance::TIMER_4) {
+		irq = TIM4_IRQn;
+	} else if (instance == Instance::TIMER_6) {
+		irq = TIM6_DAC_IRQn;
+	} else if (instance == Instance::TIMER_7) {
+		irq = TIM7_IRQn;
+	} else if (instance == Instance::TIMER_8) {
+		irq = TIM8_UP_IRQn;
+	} else if (instance == Instance::TIMER_15) {
+		irq = TIM1_BRK_TIM15_IRQn;
+	} else if (instance == Instance::TIMER_17) {
+		irq = TIM1_TRG_COM_TIM17_IRQn;
+	} else if (instance == Instance::TIMER_20) {
+		irq = TIM20_UP_IRQn;
+	}
+	return irq;
+}
+
+
+IRQn_Type Timer_Class::capture_irq(const Instance instance)
+{
+	// Doc: RM0440-16.3 | Only the advanced timers have a separate capture/compare interrupt
+	IRQn_Type irq = update_irq(instance);
+
+	if (instance == Instance::TIMER_1) {
+		irq = TIM1_CC_IRQn;
+	} else if (instance == Instance::TIMER_8) {
+		irq = TIM8_CC_IRQn;
+	} else if (instance == Instance::TIMER_20) {
+		irq = TIM20_CC_IRQn;
+	}
+	return irq;
+}
+
+
+IRQn_Type Timer_Class::trigger_irq(const Instance instance)
+{
+	// Doc: RM0440-16.3 | The advanced timers raise trigger, commutation & index on their own line, TIM1's shared
+	IRQn_Type irq = update_irq(instance);
+
+	if (instance == Instance::TIMER_1) {
+		irq = TIM1_TRG_COM_TIM17_IRQn;
+	} else if (instance == Instance::TIMER_8) {
+		irq = TIM8_TRG_COM_IRQn;
+	} else if (instance == Instance::TIMER_20) {
+		irq = TIM20_TRG_COM_IRQn;
+	}
+	return irq;
+}
+
+
+Chip::Clock::Gate Timer_Class::clock_gate(const TIM_TypeDef *const timer)
+{
+	// Doc: RM0440-7.4.17 & RM0440-7.4.19
+	using Gate = Chip::Clock::Gate;
+	Gate gate = Gate::TIM1EN;
+
+	if (timer == TIM1) {
+		gate = Gate::TIM1EN;
+	} else if (timer == TIM2) {
+		gate = Gate::TIM2EN;
+	} else if (timer == TIM3) {
+		gate = Gate::TIM3EN;
+	} else if (timer == TIM4) {
+		gate = Gate::TIM4EN;
+	} else if (timer == TIM6) {
+		gate = Gate::TIM6EN;
+	} else if (timer == TIM7) {
+		gate = Gate::TIM7EN;
+	} else if (timer == TIM8) {
+		gate = Gate::TIM8EN;
+	} else if (timer == TIM15) {
+		gate = Gate::TIM15EN;
+	} else if (timer == TIM16) {
+		gate = Gate::TIM16EN;
+	} else if (timer == TIM17) {
+		gate = Gate::TIM17EN;
+	} else if (timer == TIM20) {
+		gate = Gate::TIM20EN;
+	}
+	return gate;
+}
+
+
+
+extern "C" {
+void TIM1_BRK_TIM15_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_15); }
+void TIM1_UP_TIM16_IRQHandler()
+{
+	Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_1);
+	Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_16);
+}
+void TIM1_TRG_COM_TIM17_IRQHandler()
+{
+	Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_1);
+	Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_17);
+}
+void TIM1_CC_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_1); }
+void TIM2_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_2); }
+void TIM3_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_3); }
+void TIM4_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_4); }
+void TIM6_DAC_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_6); }
+void TIM7_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_7); }
+void TIM8_UP_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_8); }
+void TIM8_TRG_COM_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_8); }
+void TIM8_CC_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_8); }
+void TIM20_UP_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_20); }
+void TIM20_TRG_COM_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_20); }
+void TIM20_CC_IRQHandler() { Timer_Class::handle_interrupt(Timer_Class::Instance::TIMER_20); }
+}
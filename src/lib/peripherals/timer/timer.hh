@@ -0,0 +1,390 @@
+//------------------------------------------------------------------------------
+// File Name    : timer.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_TIMER_HH
+#define STM32G4_MODULE_LIBRARY_TIMER_HH
+
+#include <cstdint>
+#include "../gpio/gpio.hh"
+#include "../dma/dma.hh"
+
+#ifdef UNIT_TEST
+#include "../../chip/stm32g491/stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+class Timer_Class {
+public:
+	using Clock_Status = GPIO_Class::Clock_Status;
+
+	enum class Instance : uint8_t {
+		// Doc: RM0440-2.2.2
+		TIMER_1 = 0,
+		TIMER_2 = 1,
+		TIMER_3 = 2,
+		TIMER_4 = 3,
+		TIMER_6 = 4,
+		TIMER_7 = 5,
+		TIMER_8 = 6,
+		TIMER_15 = 7,
+		TIMER_16 = 8,
+		TIMER_17 = 9,
+		TIMER_20 = 10
+	};
+
+	static constexpr uint_fast8_t NUM_INSTANCES = 11;
+	static constexpr uint32_t MAX_DIVIDER = 0x10000;
+	static constexpr uint_fast8_t MAX_CHANNELS = 4;
+
+	enum class Counter_Mode : uint32_t {
+		// Doc: RM0440-29.5.1 | DIR & CMS, anything but UP needs TIM1/2/3/4/8/20
+		UP = 0,
+		DOWN = 1 << 4,
+		CENTER_DOWN = 0b01 << 5,        // Compare flags set while counting down
+		CENTER_UP = 0b10 << 5,          // Compare flags set while counting up
+		CENTER_BOTH = 0b11 << 5
+	};
+
+	enum class Event : uint32_t {
+		// Doc: RM0440-29.5.4-29.5.5 | SR flags, enabled by the DIER bits in the same positions
+		UPDATE = 1 << 0,
+		CAPTURE_COMPARE_1 = 1 << 1,
+		CAPTURE_COMPARE_2 = 1 << 2,
+		CAPTURE_COMPARE_3 = 1 << 3,
+		CAPTURE_COMPARE_4 = 1 << 4,
+		INDEX = 1 << 20                 // Encoder index, Doc: RM0440-29.3.25
+	};
+
+	enum class Trigger_Output : uint32_t {
+		// Doc: RM0440-29.5.2 | MMS, what the timer sends its slaves on TRGO
+		RESET = 0b000,
+		ENABLE = 0b001,                 // Counter enable, slaves in trigger mode start with the master
+		UPDATE = 0b010
+	};
+
+	enum class Slave_Mode : uint32_t {
+		// Doc: RM0440-29.5.3 | SMS
+		DISABLED = 0b0000,
+		RESET = 0b0100,
+		GATED = 0b0101,
+		TRIGGER = 0b0110                // The trigger sets CEN, the counter starts from wherever CNT was left
+	};
+
+	enum class PWM_Polarity {
+		// Doc: RM0440-29.5.11 | CCxP
+		ACTIVE_HIGH = 0b0,
+		ACTIVE_LOW = 0b1
+	};
+
+	enum class Capture_Input {
+		// Doc: RM0440-29.5.7 | CCxS, the neighbouring input lets two channels capture both edges of one pin
+		DIRECT = 0b01,
+		INDIRECT = 0b10
+	};
+
+	enum class Capture_Edge {
+		// Doc: RM0440-29.5.11 | CCxNP & CCxP
+		RISING = 0b0000,
+		FALLING = 0b0010,
+		BOTH = 0b1010
+	};
+
+	typedef void (*Callback_t)(uint32_t events, void *context);
+	typedef void (*Frame_Callback_t)(uint32_t *frame, void *context);
+
+	typedef struct {
+		uint16_t prescaler;         // PSC, the counter clock is the timer clock / (prescaler + 1)
+		uint32_t auto_reload;       // ARR
+		uint32_t frequency;         // Hz the counter period actually runs at, rounded
+		int32_t error;              // ppm from the requested frequency
+	} Time_Base_t;
+
+	// Double buffered compare frames, CCR1 up to CCRn written by one DMA burst on each update event. The compare
+	// registers are preloaded, so a whole frame takes effect on the same update. Frames 0 & 1 are sent on alternate
+	// updates & the callback is handed each one once it has been sent, to fill with the frame two updates on.
+	typedef struct {
+		TIM_TypeDef *timer;
+		uint8_t dma_channel;                    // 0-7 DMA1, 8-15 DMA2
+		uint8_t num_channels;                   // Compare registers per frame, from CCR1
+		Frame_Callback_t callback;              // Runs in the DMA interrupt
+		void *context;
+		uint32_t words[2 * MAX_CHANNELS];       // Frame 0 then frame 1, num_channels words each
+		bool started;                           // Set while start_burst() holds the DMA channel
+	} Burst_t;
+
+	// Every ENABLED must be matched by a DISABLED, the clock stays on while anything else holds it
+	static void set_clock(TIM_TypeDef *timer, Clock_Status clock_status);
+	static void set_time_base(TIM_TypeDef *timer, uint16_t prescaler, uint32_t auto_reload);
+	static void set_counter_mode(TIM_TypeDef *timer, Counter_Mode mode);
+	static void set_update_dma(TIM_TypeDef *timer, bool enabled);
+
+	static void start(TIM_TypeDef *timer);
+	static void start_one_shot(TIM_TypeDef *timer);
+	static void stop(TIM_TypeDef *timer);
+	static bool running(const TIM_TypeDef *timer);
+
+	static void set_pwm(TIM_TypeDef *timer, uint_fast8_t channel, PWM_Polarity polarity, uint32_t compare);
+	static void set_input_capture(TIM_TypeDef *timer, uint_fast8_t channel, Capture_Edge edge, uint8_t filter,
+	                              Capture_Input input = Capture_Input::DIRECT);
+	static void set_capture_dma(TIM_TypeDef *timer, uint_fast8_t channel, bool enabled);
+	static uint32_t capture(const TIM_TypeDef *timer, uint_fast8_t channel);
+
+	static bool start_burst(Burst_t &burst);
+	static void stop_burst(Burst_t &burst);
+
+	static void set_trigger_output(TIM_TypeDef *timer, Trigger_Output output);
+	static bool set_slave(Instance slave, Instance master, Slave_Mode mode);
+	static bool synchronize(Instance master, const Instance *slaves, const uint32_t *phases, uint_fast8_t num_slaves);
+
+	static void set_callback(Instance instance, Callback_t callback, void *context, uint32_t events);
+	static void handle_interrupt(Instance instance);
+
+	static Instance instance(const TIM_TypeDef *timer);
+	static DMA_Class::Request update_request(const TIM_TypeDef *timer);
+	static DMA_Class::Request capture_request(const TIM_TypeDef *timer, uint_fast8_t channel);
+	static uint_fast8_t capture_request_channels(const TIM_TypeDef *timer);
+	static Chip::Clock::Gate clock_gate(const TIM_TypeDef *timer);
+	static IRQn_Type update_irq(Instance instance);
+	static IRQn_Type capture_irq(Instance instance);
+	static IRQn_Type trigger_irq(Instance instance);
+
+
+	// Smallest prescaler that reaches the frequency, which leaves the most counts per period for PWM resolution.
+	// A frequency out of the timer's range is clamped to the nearest one it can run at & shows up in error.
+	static constexpr Time_Base_t solve_time_base(const uint32_t clock_frequency, const uint32_t frequency,
+	                                             const uint32_t max_auto_reload, const Counter_Mode mode)
+	{
+		// Doc: RM0440-29.3.2 | An edge aligned period is ARR + 1 counts, a center aligned one 2 * ARR
+		const bool CENTER = (mode != Counter_Mode::UP && mode != Counter_Mode::DOWN);
+		const uint64_t PERIOD_COUNTS = CENTER ? 2 : 1;
+		const uint64_t MAX_COUNTS = static_cast<uint64_t>(max_auto_reload) + (CENTER ? 0 : 1);
+		const uint64_t COUNTS = (static_cast<uint64_t>(clock_frequency) + frequency / 2) / frequency / PERIOD_COUNTS;
+
+		uint64_t divider = (COUNTS + MAX_COUNTS - 1) / MAX_COUNTS;
+		divider = (divider == 0) ? 1 : ((divider > MAX_DIVIDER) ? MAX_DIVIDER : divider);
+		const uint64_t STEP = static_cast<uint64_t>(frequency) * divider * PERIOD_COUNTS;
+		uint64_t counts = (clock_frequency + STEP / 2) / STEP;
+		counts = (counts > MAX_COUNTS) ? MAX_COUNTS : ((counts < 2) ? 2 : counts);
+
+		const uint64_t TICKS = divider * counts * PERIOD_COUNTS;
+		const int64_t ERROR = (static_cast<int64_t>(clock_frequency) * 1000000 / static_cast<int64_t>(TICKS)
+		                       - static_cast<int64_t>(frequency) * 1000000) / frequency;
+		return {
+			.prescaler=static_cast<uint16_t>(divider - 1),
+			.auto_reload=static_cast<uint32_t>(counts - (CENTER ? 0 : 1)),
+			.frequency=static_cast<uint32_t>((clock_frequency + TICKS / 2) / TICKS),
+			.error=static_cast<int32_t>(ERROR)
+		};
+	}
+
+	static uint32_t *frame(Burst_t &burst, const uint_fast8_t index)
+	{
+		return &burst.words[index * burst.num_channels];
+	}
+
+	static constexpr Chip::Clock::Domain clock_domain(const Instance instance)
+	{
+		// Doc: RM0440-7.2.17 | TIM1/8/15/16/17/20 are on APB2, the rest on APB1
+		return (instance == Instance::TIMER_1 || instance == Instance::TIMER_8 || instance == Instance::TIMER_15
+		        || instance == Instance::TIMER_16 || instance == Instance::TIMER_17 || instance == Instance::TIMER_20)
+		       ? Chip::Clock::Domain::TIMER_PCLK2 : Chip::Clock::Domain::TIMER_PCLK1;
+	}
+
+	static constexpr uint32_t max_auto_reload(const Instance instance)
+	{
+		// Doc: RM0440-29.1 | TIM2 is the only 32-bit timer
+		return (instance == Instance::TIMER_2) ? UINT32_MAX : UINT16_MAX;
+	}
+
+	static constexpr uint_fast8_t num_channels(const Instance instance)
+	{
+		// Doc: RM0440-28.1, 29.1, 30.1 & 31.1 | Capture/compare channels 1-4, basic timers have none
+		if (instance == Instance::TIMER_6 || instance == Instance::TIMER_7) {
+			return 0;
+		}
+		if (instance == Instance::TIMER_15) {
+			return 2;
+		}
+		if (instance == Instance::TIMER_16 || instance == Instance::TIMER_17) {
+			return 1;
+		}
+		return 4;
+	}
+
+	// Doc: RM0440-28.3.2 | ITR0-ITR9 carry TIM1, TIM2, TIM3, TIM4, TIM5, TIM8, TIM15, TIM16, TIM17 & TIM20 to every
+	// timer with a slave mode controller. The G491 has no TIM5 & a timer's own slot is reserved.
+	// Returns the ITR number the slave's TS field selects, or -1 when the master can't reach it.
+	static constexpr int_fast8_t trigger_input(const Instance slave, const Instance master)
+	{
+		const Instance SOURCES[] = {Instance::TIMER_1, Instance::TIMER_2, Instance::TIMER_3, Instance::TIMER_4,
+		                            Instance::TIMER_1, Instance::TIMER_8, Instance::TIMER_15, Instance::TIMER_16,
+		                            Instance::TIMER_17, Instance::TIMER_20};
+		const int_fast8_t NO_TIMER = 4;         // TIM5's slot
+		if (!has_slave_mode(slave) || slave == master) {
+			return -1;
+		}
+		for (int_fast8_t itr = 0; itr < static_cast<int_fast8_t>(sizeof(SOURCES) / sizeof(SOURCES[0])); itr++) {
+			if (itr != NO_TIMER && SOURCES[itr] == master) {
+				return itr;
+			}
+		}
+		return -1;
+	}
+
+	// Doc: RM0440-30.4 & 31.4 | TIM16 & TIM17 only reach ITR with OC1 & TIM6 & TIM7 have no ITR slot
+	static constexpr bool has_trigger_output(const Instance instance)
+	{
+		return instance != Instance::TIMER_6 && instance != Instance::TIMER_7 && instance != Instance::TIMER_16
+		       && instance != Instance::TIMER_17;
+	}
+
+	static constexpr bool has_slave_mode(const Instance instance)
+	{
+		return instance != Instance::TIMER_6 && instance != Instance::TIMER_7 && instance != Instance::TIMER_16
+		       && instance != Instance::TIMER_17;
+	}
+
+	static constexpr bool can_synchronize(const Instance slave, const Instance master)
+	{
+		return has_trigger_output(master) && trigger_input(slave, master) >= 0;
+	}
+
+	// Kept in the header so a constant instance folds into the register block's address
+	static TIM_TypeDef *registers(const Instance instance)
+	{
+		TIM_TypeDef *const TIMERS[NUM_INSTANCES] = {TIM1, TIM2, TIM3, TIM4, TIM6, TIM7, TIM8, TIM15, TIM16, TIM17, TIM20};
+		return TIMERS[static_cast<uint8_t>(instance)];
+	}
+};
+
+
+
+// One timer, picked at compile time. Time bases are solved at compile time from a clock tree & channels are
+// checked against what the instance has.
+template<Timer_Class::Instance INSTANCE>
+class Timer_Instance_Class : public Timer_Class {
+public:
+	static constexpr Chip::Clock::Domain CLOCK_DOMAIN = clock_domain(INSTANCE);
+	static constexpr uint32_t MAX_AUTO_RELOAD = max_auto_reload(INSTANCE);
+	static constexpr uint_fast8_t NUM_CHANNELS = num_channels(INSTANCE);
+
+	static constexpr Time_Base_t time_base(const Chip::Clock::Tree_t &tree, const uint32_t frequency,
+	                                       const Counter_Mode mode = Counter_Mode::UP)
+	{
+		return solve_time_base(Chip::Clock::frequency(tree, CLOCK_DOMAIN), frequency, MAX_AUTO_RELOAD, mode);
+	}
+
+	static TIM_TypeDef *registers() { return Timer_Class::registers(INSTANCE); }
+
+	// Takes the timer's clock until deinit()
+	static void init(const Time_Base_t &time_base, const Counter_Mode mode = Counter_Mode::UP)
+	{
+		set_clock(registers(), Clock_Status::ENABLED);
+		set_counter_mode(registers(), mode);
+		set_time_base(registers(), time_base.prescaler, time_base.auto_reload);
+	}
+
+	static void deinit()
+	{
+		Timer_Class::stop(registers());
+		Timer_Class::set_callback(INSTANCE, nullptr, nullptr, 0);
+		set_clock(registers(), Clock_Status::DISABLED);
+	}
+
+	static void start() { Timer_Class::start(registers()); }
+	static void start_one_shot() { Timer_Class::start_one_shot(registers()); }
+	static void stop() { Timer_Class::stop(registers()); }
+
+	// events is a mask of Event bits, e.g. Event::UPDATE for a periodic interrupt
+	static void set_callback(const Callback_t callback, void *const context, const uint32_t events)
+	{
+		Timer_Class::set_callback(INSTANCE, callback, context, events);
+	}
+
+	template<uint_fast8_t CHANNEL>
+	static void set_pwm(const PWM_Polarity polarity = PWM_Polarity::ACTIVE_HIGH, const uint32_t compare = 0)
+	{
+		static_assert(CHANNEL >= 1 && CHANNEL <= NUM_CHANNELS, "The timer doesn't have this channel");
+		Timer_Class::set_pwm(registers(), CHANNEL, polarity, compare);
+	}
+
+	template<uint_fast8_t CHANNEL>
+	static void set_input_capture(const Capture_Edge edge, const uint8_t filter = 0,
+	                              const Capture_Input input = Capture_Input::DIRECT)
+	{
+		static_assert(CHANNEL >= 1 && CHANNEL <= NUM_CHANNELS, "The timer doesn't have this channel");
+		Timer_Class::set_input_capture(registers(), CHANNEL, edge, filter, input);
+	}
+
+	// Doc: RM0440-29.5.17-29.5.20 | A single store, CCRx is preloaded so the new duty starts on the next update
+	template<uint_fast8_t CHANNEL>
+	static void set_duty(const uint32_t compare)
+	{
+		static_assert(CHANNEL >= 1 && CHANNEL <= NUM_CHANNELS, "The timer doesn't have this channel");
+		(&registers()->CCR1)[CHANNEL - 1] = compare;
+	}
+
+	static void set_duty(const uint_fast8_t channel, const uint32_t compare)
+	{
+		(&registers()->CCR1)[channel - 1] = compare;
+	}
+
+	// The burst's timer & frame size come from the instance, the rest of it is filled in by the caller
+	static bool start_burst(Burst_t &burst)
+	{
+		static_assert(NUM_CHANNELS > 0, "The timer has no compare registers to burst");
+		burst.timer = registers();
+		burst.num_channels = NUM_CHANNELS;
+		return Timer_Class::start_burst(burst);
+	}
+
+	template<uint_fast8_t CHANNEL>
+	static uint32_t capture()
+	{
+		static_assert(CHANNEL >= 1 && CHANNEL <= NUM_CHANNELS, "The timer doesn't have this channel");
+		return Timer_Class::capture(registers(), CHANNEL);
+	}
+};
+
+
+// A master & the timers it starts, checked against the part's ITR routing at compile time. The whole group starts
+// on the master's counter enable through TRGO & every timer reloads in lockstep as long as they share a clock &
+// time base, e.g. TIM1, TIM8 & TIM20 on APB2 for 12 phase-aligned PWM outputs.
+template<Timer_Class::Instance MASTER, Timer_Class::Instance... SLAVES>
+class Timer_Group_Class : public Timer_Class {
+public:
+	static constexpr uint_fast8_t NUM_SLAVES = sizeof...(SLAVES);
+	static_assert(NUM_SLAVES > 0, "A group needs at least one slave");
+	static_assert((can_synchronize(SLAVES, MASTER) && ...), "The master has no internal trigger route to every slave");
+
+	// The timers' time bases & channels are set up first. phases[i] is how many counts the i-th slave runs ahead
+	// of the master, a constant offset since both count the same clock from the same moment.
+	static void synchronize(const uint32_t (&phases)[NUM_SLAVES])
+	{
+		const Instance INSTANCES[NUM_SLAVES] = {SLAVES...};
+		(void) Timer_Class::synchronize(MASTER, INSTANCES, phases, NUM_SLAVES);
+	}
+
+	static void start() { Timer_Class::start(registers(MASTER)); }
+
+	// Slaves stay in trigger mode, synchronize() again before the next start() to realign them
+	static void stop()
+	{
+		Timer_Class::stop(registers(MASTER));
+		(Timer_Class::stop(registers(SLAVES)), ...);
+	}
+};
+
+
+#endif //STM32G4_MODULE_LIBRARY_TIMER_HH
@@ -0,0 +1,481 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_usart.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstring>
+#include "../usart.hh"
+#include "../../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+namespace {
+	struct Events {
+		uint32_t count;
+		uint32_t all;
+	};
+
+	void record(const uint32_t events, void *const context)
+	{
+		Events &recorded = *static_cast<Events *>(context);
+		recorded.count++;
+		recorded.all |= events;
+	}
+
+	// Interrupts per KB with 1 KB received & 1 KB sent through the FIFOs of a port without DMA
+	uint32_t fifo_interrupts_per_kb(const USART_Class::FIFO_Threshold threshold)
+	{
+		static uint8_t rx_buffer[1024];
+		static uint8_t tx_buffer[1024];
+		static uint8_t data[1024];
+		USART_Class::Port_t port = {};
+		port.instance = USART_Class::Instance::USART_3;
+		port.baud_rate = 115200;
+		port.rx_dma_channel = DMA_Class::NO_CHANNEL;
+		port.tx_dma_channel = DMA_Class::NO_CHANNEL;
+		port.rx_buffer = rx_buffer;
+		port.rx_length = sizeof(rx_buffer);
+		port.tx_buffer = tx_buffer;
+		port.tx_length = sizeof(tx_buffer);
+		port.rx_threshold = threshold;
+		port.tx_threshold = threshold;
+		if (!USART_Class::init(port)) {
+			return 0;
+		}
+
+		update_USART_status(USART3);
+		feed_USART(USART3, data, sizeof(data), 0);
+		(void) USART_Class::write(port, data, sizeof(data));
+		(void) drain_USART(USART3, data, sizeof(data), 0);
+		const uint32_t PER_KB = USART_Class::interrupts_per_kb(port);
+		USART_Class::deinit(port);
+		return PER_KB;
+	}
+}
+
+
+TEST_CASE("USART functions", "[USART][PERIPHERAL]")
+{
+	using USART = Chip::USART;
+	using Instance = USART::Instance;
+	const uint16_t RX_REQUEST = static_cast<uint16_t>(DMA_Class::Request::USART2_RX);
+	const uint16_t TX_REQUEST = static_cast<uint16_t>(DMA_Class::Request::USART2_TX);
+	(void) Chip::Clock::update();
+
+	static uint8_t rx_buffer[16];
+	static uint8_t tx_buffer[8];
+	memset(rx_buffer, 0, sizeof(rx_buffer));
+	Events events = {0, 0};
+
+	USART::Port_t port = {};
+	port.instance = Instance::USART_2;
+	port.baud_rate = 115200;
+	port.rx_dma_channel = static_cast<uint8_t>(DMA_Class::allocate(DMA_Class::Priority::HIGH));
+	port.tx_dma_channel = static_cast<uint8_t>(DMA_Class::allocate(DMA_Class::Priority::MEDIUM));
+	port.rx_buffer = rx_buffer;
+	port.rx_length = sizeof(rx_buffer);
+	port.tx_buffer = tx_buffer;
+	port.tx_length = sizeof(tx_buffer);
+	port.rx_timeout = 20;
+	port.callback = record;
+	port.context = &events;
+	REQUIRE(port.rx_dma_channel != DMA_Class::NO_CHANNEL);
+	REQUIRE(port.tx_dma_channel != DMA_Class::NO_CHANNEL);
+	const uint8_t DMAMUX_HELD = Chip::Clock::references(Chip::Clock::Gate::DMAMUX1EN);
+	REQUIRE(USART::init(port));
+
+
+	SECTION("USART Baud Divider") {
+		static_assert(USART::baud_divider(Instance::USART_1, 16000000, 115200) == 139, "");
+		static_assert(USART::baud_divider(Instance::UART_4, 170000000, 2000000) == 85, "");
+		static_assert(USART::baud_divider(Instance::USART_1, 16000000, 2000000) == 0, "");
+		static_assert(USART::baud_divider(Instance::LPUART_1, 16000000, 9600) == 426667, "");
+		static_assert(USART::baud_divider(Instance::LPUART_1, 32768, 9600) == 874, "");
+		static_assert(USART::baud_divider(Instance::LPUART_1, 32768, 19200) == 0, "");
+		static_assert(USART::rx_request(Instance::LPUART_1) == DMA_Class::Request::LPUART1_RX, "");
+		static_assert(USART::tx_request(Instance::USART_3) == DMA_Class::Request::USART3_TX, "");
+		static_assert(USART::clock_domain(Instance::UART_5) == Chip::Clock::Domain::UART5_KERNEL, "");
+	}
+
+
+	SECTION("USART Init") {
+		USART_TypeDef *const REGISTERS = USART::registers(Instance::USART_2);
+		REQUIRE(!USART::init(port));
+		REQUIRE(REGISTERS->BRR == USART::baud_divider(Instance::USART_2,
+		                                              Chip::Clock::frequency(Chip::Clock::Domain::USART2_KERNEL), 115200));
+		REQUIRE((REGISTERS->CR1 & 0b11101) == 0b11101);
+		REQUIRE((REGISTERS->CR1 & (1 << 26)) != 0);
+		REQUIRE((REGISTERS->CR2 & (1 << 23)) != 0);
+		REQUIRE(REGISTERS->RTOR == 20);
+		REQUIRE((REGISTERS->CR3 & 0b11000001) == 0b11000001);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::USART2EN) == 1);
+		REQUIRE((DMA_Class::channel_registers(port.rx_dma_channel)->CCR & (1 << 5)) != 0);
+		REQUIRE(DMA_Class::remaining(port.rx_dma_channel) == 16);
+
+		// An unreachable rate is refused before anything is touched
+		USART::Port_t fast = port;
+		fast.instance = Instance::USART_3;
+		fast.baud_rate = Chip::Clock::frequency(Chip::Clock::Domain::USART3_KERNEL);
+		REQUIRE(!USART::init(fast));
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::USART3EN) == 0);
+
+		// The ring is reported in halves, so it can't have an odd length
+		USART::Port_t odd = port;
+		odd.instance = Instance::USART_3;
+		odd.rx_length = 15;
+		REQUIRE(!USART::init(odd));
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::USART3EN) == 0);
+	}
+
+
+	SECTION("USART Receive") {
+		// Nothing is reported per byte, the idle line hands over the whole burst
+		const uint8_t HELLO[] = {'h', 'e', 'l', 'l', 'o'};
+		feed_USART(USART2, HELLO, sizeof(HELLO), RX_REQUEST);
+		REQUIRE(events.count == 0);
+		idle_USART(USART2);
+		REQUIRE(events.count == 1);
+		REQUIRE(events.all == (static_cast<uint32_t>(USART::Event::RX_DATA) | static_cast<uint32_t>(USART::Event::FRAME)));
+		REQUIRE((USART2->ISR & ((1 << 4) | (1 << 11))) == 0);
+
+		USART::Slice_t slice = USART::received(port);
+		REQUIRE(slice.length[0] == 5);
+		REQUIRE(slice.length[1] == 0);
+		REQUIRE(slice.data[0] == rx_buffer);
+		REQUIRE(memcmp(slice.data[0], HELLO, 5) == 0);
+		USART::consume(port, 3);
+		REQUIRE(USART::available(port) == 2);
+		USART::consume(port, 100);
+		REQUIRE(USART::available(port) == 0);
+
+		// Across the end of the ring, both halves of the DMA report on the way
+		uint8_t burst[14];
+		for (uint8_t i = 0; i < sizeof(burst); i++) {
+			burst[i] = static_cast<uint8_t>(0x30 + i);
+		}
+		feed_USART(USART2, burst, sizeof(burst), RX_REQUEST);
+		REQUIRE(events.count == 3);
+		slice = USART::received(port);
+		REQUIRE(slice.data[0] == rx_buffer + 5);
+		REQUIRE(slice.length[0] == 11);
+		REQUIRE(slice.data[1] == rx_buffer);
+		REQUIRE(slice.length[1] == 3);
+		REQUIRE(memcmp(slice.data[0], burst, 11) == 0);
+		REQUIRE(memcmp(slice.data[1], burst + 11, 3) == 0);
+
+		// 10 more without reading, 8 of the oldest are gone & reading starts at the oldest left
+		feed_USART(USART2, burst, 10, RX_REQUEST);
+		idle_USART(USART2);
+		REQUIRE((events.all & static_cast<uint32_t>(USART::Event::RX_OVERFLOW)) != 0);
+		REQUIRE(port.rx_overflows == 8);
+		REQUIRE(port.rx_received == 29);
+		slice = USART::received(port);
+		REQUIRE(slice.length[0] + slice.length[1] == 16);
+		REQUIRE(slice.data[0] == rx_buffer + 13);
+		REQUIRE(slice.data[0][0] == burst[8]);
+		REQUIRE(slice.data[1][15 - slice.length[0]] == burst[9]);
+	}
+
+
+	SECTION("USART Receive Errors") {
+		USART2->ISR |= (1 << 3);
+		raise_IRQ(USART2_IRQn);
+		REQUIRE(port.rx_errors == 1);
+		REQUIRE(events.all == static_cast<uint32_t>(USART::Event::RX_ERROR));
+		update_USART_status(USART2);
+		REQUIRE((USART2->ISR & (1 << 3)) == 0);
+	}
+
+
+	SECTION("USART Transmit Batching") {
+		const uint8_t FIRST[] = {'a', 'b'};
+		const uint8_t SECOND[] = {'c', 'd', 'e', 'f'};
+		REQUIRE(USART::write(port, FIRST, 2) == 2);
+		REQUIRE(DMA_Class::remaining(port.tx_dma_channel) == 2);
+
+		// Written while the first transfer runs, so they go out together as the next one
+		REQUIRE(USART::write(port, SECOND, 4) == 4);
+		REQUIRE(port.tx_count == 6);
+		uint8_t sent[16] = {};
+		REQUIRE(drain_USART(USART2, sent, 2, TX_REQUEST) == 2);
+		REQUIRE(DMA_Class::remaining(port.tx_dma_channel) == 4);
+		REQUIRE(events.count == 0);
+		REQUIRE(drain_USART(USART2, sent + 2, sizeof(sent) - 2, TX_REQUEST) == 4);
+		REQUIRE(memcmp(sent, "abcdef", 6) == 0);
+		REQUIRE(events.count == 1);
+		REQUIRE(events.all == static_cast<uint32_t>(USART::Event::TX_DONE));
+
+		// Wrapping around the queue takes two transfers, & only what fits is taken
+		const uint8_t LONG[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9'};
+		REQUIRE(USART::write(port, LONG, sizeof(LONG)) == 8);
+		REQUIRE(DMA_Class::remaining(port.tx_dma_channel) == 2);
+		REQUIRE(USART::write(port, LONG, 1) == 0);
+		REQUIRE(drain_USART(USART2, sent, sizeof(sent), TX_REQUEST) == 8);
+		REQUIRE(memcmp(sent, LONG, 8) == 0);
+		REQUIRE(events.count == 2);
+		REQUIRE(port.tx_count == 0);
+	}
+
+
+	SECTION("USART Clock Change") {
+		// Doc: RM0440-7.4.3 | PPRE1 dividing by 2 halves USART2's kernel clock
+		const uint32_t CFGR = RCC->CFGR;
+		const uint32_t BEFORE = USART2->BRR;
+		RCC->CFGR = CFGR | (0b100 << 8);
+		(void) Chip::Clock::update();
+		REQUIRE(USART2->BRR == USART::baud_divider(Instance::USART_2,
+		                                           Chip::Clock::frequency(Chip::Clock::Domain::USART2_KERNEL), 115200));
+		REQUIRE(USART2->BRR != BEFORE);
+		REQUIRE((USART2->CR1 & 1) != 0);
+
+		RCC->CFGR = CFGR;
+		(void) Chip::Clock::update();
+		REQUIRE(USART2->BRR == BEFORE);
+	}
+
+
+	USART::deinit(port);
+	REQUIRE(Chip::Clock::references(Chip::Clock::Gate::USART2EN) == 0);
+	REQUIRE(Chip::Clock::references(Chip::Clock::Gate::DMAMUX1EN) == DMAMUX_HELD);
+	REQUIRE(USART2->CR1 == 0);
+	DMA_Class::free(port.rx_dma_channel);
+	DMA_Class::free(port.tx_dma_channel);
+}
+
+
+TEST_CASE("USART framing", "[USART][PERIPHERAL]")
+{
+	using USART = Chip::USART;
+	const uint16_t RX_REQUEST = static_cast<uint16_t>(DMA_Class::Request::UART4_RX);
+	(void) Chip::Clock::update();
+
+	static uint8_t rx_buffer[16];
+	static uint8_t tx_buffer[8];
+	Events events = {0, 0};
+
+	USART::Port_t port = {};
+	port.instance = USART::Instance::UART_4;
+	port.baud_rate = 115200;
+	port.rx_dma_channel = static_cast<uint8_t>(DMA_Class::allocate(DMA_Class::Priority::HIGH));
+	port.tx_dma_channel = DMA_Class::NO_CHANNEL;
+	port.rx_buffer = rx_buffer;
+	port.rx_length = sizeof(rx_buffer);
+	port.tx_buffer = tx_buffer;
+	port.tx_length = sizeof(tx_buffer);
+	port.rx_timeout = 35;
+	port.match_delimiter = true;
+	port.delimiter = '\n';
+	port.callback = record;
+	port.context = &events;
+	REQUIRE(USART::init(port));
+
+	// Doc: RM0440-37.8.2 | ADD & ADDM7 with CMIE
+	REQUIRE((UART4->CR2 >> 24) == '\n');
+	REQUIRE((UART4->CR2 & (1 << 4)) != 0);
+	REQUIRE((UART4->CR1 & (1 << 14)) != 0);
+	REQUIRE(USART::next_frame(port).length[0] == 0);
+
+
+	SECTION("USART Framing Delimiter & Timeout") {
+		// The delimiter ends the first frame, the rest waits for the line to go quiet
+		const char DATA[] = "AB\nCD";
+		feed_USART(UART4, reinterpret_cast<const uint8_t *>(DATA), 5, RX_REQUEST);
+		REQUIRE(events.count == 1);
+		REQUIRE(events.all == (static_cast<uint32_t>(USART::Event::RX_DATA) | static_cast<uint32_t>(USART::Event::FRAME)));
+		USART::Slice_t frame = USART::next_frame(port);
+		REQUIRE(frame.length[0] == 3);
+		REQUIRE(frame.length[1] == 0);
+		REQUIRE(memcmp(frame.data[0], "AB\n", 3) == 0);
+		USART::consume(port, 3);
+		REQUIRE(USART::next_frame(port).length[0] == 0);
+
+		idle_USART(UART4);
+		frame = USART::next_frame(port);
+		REQUIRE(frame.length[0] == 2);
+		REQUIRE(memcmp(frame.data[0], "CD", 2) == 0);
+		USART::consume(port, 2);
+		REQUIRE(port.frames == 2);
+
+		// Quiet again with nothing new isn't another frame
+		idle_USART(UART4);
+		REQUIRE(port.frames == 2);
+		REQUIRE(USART::next_frame(port).length[0] == 0);
+	}
+
+
+	SECTION("USART Framing Late Interrupt") {
+		// Two delimiters & the start of a third frame before the interrupt runs still end at each delimiter
+		Chip::HAL::disable_irq(UART4_IRQn);
+		const char DATA[] = "ab\nc\nde";
+		feed_USART(UART4, reinterpret_cast<const uint8_t *>(DATA), 7, RX_REQUEST);
+		REQUIRE(events.count == 0);
+		Chip::HAL::enable_irq(UART4_IRQn);
+		raise_IRQ(UART4_IRQn);
+		REQUIRE(port.frames == 2);
+
+		USART::Slice_t frame = USART::next_frame(port);
+		REQUIRE(frame.length[0] == 3);
+		REQUIRE(memcmp(frame.data[0], "ab\n", 3) == 0);
+		USART::consume(port, 3);
+		frame = USART::next_frame(port);
+		REQUIRE(frame.length[0] == 2);
+		REQUIRE(memcmp(frame.data[0], "c\n", 2) == 0);
+		USART::consume(port, 2);
+		REQUIRE(USART::next_frame(port).length[0] == 0);
+
+		// The rest is only a frame once the line goes quiet
+		idle_USART(UART4);
+		frame = USART::next_frame(port);
+		REQUIRE(frame.length[0] == 2);
+		REQUIRE(memcmp(frame.data[0], "de", 2) == 0);
+		USART::consume(port, 2);
+	}
+
+
+	SECTION("USART Framing Queue") {
+		// Short frames wait in order, the one across the end of the ring comes in two parts
+		const char DATA[] = "0123456789\nxy\nlast\n";
+		feed_USART(UART4, reinterpret_cast<const uint8_t *>(DATA), sizeof(DATA) - 1, RX_REQUEST);
+		REQUIRE(port.frames == 3);
+		REQUIRE(port.rx_overflows == 3);
+
+		// The first frame was partly overwritten, what is left of it comes first
+		USART::Slice_t frame = USART::next_frame(port);
+		REQUIRE(frame.length[0] + frame.length[1] == 8);
+		REQUIRE(frame.data[0][0] == '3');
+		USART::consume(port, 8);
+
+		frame = USART::next_frame(port);
+		REQUIRE(frame.length[0] == 3);
+		REQUIRE(memcmp(frame.data[0], "xy\n", 3) == 0);
+		USART::consume(port, 3);
+
+		frame = USART::next_frame(port);
+		REQUIRE(frame.data[0] == rx_buffer + 14);
+		REQUIRE(frame.length[0] == 2);
+		REQUIRE(frame.length[1] == 3);
+		REQUIRE(memcmp(frame.data[0], "la", 2) == 0);
+		REQUIRE(memcmp(frame.data[1], "st\n", 3) == 0);
+		USART::consume(port, 5);
+		REQUIRE(USART::next_frame(port).length[0] == 0);
+		REQUIRE(USART::available(port) == 0);
+	}
+
+
+	USART::deinit(port);
+	DMA_Class::free(port.rx_dma_channel);
+}
+
+
+TEST_CASE("USART FIFO", "[USART][PERIPHERAL]")
+{
+	using USART = Chip::USART;
+	using Threshold = USART::FIFO_Threshold;
+	(void) Chip::Clock::update();
+
+	static uint8_t rx_buffer[16];
+	static uint8_t tx_buffer[32];
+	Events events = {0, 0};
+
+	USART::Port_t port = {};
+	port.instance = USART::Instance::USART_3;
+	port.baud_rate = 115200;
+	port.rx_dma_channel = DMA_Class::NO_CHANNEL;
+	port.tx_dma_channel = DMA_Class::NO_CHANNEL;
+	port.rx_buffer = rx_buffer;
+	port.rx_length = sizeof(rx_buffer);
+	port.tx_buffer = tx_buffer;
+	port.tx_length = sizeof(tx_buffer);
+	port.rx_threshold = Threshold::HALF;
+	port.tx_threshold = Threshold::FULL;
+	port.callback = record;
+	port.context = &events;
+	REQUIRE(USART::init(port));
+	update_USART_status(USART3);
+
+
+	SECTION("USART FIFO Init") {
+		static_assert(USART::fifo_entries(Threshold::SEVEN_EIGHTHS) == 7, "");
+		REQUIRE((USART3->CR1 & (1 << 29)) != 0);
+		REQUIRE(((USART3->CR3 >> 25) & 0b111) == 0b010);
+		REQUIRE((USART3->CR3 & (1 << 28)) != 0);
+		REQUIRE((USART3->CR3 >> 29) == 0b101);
+		REQUIRE((USART3->CR3 & ((1 << 6) | (1 << 7) | (1 << 23))) == 0);
+	}
+
+
+	SECTION("USART FIFO Receive") {
+		// Nothing until the FIFO is half full, then all of it in one interrupt
+		const uint8_t DATA[] = {1, 2, 3, 4, 5, 6};
+		feed_USART(USART3, DATA, 3, 0);
+		REQUIRE(port.interrupts == 0);
+		feed_USART(USART3, DATA + 3, 1, 0);
+		REQUIRE(port.interrupts == 1);
+		REQUIRE(events.all == static_cast<uint32_t>(USART::Event::RX_DATA));
+		REQUIRE(port.rx_unread == 4);
+
+		// What is left under the threshold comes with the idle line
+		feed_USART(USART3, DATA + 4, 2, 0);
+		REQUIRE(port.interrupts == 1);
+		idle_USART(USART3);
+		REQUIRE(port.interrupts == 2);
+		const USART::Slice_t SLICE = USART::received(port);
+		REQUIRE(SLICE.length[0] == 6);
+		REQUIRE(memcmp(SLICE.data[0], DATA, 6) == 0);
+	}
+
+
+	SECTION("USART FIFO Transmit") {
+		uint8_t data[20];
+		for (uint8_t i = 0; i < sizeof(data); i++) {
+			data[i] = static_cast<uint8_t>(i * 3);
+		}
+		REQUIRE(USART::write(port, data, sizeof(data)) == 20);
+		REQUIRE((USART3->CR3 & (1 << 23)) != 0);
+
+		// Each interrupt comes with the FIFO empty & fills all 8 entries
+		uint8_t sent[32] = {};
+		REQUIRE(drain_USART(USART3, sent, sizeof(sent), 0) == 20);
+		REQUIRE(memcmp(sent, data, sizeof(data)) == 0);
+		REQUIRE(port.interrupts == 3);
+		REQUIRE(port.tx_sent == 20);
+		REQUIRE(events.all == static_cast<uint32_t>(USART::Event::TX_DONE));
+		REQUIRE((USART3->CR3 & (1 << 23)) == 0);
+	}
+
+
+	SECTION("USART FIFO Interrupts per KB") {
+		USART::deinit(port);
+		const Threshold THRESHOLDS[] = {Threshold::ONE_EIGHTH, Threshold::HALF, Threshold::FULL};
+		for (auto threshold: THRESHOLDS) {
+			const uint32_t PER_KB = fifo_interrupts_per_kb(threshold);
+			REQUIRE(PER_KB <= 1024u / USART::fifo_entries(threshold));
+			REQUIRE(PER_KB + 8 >= 1024u / USART::fifo_entries(threshold));
+		}
+	}
+
+
+	USART::deinit(port);
+	REQUIRE(Chip::Clock::references(Chip::Clock::Gate::USART3EN) == 0);
+}
+
+
+TEST_CASE("USART FIFO report", "[USART][PERIPHERAL][.benchmark]")
+{
+	// Interrupts per KB for each FIFO threshold, against the 1024 of an interrupt per byte
+	using Threshold = USART_Class::FIFO_Threshold;
+	(void) Chip::Clock::update();
+	const Threshold THRESHOLDS[] = {Threshold::ONE_EIGHTH, Threshold::QUARTER, Threshold::HALF,
+	                                Threshold::THREE_QUARTERS, Threshold::SEVEN_EIGHTHS, Threshold::FULL};
+	for (auto threshold: THRESHOLDS) {
+		WARN("FIFO threshold of " << static_cast<uint32_t>(USART_Class::fifo_entries(threshold)) << " entries: "
+		     << fifo_interrupts_per_kb(threshold) << " interrupts per KB");
+	}
+}
@@ -0,0 +1,502 @@
+//------------------------------------------------------------------------------
+// File Name    : usart.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <cstring>
+#include "usart.hh"
+#include "../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+USART_Class::Port_t *USART_Class::ports[NUM_INSTANCES] = {};
+bool USART_Class::clock_subscribed = false;
+
+
+
+/*
+ * USART functions
+ */
+bool USART_Class::init(Port_t &port)
+{
+	const uint_fast8_t INDEX = static_cast<uint_fast8_t>(port.instance);
+	if (ports[INDEX] != nullptr || port.rx_length == 0 || (port.rx_length & 1) != 0 || port.tx_length == 0
+	    || baud_divider(port.instance, Chip::Clock::frequency(clock_domain(port.instance)), port.baud_rate) == 0) {
+		return false;
+	}
+	if (!clock_subscribed) {
+		clock_subscribed = Chip::Clock::subscribe(clock_listener, nullptr);
+	}
+
+	port.rx_position = 0;
+	port.rx_read_index = 0;
+	port.rx_unread = 0;
+	port.rx_received = 0;
+	port.rx_overflows = 0;
+	port.rx_errors = 0;
+	port.tx_write_index = 0;
+	port.tx_read_index = 0;
+	port.tx_count = 0;
+	port.tx_in_flight = 0;
+	port.tx_sent = 0;
+	port.interrupts = 0;
+	port.frame_head = 0;
+	port.frame_count = 0;
+	port.frames = 0;
+	port.frame_scanned = 0;
+	const bool RX_FIFO = (port.rx_dma_channel == DMA_Class::NO_CHANNEL);
+	const bool TX_FIFO = (port.tx_dma_channel == DMA_Class::NO_CHANNEL);
+
+	Chip::Clock::acquire(clock_gate(port.instance));
+	ports[INDEX] = &port;
+	USART_TypeDef *const USART = registers(port.instance);
+
+	// Doc: RM0440-37.8.1 | Everything but CR1's enables can only be written while UE is cleared, FIFOEN included
+	const uint32_t FIFO_ENABLE = static_cast<uint32_t>(RX_FIFO || TX_FIFO) << 29;
+	Chip::HAL::write_register(&USART->CR1, FIFO_ENABLE);
+	(void) set_baud_rate(port);
+
+	// Doc: RM0440-37.8.2 & 37.8.6 | RTOEN & the timeout in bit times, the LPUART has neither. ADD is the character
+	// matched, ADDM7 so all 8 bits are compared
+	const bool TIMEOUT = (port.rx_timeout != 0 && port.instance != Instance::LPUART_1);
+	if (TIMEOUT) {
+		Chip::HAL::write_register(&USART->RTOR, port.rx_timeout & 0xFFFFFF);
+	}
+	Chip::HAL::write_register(&USART->CR2, (static_cast<uint32_t>(TIMEOUT) << 23)
+	                                       | (static_cast<uint32_t>(port.delimiter) << 24) | (1 << 4));
+
+	// Doc: RM0440-37.8.3 | EIE so overrun, framing & noise errors interrupt, then DMAR & DMAT or the FIFO
+	// thresholds & RXFTIE. TXFTIE is only on while there is something queued
+	Chip::HAL::write_register(&USART->CR3, (1 << 0)
+		| (RX_FIFO ? ((static_cast<uint32_t>(port.rx_threshold) << 25) | (1 << 28)) : (1 << 6))
+		| (TX_FIFO ? (static_cast<uint32_t>(port.tx_threshold) << 29) : (1 << 7)));
+
+	// The RX ring runs for as long as the port is open, its halves are reported as they fill
+	if (!RX_FIFO) {
+		DMA_Class::set_callback(port.rx_dma_channel, rx_callback, &port, true);
+		DMA_Class::configure(port.rx_dma_channel, {.request=rx_request(port.instance),
+			.direction=DMA_Class::Direction::PERIPHERAL_TO_MEMORY, .peripheral_width=DMA_Class::Data_Width::BYTE,
+			.memory_width=DMA_Class::Data_Width::BYTE, .peripheral_increment=false, .memory_increment=true,
+			.mode=DMA_Class::Transfer_Mode::CIRCULAR, .priority=DMA_Class::Priority::HIGH});
+		DMA_Class::start(port.rx_dma_channel, &USART->RDR, port.rx_buffer, port.rx_length);
+	}
+	if (!TX_FIFO) {
+		DMA_Class::set_callback(port.tx_dma_channel, tx_callback, &port, false);
+		DMA_Class::configure(port.tx_dma_channel, {.request=tx_request(port.instance),
+			.direction=DMA_Class::Direction::MEMORY_TO_PERIPHERAL, .peripheral_width=DMA_Class::Data_Width::BYTE,
+			.memory_width=DMA_Class::Data_Width::BYTE, .peripheral_increment=false, .memory_increment=true,
+			.mode=DMA_Class::Transfer_Mode::NORMAL, .priority=DMA_Class::Priority::MEDIUM});
+	}
+
+	// Doc: RM0440-37.8.1 | UE, RE, TE, IDLEIE, CMIE & RTOIE
+	Chip::HAL::write_register(&USART->CR1, FIFO_ENABLE | (1 << 0) | (1 << 2) | (1 << 3) | (1 << 4)
+	                                       | (static_cast<uint32_t>(port.match_delimiter) << 14)
+	                                       | (static_cast<uint32_t>(TIMEOUT) << 26));
+	Chip::HAL::enable_irq(irq(port.instance));
+	return true;
+}
+
+
+void USART_Class::deinit(Port_t &port)
+{
+	const uint_fast8_t INDEX = static_cast<uint_fast8_t>(port.instance);
+	if (ports[INDEX] != &port) {
+		return;
+	}
+	Chip::HAL::disable_irq(irq(port.instance));
+	Chip::HAL::write_register(&registers(port.instance)->CR1, 0);
+	const uint8_t CHANNELS[] = {port.rx_dma_channel, port.tx_dma_channel};
+	for (auto channel: CHANNELS) {
+		if (channel != DMA_Class::NO_CHANNEL) {
+			DMA_Class::release(channel);
+			DMA_Class::set_callback(channel, nullptr, nullptr, false);
+		}
+	}
+	ports[INDEX] = nullptr;
+	Chip::Clock::release(clock_gate(port.instance));
+}
+
+
+USART_Class::Slice_t USART_Class::received(Port_t &port)
+{
+	const uint32_t primask = Chip::HAL::enter_critical();
+	(void) update_received(port);
+	const uint32_t START = port.rx_read_index;
+	const uint32_t UNREAD = port.rx_unread;
+	Chip::HAL::exit_critical(primask);
+	return slice(port, START, UNREAD);
+}
+
+
+// Frame ends are counted in bytes received, so ends that were consumed or overwritten are behind the read position
+USART_Class::Slice_t USART_Class::next_frame(Port_t &port)
+{
+	const uint32_t primask = Chip::HAL::enter_critical();
+	(void) update_received(port);
+	const uint32_t READ = port.rx_received - port.rx_unread;
+	uint32_t length = 0;
+	while (port.frame_count != 0) {
+		length = port.frame_ends[port.frame_head] - READ;
+		if (static_cast<int32_t>(length) > 0) {
+			break;
+		}
+		length = 0;
+		port.frame_head = static_cast<uint8_t>((port.frame_head + 1) % MAX_FRAMES);
+		port.frame_count--;
+	}
+	const uint32_t START = port.rx_read_index;
+	Chip::HAL::exit_critical(primask);
+	return slice(port, START, length);
+}
+
+
+void USART_Class::consume(Port_t &port, const uint32_t bytes)
+{
+	const uint32_t primask = Chip::HAL::enter_critical();
+	const uint32_t CONSUMED = (bytes < port.rx_unread) ? bytes : port.rx_unread;
+	port.rx_read_index = (port.rx_read_index + CONSUMED) % port.rx_length;
+	port.rx_unread -= CONSUMED;
+	Chip::HAL::exit_critical(primask);
+}
+
+
+uint32_t USART_Class::available(Port_t &port)
+{
+	const uint32_t primask = Chip::HAL::enter_critical();
+	(void) update_received(port);
+	const uint32_t UNREAD = port.rx_unread;
+	Chip::HAL::exit_critical(primask);
+	return UNREAD;
+}
+
+
+// The copy is done outside the critical section, only the space after tx_count is written & nothing else touches it
+uint32_t USART_Class::write(Port_t &port, const uint8_t *const data, const uint32_t length)
+{
+	const uint32_t primask = Chip::HAL::enter_critical();
+	const uint32_t FREE = port.tx_length - port.tx_count;
+	const uint32_t START = port.tx_write_index;
+	Chip::HAL::exit_critical(primask);
+
+	const uint32_t QUEUED = (length < FREE) ? length : FREE;
+	const uint32_t FIRST = (START + QUEUED > port.tx_length) ? port.tx_length - START : QUEUED;
+	memcpy(port.tx_buffer + START, data, FIRST);
+	memcpy(port.tx_buffer, data + FIRST, QUEUED - FIRST);
+
+	const uint32_t primask_queue = Chip::HAL::enter_critical();
+	port.tx_write_index = (START + QUEUED) % port.tx_length;
+	port.tx_count += QUEUED;
+	if (port.tx_dma_channel == DMA_Class::NO_CHANNEL) {
+		// Doc: RM0440-37.8.3 | TXFT is already set with the FIFO empty, so the interrupt does the first fill
+		if (port.tx_count != 0) {
+			Chip::HAL::set_register(&registers(port.instance)->CR3, 1 << 23);
+		}
+	} else if (port.tx_in_flight == 0 && port.tx_count != 0) {
+		start_tx(port);
+	}
+	Chip::HAL::exit_critical(primask_queue);
+	return QUEUED;
+}
+
+
+uint32_t USART_Class::interrupts_per_kb(const Port_t &port)
+{
+	const uint32_t BYTES = port.rx_received + port.tx_sent;
+	return (BYTES == 0) ? 0 : static_cast<uint32_t>(static_cast<uint64_t>(port.interrupts) * 1024 / BYTES);
+}
+
+
+
+/*
+ * USART private functions
+ */
+// Counts what the DMA has written since the last update from CNDTR, called from every RX interrupt so the DMA is
+// never more than half the ring ahead. Without a DMA channel the FIFO is emptied into the ring instead.
+// Called with interrupts disabled or from the interrupts themselves
+uint32_t USART_Class::update_received(Port_t &port)
+{
+	if (port.rx_dma_channel == DMA_Class::NO_CHANNEL) {
+		return drain_rx_fifo(port);
+	}
+	// Doc: RM0440-12.6.4 | CNDTR counts down to 0 & is reloaded with the ring's length
+	const uint32_t POSITION = (port.rx_length - DMA_Class::remaining(port.rx_dma_channel)) % port.rx_length;
+	return receive(port, (POSITION + port.rx_length - port.rx_position) % port.rx_length);
+}
+
+
+// When the unread bytes no longer fit, the oldest were overwritten & reading starts again at the write position
+uint32_t USART_Class::receive(Port_t &port, const uint32_t arrived)
+{
+	if (arrived == 0) {
+		return 0;
+	}
+	const uint32_t POSITION = (port.rx_position + arrived) % port.rx_length;
+	port.rx_position = POSITION;
+	port.rx_received += arrived;
+
+	uint32_t events = static_cast<uint32_t>(Event::RX_DATA);
+	const uint32_t UNREAD = port.rx_unread + arrived;
+	if (UNREAD > port.rx_length) {
+		port.rx_overflows += UNREAD - port.rx_length;
+		port.rx_unread = port.rx_length;
+		port.rx_read_index = POSITION;
+		events |= static_cast<uint32_t>(Event::RX_OVERFLOW);
+	} else {
+		port.rx_unread = UNREAD;
+	}
+	return events;
+}
+
+
+// end is a count of bytes received. Ends already read past or already queued are skipped, & a full queue
+// stretches its last frame instead
+uint32_t USART_Class::end_frame(Port_t &port, const uint32_t end)
+{
+	const uint32_t READ = port.rx_received - port.rx_unread;
+	const uint8_t LAST = static_cast<uint8_t>((port.frame_head + port.frame_count + MAX_FRAMES - 1) % MAX_FRAMES);
+	const uint32_t PREVIOUS = (port.frame_count != 0) ? port.frame_ends[LAST] : READ;
+	if (static_cast<int32_t>(end - PREVIOUS) <= 0) {
+		return 0;
+	}
+	port.frames++;
+	if (port.frame_count == MAX_FRAMES) {
+		port.frame_ends[LAST] = end;
+	} else {
+		port.frame_ends[(port.frame_head + port.frame_count) % MAX_FRAMES] = end;
+		port.frame_count++;
+	}
+	return static_cast<uint32_t>(Event::FRAME);
+}
+
+
+// Doc: RM0440-37.8.10 | CMF only says a delimiter came, & comes with RXNE, whose DMA request is served well before
+// the interrupt reads CNDTR. The bytes since the last look are searched so each frame ends right after its own
+// delimiter, however many came in & whatever followed them before the interrupt ran
+uint32_t USART_Class::find_delimiters(Port_t &port)
+{
+	const uint32_t RECEIVED = port.rx_received;
+	const uint32_t OLDEST = RECEIVED - port.rx_unread;
+	uint32_t count = (static_cast<int32_t>(port.frame_scanned - OLDEST) > 0) ? port.frame_scanned : OLDEST;
+	uint32_t index = (port.rx_position + port.rx_length - (RECEIVED - count)) % port.rx_length;
+	uint32_t events = 0;
+	while (count != RECEIVED) {
+		count++;
+		if (port.rx_buffer[index] == port.delimiter) {
+			events |= end_frame(port, count);
+		}
+		index = (index + 1 == port.rx_length) ? 0 : index + 1;
+	}
+	port.frame_scanned = RECEIVED;
+	return events;
+}
+
+
+// Doc: RM0440-37.8.10 | RDR is read for as long as RXFNE is set, emptying the FIFO whatever its threshold
+uint32_t USART_Class::drain_rx_fifo(Port_t &port)
+{
+	USART_TypeDef *const USART = registers(port.instance);
+	uint32_t position = port.rx_position;
+	uint32_t arrived = 0;
+	while (Chip::HAL::read_register(&USART->ISR) & (1 << 5)) {
+		port.rx_buffer[position] = static_cast<uint8_t>(Chip::HAL::read_register(&USART->RDR));
+		position = (position + 1 == port.rx_length) ? 0 : position + 1;
+		arrived++;
+	}
+	return receive(port, arrived);
+}
+
+
+// Doc: RM0440-37.8.10 | TDR is written for as long as TXFNF is set, filling the FIFO. Once the queue is empty
+// TXFTIE goes off again
+uint32_t USART_Class::fill_tx_fifo(Port_t &port)
+{
+	USART_TypeDef *const USART = registers(port.instance);
+	while (port.tx_count != 0 && (Chip::HAL::read_register(&USART->ISR) & (1 << 7))) {
+		Chip::HAL::write_register(&USART->TDR, port.tx_buffer[port.tx_read_index]);
+		port.tx_read_index = (port.tx_read_index + 1 == port.tx_length) ? 0 : port.tx_read_index + 1;
+		port.tx_count--;
+		port.tx_sent++;
+	}
+	if (port.tx_count != 0) {
+		return 0;
+	}
+	Chip::HAL::clear_register(&USART->CR3, 1 << 23);
+	return static_cast<uint32_t>(Event::TX_DONE);
+}
+
+
+USART_Class::Slice_t USART_Class::slice(const Port_t &port, const uint32_t start, const uint32_t length)
+{
+	const uint32_t FIRST = (start + length > port.rx_length) ? port.rx_length - start : length;
+	return {
+		.data={port.rx_buffer + start, port.rx_buffer},
+		.length={static_cast<uint16_t>(FIRST), static_cast<uint16_t>(length - FIRST)}
+	};
+}
+
+
+// Everything queued up to the end of the ring goes out in one transfer
+void USART_Class::start_tx(Port_t &port)
+{
+	const uint32_t CONTIGUOUS = port.tx_length - port.tx_read_index;
+	port.tx_in_flight = (port.tx_count < CONTIGUOUS) ? port.tx_count : CONTIGUOUS;
+	DMA_Class::start(port.tx_dma_channel, &registers(port.instance)->TDR, port.tx_buffer + port.tx_read_index,
+	                 static_cast<uint16_t>(port.tx_in_flight));
+}
+
+
+// Doc: RM0440-37.8.5 | BRR can only be written while UE is cleared, a byte being received or sent is lost
+bool USART_Class::set_baud_rate(const Port_t &port)
+{
+	const uint32_t DIVIDER = baud_divider(port.instance, Chip::Clock::frequency(clock_domain(port.instance)),
+	                                      port.baud_rate);
+	if (DIVIDER == 0) {
+		return false;
+	}
+	USART_TypeDef *const USART = registers(port.instance);
+	const uint32_t CONTROL = Chip::HAL::read_register(&USART->CR1);
+	Chip::HAL::clear_register(&USART->CR1, 1 << 0);
+	Chip::HAL::write_register(&USART->BRR, DIVIDER);
+	Chip::HAL::write_register(&USART->CR1, CONTROL);
+	return true;
+}
+
+
+void USART_Class::notify(const Port_t &port, const uint32_t events)
+{
+	if (events != 0 && port.callback != nullptr) {
+		port.callback(events, port.context);
+	}
+}
+
+
+
+/*
+ * USART interrupt functions
+ */
+void USART_Class::handle_interrupt(const Instance instance)
+{
+	// Doc: RM0440-37.8.10-37.8.11 | PE, FE, NE, ORE, IDLE, RTOF & CMF are cleared at the same bits of ICR
+	USART_TypeDef *const USART = registers(instance);
+	const uint32_t ERROR_MASK = 0b1111;
+	const uint32_t FRAME_MASK = (1 << 11) | (1 << 17);
+	const uint32_t FLAGS = Chip::HAL::read_register(&USART->ISR) & (ERROR_MASK | (1 << 4) | FRAME_MASK);
+	Chip::HAL::write_register(&USART->ICR, FLAGS);
+
+	Port_t *const PORT = ports[static_cast<uint8_t>(instance)];
+	if (PORT == nullptr) {
+		return;
+	}
+	PORT->interrupts++;
+	uint32_t events = update_received(*PORT);
+	// CMF is set by every match, CMIE only decides whether it interrupts. The delimiters go first, the timeout
+	// ends the frame after the last of them
+	if ((FLAGS & (1 << 17)) && PORT->match_delimiter) {
+		events |= find_delimiters(*PORT);
+	}
+	if (FLAGS & (1 << 11)) {
+		events |= end_frame(*PORT, PORT->rx_received);
+	}
+	if (FLAGS & ERROR_MASK) {
+		PORT->rx_errors++;
+		events |= static_cast<uint32_t>(Event::RX_ERROR);
+	}
+	if (PORT->tx_dma_channel == DMA_Class::NO_CHANNEL && (Chip::HAL::read_register(&USART->CR3) & (1 << 23))) {
+		events |= fill_tx_fifo(*PORT);
+	}
+	notify(*PORT, events);
+}
+
+
+void USART_Class::rx_callback(const uint_fast8_t, const DMA_Class::Event event, void *const context)
+{
+	Port_t &port = *static_cast<Port_t *>(context);
+	port.interrupts++;
+	uint32_t events = update_received(port);
+	if (event == DMA_Class::Event::TRANSFER_ERROR) {
+		port.rx_errors++;
+		events |= static_cast<uint32_t>(Event::RX_ERROR);
+	}
+	notify(port, events);
+}
+
+
+// The next transfer is started straight from the interrupt, with whatever was queued while this one ran
+void USART_Class::tx_callback(const uint_fast8_t, const DMA_Class::Event event, void *const context)
+{
+	Port_t &port = *static_cast<Port_t *>(context);
+	port.interrupts++;
+	if (event != DMA_Class::Event::TRANSFER_COMPLETE) {
+		return;
+	}
+	port.tx_read_index = (port.tx_read_index + port.tx_in_flight) % port.tx_length;
+	port.tx_count -= port.tx_in_flight;
+	port.tx_sent += port.tx_in_flight;
+	port.tx_in_flight = 0;
+	if (port.tx_count != 0) {
+		start_tx(port);
+	} else {
+		notify(port, static_cast<uint32_t>(Event::TX_DONE));
+	}
+}
+
+
+// Open ports follow their kernel clock, e.g. through Chip::Power::set_performance_level()
+void USART_Class::clock_listener(const uint32_t changed_domains, void *const)
+{
+	for (auto port: ports) {
+		if (port != nullptr && (changed_domains & (1u << static_cast<uint8_t>(clock_domain(port->instance))))) {
+			(void) set_baud_rate(*port);
+		}
+	}
+}
+
+
+
+/*
+ * USART register lookup functions
+ */
+USART_TypeDef *USART_Class::registers(const Instance instance)
+{
+	USART_TypeDef *const REGISTERS[NUM_INSTANCES] = {USART1, USART2, USART3, UART4, UART5, LPUART1};
+	return REGISTERS[static_cast<uint8_t>(instance)];
+}
+
+
+IRQn_Type USART_Class::irq(const Instance instance)
+{
+	const IRQn_Type IRQS[NUM_INSTANCES] = {USART1_IRQn, USART2_IRQn, USART3_IRQn, UART4_IRQn, UART5_IRQn,
+	                                       LPUART1_IRQn};
+	return IRQS[static_cast<uint8_t>(instance)];
+}
+
+
+Chip::Clock::Gate USART_Class::clock_gate(const Instance instance)
+{
+	// Doc: RM0440-7.4.17-7.4.19
+	const Chip::Clock::Gate GATES[NUM_INSTANCES] = {
+		Chip::Clock::Gate::USART1EN, Chip::Clock::Gate::USART2EN, Chip::Clock::Gate::USART3EN,
+		Chip::Clock::Gate::UART4EN, Chip::Clock::Gate::UART5EN, Chip::Clock::Gate::LPUART1EN
+	};
+	return GATES[static_cast<uint8_t>(instance)];
+}
+
+
+
+/*
+ * USART interrupt handlers, these replace the weak aliases in the startup file
+ */
+extern "C" {
+void USART1_IRQHandler() { USART_Class::handle_interrupt(USART_Class::Instance::USART_1); }
+void USART2_IRQHandler() { USART_Class::handle_interrupt(USART_Class::Instance::USART_2); }
+void USART3_IRQHandler() { USART_Class::handle_interrupt(USART_Class::Instance::USART_3); }
+void UART4_IRQHandler() { USART_Class::handle_interrupt(USART_Class::Instance::UART_4); }
+void UART5_IRQHandler() { USART_Class::handle_interrupt(USART_Class::Instance::UART_5); }
+void LPUART1_IRQHandler() { USART_Class::handle_interrupt(USART_Class::Instance::LPUART_1); }
+}
@@ -0,0 +1,203 @@
+//------------------------------------------------------------------------------
+// File Name    : usart.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_USART_HH
+#define STM32G4_MODULE_LIBRARY_USART_HH
+
+#include <cstdint>
+#include "../dma/dma.hh"
+#include "../../chip/stm32g491/stm32g491_clock.hh"
+
+#ifdef UNIT_TEST
+#include "../../chip/stm32g491/stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+// Asynchronous serial ports, 8N1 with no flow control. RX runs a circular DMA into the port's ring, so nothing
+// happens per byte: the idle line & receiver timeout interrupts, plus the DMA at each half of the ring, tell the
+// application how much has arrived & it reads the ring in place through received() & consume().
+// TX is queued into a second ring & everything queued while a transfer is running goes out as the next transfer.
+// A direction given NO_CHANNEL instead of a DMA channel uses the 8 entry hardware FIFO, its interrupt comes at the
+// FIFO threshold & moves every entry there is, so the ring & the rest of the interface are the same.
+// Frames are found by the USART rather than by looking at each byte as it comes: one ends at the delimiter the
+// character match is set to or at the receiver timeout, & next_frame() hands it over in place like received().
+// Only a match interrupt searches the bytes that came since the last one for where each delimiter was.
+class USART_Class {
+public:
+	enum class Instance : uint8_t {
+		USART_1 = 0,
+		USART_2 = 1,
+		USART_3 = 2,
+		UART_4 = 3,
+		UART_5 = 4,
+		LPUART_1 = 5
+	};
+
+	static constexpr uint_fast8_t NUM_INSTANCES = 6;
+
+	enum class Event : uint32_t {
+		RX_DATA = 1 << 0,           // Bytes arrived since the last event
+		RX_OVERFLOW = 1 << 1,       // Unread bytes were overwritten, see rx_overflows
+		RX_ERROR = 1 << 2,          // Parity, framing, noise or overrun error, see rx_errors
+		TX_DONE = 1 << 3,           // The TX queue is empty, the last byte is still being shifted out
+		FRAME = 1 << 4              // A frame ended, at the delimiter or the receiver timeout
+	};
+
+	enum class FIFO_Threshold : uint8_t {
+		// Doc: RM0440-37.8.3 | RXFTCFG & TXFTCFG. RX entries received or TX entries free before the interrupt,
+		// FULL leaves an RX FIFO no room for another byte before the interrupt is served
+		ONE_EIGHTH = 0b000,
+		QUARTER = 0b001,
+		HALF = 0b010,
+		THREE_QUARTERS = 0b011,
+		SEVEN_EIGHTHS = 0b100,
+		FULL = 0b101
+	};
+
+	static constexpr uint_fast8_t FIFO_DEPTH = 8;
+	static constexpr uint_fast8_t MAX_FRAMES = 8;       // Frame ends waiting for next_frame(), later ones merge
+
+	typedef void (*Callback_t)(uint32_t events, void *context);
+
+	// Unread bytes in place in the RX ring, the second part is only used when they wrap around its end
+	typedef struct {
+		const uint8_t *data[2];
+		uint16_t length[2];
+	} Slice_t;
+
+	typedef struct {
+		Instance instance;
+		uint32_t baud_rate;
+		uint8_t rx_dma_channel;
+		uint8_t tx_dma_channel;
+		uint8_t *rx_buffer;
+		uint16_t rx_length;         // Bytes, even so the DMA's half transfer is half the ring, odd is refused
+		uint8_t *tx_buffer;
+		uint16_t tx_length;
+		uint32_t rx_timeout;        // Bit times without a start bit before RX_DATA, 0 for idle line only. Not on LPUART
+		FIFO_Threshold rx_threshold;        // Used by a direction without a DMA channel
+		FIFO_Threshold tx_threshold;
+		bool match_delimiter;       // A frame ends at each delimiter as well as at the receiver timeout
+		uint8_t delimiter;
+		Callback_t callback;        // Called from the interrupts with the Event bits
+		void *context;
+
+		volatile uint32_t rx_position;      // Where the ring had been written up to at the last update
+		volatile uint32_t rx_read_index;
+		volatile uint32_t rx_unread;
+		volatile uint32_t rx_received;      // Totals since init()
+		volatile uint32_t rx_overflows;     // Bytes overwritten before they were read
+		volatile uint32_t rx_errors;
+
+		volatile uint32_t frame_ends[MAX_FRAMES];  // rx_received at the end of each frame not yet taken
+		volatile uint8_t frame_head;
+		volatile uint8_t frame_count;
+		volatile uint32_t frames;           // Total since init()
+		volatile uint32_t frame_scanned;    // rx_received up to where the delimiter has been looked for
+
+		volatile uint32_t tx_write_index;
+		volatile uint32_t tx_read_index;
+		volatile uint32_t tx_count;         // Queued, including the transfer in flight
+		volatile uint32_t tx_in_flight;
+		volatile uint32_t tx_sent;
+		volatile uint32_t interrupts;       // USART & DMA interrupts served for the port
+	} Port_t;
+
+	static constexpr uint_fast8_t fifo_entries(const FIFO_Threshold threshold)
+	{
+		const uint8_t ENTRIES[] = {1, 2, 4, 6, 7, 8};
+		return ENTRIES[static_cast<uint8_t>(threshold)];
+	}
+
+	// Doc: RM0440-37.5.7 | BRR = f_ck / baud with 16x oversampling, at least 16.
+	// Doc: RM0440-38.4.7 | LPUART BRR = 256 * f_ck / baud, from 0x300 to 0xFFFFF. 0 when the rate can't be made
+	static constexpr uint32_t baud_divider(const Instance instance, const uint32_t kernel_frequency,
+	                                       const uint32_t baud_rate)
+	{
+		if (baud_rate == 0) {
+			return 0;
+		}
+		if (instance == Instance::LPUART_1) {
+			const uint64_t DIVIDER = (static_cast<uint64_t>(kernel_frequency) * 256 + baud_rate / 2) / baud_rate;
+			return (DIVIDER >= 0x300 && DIVIDER <= 0xFFFFF) ? static_cast<uint32_t>(DIVIDER) : 0;
+		}
+		const uint32_t DIVIDER = Chip::Clock::divider(kernel_frequency, baud_rate);
+		return (DIVIDER >= 16 && DIVIDER <= 0xFFFF) ? DIVIDER : 0;
+	}
+
+	static constexpr Chip::Clock::Domain clock_domain(const Instance instance)
+	{
+		return static_cast<Chip::Clock::Domain>(static_cast<uint8_t>(Chip::Clock::Domain::USART1_KERNEL)
+		                                        + static_cast<uint8_t>(instance));
+	}
+
+	// Doc: RM0440-13.3.2 | RX & TX requests are numbered in pairs from USART1
+	static constexpr DMA_Class::Request rx_request(const Instance instance)
+	{
+		return static_cast<DMA_Class::Request>(static_cast<uint8_t>(DMA_Class::Request::USART1_RX)
+		                                       + 2 * static_cast<uint8_t>(instance));
+	}
+
+	static constexpr DMA_Class::Request tx_request(const Instance instance)
+	{
+		return static_cast<DMA_Class::Request>(static_cast<uint8_t>(rx_request(instance)) + 1);
+	}
+
+	// Returns false when the port is already open or the baud rate can't be made from its kernel clock.
+	// The DMA channels are the caller's, allocated or reserved beforehand
+	static bool init(Port_t &port);
+	static void deinit(Port_t &port);
+
+	// Only valid until the next consume(), the DMA overwrites the oldest bytes once the ring is full
+	static Slice_t received(Port_t &port);
+	static void consume(Port_t &port, uint32_t bytes);
+	static uint32_t available(Port_t &port);
+
+	// The oldest whole frame still unread, empty when there is none. It is consume()d like any other bytes,
+	// delimiter included
+	static Slice_t next_frame(Port_t &port);
+
+	// Queues as much as fits & returns how much that was, from one context only
+	static uint32_t write(Port_t &port, const uint8_t *data, uint32_t length);
+
+	// Interrupts served per 1024 bytes received & sent since init()
+	static uint32_t interrupts_per_kb(const Port_t &port);
+
+	static void handle_interrupt(Instance instance);
+
+	static USART_TypeDef *registers(Instance instance);
+	static IRQn_Type irq(Instance instance);
+	static Chip::Clock::Gate clock_gate(Instance instance);
+
+private:
+	static Port_t *ports[NUM_INSTANCES];
+	static bool clock_subscribed;
+
+	static uint32_t update_received(Port_t &port);
+	static uint32_t receive(Port_t &port, uint32_t arrived);
+	static uint32_t end_frame(Port_t &port, uint32_t end);
+	static uint32_t find_delimiters(Port_t &port);
+	static Slice_t slice(const Port_t &port, uint32_t start, uint32_t length);
+	static uint32_t drain_rx_fifo(Port_t &port);
+	static uint32_t fill_tx_fifo(Port_t &port);
+	static void start_tx(Port_t &port);
+	static bool set_baud_rate(const Port_t &port);
+	static void notify(const Port_t &port, uint32_t events);
+	static void rx_callback(uint_fast8_t channel, DMA_Class::Event event, void *context);
+	static void tx_callback(uint_fast8_t channel, DMA_Class::Event event, void *context);
+	static void clock_listener(uint32_t changed_domains, void *context);
+};
+
+
+#endif //STM32G4_MODULE_LIBRARY_USART_HH
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+// File Name    : utest_waveform.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+#include "../waveform.hh"
+#include "../../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+TEST_CASE("Waveform functions", "[Waveform][PERIPHERAL]")
+{
+	using Waveform = Chip::Waveform;
+	Waveform::Waveform_t WAVEFORM = {.port=GPIOB, .timer=TIM6, .dma_channel=3, .started=false};
+	const uint16_t MASK = 0b0111;
+
+
+	SECTION("Waveform Encode Timeline") {
+		// Doc: RM0440-9.4.7
+		const Waveform::Edge_t EDGES[] = {
+			{.sample=0, .number=0, .level=1},
+			{.sample=2, .number=1, .level=1},
+			{.sample=2, .number=0, .level=0},
+			{.sample=3, .number=2, .level=1},
+		};
+		uint32_t buffer[5];
+		Waveform::encode(EDGES, 4, MASK, 0, buffer, 5);
+
+		REQUIRE(buffer[0] == Waveform::bsrr_word(0b001, MASK));
+		REQUIRE(buffer[1] == Waveform::bsrr_word(0b001, MASK));
+		REQUIRE(buffer[2] == Waveform::bsrr_word(0b010, MASK));
+		REQUIRE(buffer[3] == Waveform::bsrr_word(0b110, MASK));
+		REQUIRE(buffer[4] == Waveform::bsrr_word(0b110, MASK));
+		REQUIRE(Waveform::bsrr_word(0b110, MASK) == ((0b110) | (0b001 << 16)));
+	}
+
+
+	SECTION("Waveform One-Shot Playback") {
+		const uint32_t BUFFER[3] = {
+			Waveform::bsrr_word(0b101, MASK), Waveform::bsrr_word(0b010, MASK), Waveform::bsrr_word(0b000, MASK)
+		};
+		GPIOB->ODR = 0xFF00;
+		REQUIRE(Waveform::start(WAVEFORM, BUFFER, 3, Waveform::Playback::ONE_SHOT, 0, 99));
+		REQUIRE(TIM6->ARR == 99);
+		REQUIRE((TIM6->CR1 & 1) == 1);
+
+		const uint32_t EXPECTED_ODR[3] = {0xFF05, 0xFF02, 0xFF00};
+		for (auto expected: EXPECTED_ODR) {
+			REQUIRE(Waveform::busy(WAVEFORM));
+			trigger_DMA_request(static_cast<uint16_t>(DMA_Class::Request::TIM6_UP));
+			update_GPIO_BSRR();
+			REQUIRE(GPIOB->ODR == expected);
+		}
+		REQUIRE(!Waveform::busy(WAVEFORM));
+
+		// Further update events must not write past the end of the buffer
+		trigger_DMA_request(static_cast<uint16_t>(DMA_Class::Request::TIM6_UP));
+		update_GPIO_BSRR();
+		REQUIRE(GPIOB->ODR == 0xFF00);
+		Waveform::stop(WAVEFORM);
+	}
+
+
+	SECTION("Waveform Circular Playback") {
+		const uint32_t BUFFER[2] = {Waveform::bsrr_word(0b001, MASK), Waveform::bsrr_word(0b000, MASK)};
+		GPIOB->ODR = 0;
+		REQUIRE(Waveform::start(WAVEFORM, BUFFER, 2, Waveform::Playback::CIRCULAR, 0, 99));
+
+		for (uint_fast8_t i = 0; i < 10; i++) {
+			trigger_DMA_request(static_cast<uint16_t>(DMA_Class::Request::TIM6_UP));
+			update_GPIO_BSRR();
+			REQUIRE(GPIOB->ODR == ((i % 2) ? 0u : 1u));
+			REQUIRE(Waveform::busy(WAVEFORM));
+		}
+
+		Waveform::stop(WAVEFORM);
+		REQUIRE((TIM6->CR1 & 1) == 0);
+		REQUIRE((TIM6->DIER & (1 << 8)) == 0);
+	}
+
+
+	SECTION("Waveform Clock Ownership") {
+		// Restarting keeps the one reference, stopping drops it even when the counter already stopped itself
+		const uint32_t BUFFER[2] = {Waveform::bsrr_word(0b001, MASK), Waveform::bsrr_word(0b000, MASK)};
+		const uint8_t HELD = Chip::Clock::references(Chip::Clock::Gate::TIM6EN);
+		REQUIRE(Waveform::start(WAVEFORM, BUFFER, 2, Waveform::Playback::ONE_SHOT, 0, 99));
+		REQUIRE(Waveform::start(WAVEFORM, BUFFER, 2, Waveform::Playback::ONE_SHOT, 0, 99));
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM6EN) == HELD + 1);
+
+		Chip::HAL::clear_register(&TIM6->CR1, 1 << 0);
+		Waveform::stop(WAVEFORM);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM6EN) == HELD);
+		Waveform::stop(WAVEFORM);
+		REQUIRE(Chip::Clock::references(Chip::Clock::Gate::TIM6EN) == HELD);
+	}
+
+
+	SECTION("Waveform DMA Channel Reservation") {
+		// A second waveform on a channel that is taken fails & leaves the first one playing
+		const uint32_t BUFFER[2] = {Waveform::bsrr_word(0b001, MASK), Waveform::bsrr_word(0b000, MASK)};
+		Waveform::Waveform_t other = {.port=GPIOC, .timer=TIM7, .dma_channel=3, .started=false};
+		REQUIRE(Waveform::start(WAVEFORM, BUFFER, 2, Waveform::Playback::CIRCULAR, 0, 99));
+		REQUIRE(!Waveform::start(other, BUFFER, 2, Waveform::Playback::CIRCULAR, 0, 99));
+		REQUIRE(Waveform::busy(WAVEFORM));
+		Waveform::stop(other);
+		REQUIRE(DMA_Class::allocated(3));
+		REQUIRE(Waveform::busy(WAVEFORM));
+		Waveform::stop(WAVEFORM);
+		REQUIRE(!DMA_Class::allocated(3));
+	}
+}
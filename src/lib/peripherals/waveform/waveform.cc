@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+// File Name    : waveform.cc
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#include "waveform.hh"
+#include "../timer/timer.hh"
+#include "../../chip/stm32g491/stm32g491_chip.hh"
+
+
+
+/*
+ * Waveform encoder
+ */
+// Converts a list of pin edges, sorted by sample, into one BSRR word per sample.
+// Every word drives all pins in mask, so each word is self contained and the buffer can be replayed circularly.
+void Waveform_Class::encode(const Edge_t *const edges, const uint32_t num_edges, const uint16_t mask,
+                            const uint16_t initial_levels, uint32_t *const buffer, const uint32_t length)
+{
+	uint16_t levels = initial_levels;
+	uint32_t edge = 0;
+
+	for (uint32_t sample = 0; sample < length; sample++) {
+		while (edge < num_edges && edges[edge].sample <= sample) {
+			const uint16_t pin_mask = static_cast<uint16_t>(1 << edges[edge].number);
+			levels = edges[edge].level ? (levels | pin_mask) : (levels & static_cast<uint16_t>(~pin_mask));
+			edge++;
+		}
+		buffer[sample] = bsrr_word(levels, mask);
+	}
+}
+
+
+
+/*
+ * Waveform playback functions
+ */
+// Returns false when something else holds the DMA channel
+bool Waveform_Class::start(Waveform_t &waveform, const uint32_t *const buffer, const uint16_t length,
+                           const Playback playback, const uint16_t prescaler, const uint32_t auto_reload)
+{
+	stop(waveform);
+	if (!DMA_Class::reserve(waveform.dma_channel)) {
+		return false;
+	}
+
+	Timer_Class::set_clock(waveform.timer, Timer_Class::Clock_Status::ENABLED);
+	waveform.started = true;
+	Timer_Class::set_time_base(waveform.timer, prescaler, auto_reload);
+
+	// Doc: RM0440-12.4.7 | Word sized memory to BSRR transfers, one per update request
+	const DMA_Class::Transfer_Config_t CONFIG = {
+		.request=Timer_Class::update_request(waveform.timer),
+		.direction=DMA_Class::Direction::MEMORY_TO_PERIPHERAL,
+		.peripheral_width=DMA_Class::Data_Width::WORD,
+		.memory_width=DMA_Class::Data_Width::WORD,
+		.peripheral_increment=false,
+		.memory_increment=true,
+		.mode=(playback == Playback::CIRCULAR) ? DMA_Class::Transfer_Mode::CIRCULAR : DMA_Class::Transfer_Mode::NORMAL,
+		.priority=DMA_Class::Priority::VERY_HIGH
+	};
+	DMA_Class::configure(waveform.dma_channel, CONFIG);
+	DMA_Class::start(waveform.dma_channel, &waveform.port->BSRR, buffer, length);
+
+	// The first word is written on the first update event, one timer period after start
+	Timer_Class::set_update_dma(waveform.timer, true);
+	Timer_Class::start(waveform.timer);
+	return true;
+}
+
+
+// Only undoes what start() did, the timer & channel may be someone else's or the counter may have stopped by itself
+void Waveform_Class::stop(Waveform_t &waveform)
+{
+	if (!waveform.started) {
+		return;
+	}
+	waveform.started = false;
+	Timer_Class::stop(waveform.timer);
+	Timer_Class::set_update_dma(waveform.timer, false);
+	DMA_Class::free(waveform.dma_channel);
+	Timer_Class::set_clock(waveform.timer, Timer_Class::Clock_Status::DISABLED);
+}
+
+
+bool Waveform_Class::busy(const Waveform_t &waveform)
+{
+	// A circular buffer never runs out, a one-shot buffer is done once every word has been written
+	return DMA_Class::remaining(waveform.dma_channel) != 0;
+}
@@ -0,0 +1,67 @@
+//------------------------------------------------------------------------------
+// File Name    : waveform.hh
+// Authors      : Liam Lawrence
+// Created      : October 19, 2026
+// Project      : STM32G4 Module Library
+// License      : MIT
+// Copyright    : (C) 2023, Liam Lawrence
+//
+// Updated      : October 19, 2026
+//------------------------------------------------------------------------------
+
+#ifndef STM32G4_MODULE_LIBRARY_WAVEFORM_HH
+#define STM32G4_MODULE_LIBRARY_WAVEFORM_HH
+
+#include <cstdint>
+#include "../dma/dma.hh"
+
+#ifdef UNIT_TEST
+#include "../../chip/stm32g491/stm32g491_mock.hh"
+#else
+#include "../../../../include/stm32g491xx.h"
+#endif
+
+
+
+// Plays a precomputed buffer of BSRR words to a GPIO port, one word per timer update event.
+// The timer's update DMA request writes each word, so every pin in the word changes on the same bus cycle
+// and the output timing only depends on the timer, not on the CPU.
+class Waveform_Class {
+public:
+	enum class Playback {
+		ONE_SHOT,
+		CIRCULAR
+	};
+
+	typedef struct {
+		GPIO_TypeDef *port;         // Port whose BSRR is written
+		TIM_TypeDef *timer;         // Update event paces the output
+		uint8_t dma_channel;        // 0-7 DMA1, 8-15 DMA2
+		bool started;               // Set while start() holds the timer clock & the DMA channel
+	} Waveform_t;
+
+	typedef struct {
+		uint32_t sample;            // Buffer index the edge takes effect on
+		uint16_t number;            // Doc: RM0440-9.3.3 | 0-15
+		uint16_t level;             // 0 or 1
+	} Edge_t;
+
+	// Doc: RM0440-9.4.7 | Drives every pin in mask to its level in levels, pins outside mask are left alone
+	static constexpr uint32_t bsrr_word(const uint16_t levels, const uint16_t mask)
+	{
+		return static_cast<uint32_t>(levels & mask) | (static_cast<uint32_t>(~levels & mask) << 16);
+	}
+
+	static void encode(const Edge_t *edges, uint32_t num_edges, uint16_t mask, uint16_t initial_levels,
+	                   uint32_t *buffer, uint32_t length);
+
+	static bool start(Waveform_t &waveform, const uint32_t *buffer, uint16_t length, Playback playback,
+	                  uint16_t prescaler, uint32_t auto_reload);
+	static void stop(Waveform_t &waveform);
+	static bool busy(const Waveform_t &waveform);
+
+private:
+};
+
+
+#endif //STM32G4_MODULE_LIBRARY_WAVEFORM_HH
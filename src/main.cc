@@ -6,41 +6,64 @@
 // License      : MIT
 // Copyright    : (C) 2023, Liam Lawrence
 //
-// Updated      : March 5, 2023
+// Updated      : October 19, 2026
 //------------------------------------------------------------------------------
 
 #include "lib/chip/stm32g491/stm32g491_chip.hh"
 
 
 
-int main()
+// Board description, compiled into a register image at build time
+using GPIO = Chip::GPIO;
+constexpr GPIO::PinId LED = {GPIO::Port::A, 5};
+constexpr GPIO::PinId BUTTON = {GPIO::Port::C, 13};
+
+constexpr auto BOARD = Chip::Board::Builder<16>()
+	.pin({.pin=LED, .mode=GPIO::Pin_Mode::OUTPUT, .otype=GPIO::Pin_OType::PUSH_PULL,
+	      .ospeed=GPIO::Pin_OSpeed::VERY_HIGH_SPEED, .pupd=GPIO::Pin_PUPD::PULL_DOWN, .af=GPIO::Pin_AF::AF0, .level=0})
+	.pin({.pin=BUTTON, .mode=GPIO::Pin_Mode::INPUT, .otype=GPIO::Pin_OType::PUSH_PULL,
+	      .ospeed=GPIO::Pin_OSpeed::VERY_LOW_SPEED, .pupd=GPIO::Pin_PUPD::NO_PULL_UP_DOWN, .af=GPIO::Pin_AF::AF0, .level=0});
+constexpr auto BOARD_IMAGE = BOARD.compile<BOARD.image_size()>();
+
+
+
+// The core sleeps between timeouts, a millisecond of wakeup latency is fine for a button & an LED
+constexpr uint32_t MAX_WAKEUP_LATENCY = 1000;
+constexpr uint64_t BUTTON_POLL_PERIOD = Chip::Idle::ticks(10000);
+constexpr uint64_t BLINK_PERIOD = Chip::Idle::ticks(250000);
+
+
+void blink(void *)
 {
-	Chip::init();
-	using GPIO = Chip::GPIO;
+	const GPIO::GPIO_Pin_t led_pin = LED;
+	if (GPIO::read(led_pin)) {
+		GPIO::clear(led_pin);
+	} else {
+		GPIO::set(led_pin);
+	}
+	Chip::Idle::schedule(Chip::Idle::now() + BLINK_PERIOD, blink, nullptr);
+}
 
-	// Define pins
-	GPIO::GPIO_Pin_t led_pin = {.port=GPIOA, .number=5};
-	GPIO::GPIO_Pin_t btn_pin = {.port=GPIOC, .number=13};
 
-	// Enable GPIO port clocks
-	GPIO::set_port_clock(led_pin.port, GPIO::Clock_Status::ENABLED);
-	GPIO::set_port_clock(btn_pin.port, GPIO::Clock_Status::ENABLED);
+void poll_button(void *)
+{
+	const GPIO::GPIO_Pin_t btn_pin = BUTTON;
+	if (GPIO::read(btn_pin)) {
+		blink(nullptr);
+	} else {
+		Chip::Idle::schedule(Chip::Idle::now() + BUTTON_POLL_PERIOD, poll_button, nullptr);
+	}
+}
 
-	// Configure pins
-	GPIO::set_mode(led_pin, GPIO::Pin_Mode::OUTPUT);
-	GPIO::set_ospeed(led_pin, GPIO::Pin_OSpeed::VERY_HIGH_SPEED);
-	GPIO::set_pupd(led_pin, GPIO::Pin_PUPD::PULL_DOWN);
-	GPIO::set_mode(btn_pin, GPIO::Pin_Mode::INPUT);
 
-	GPIO::clear(led_pin);
 
-	while (!GPIO::read(btn_pin)) {}
+int main()
+{
+	Chip::init(BOARD_IMAGE);
+	Chip::Idle::init();
 
+	poll_button(nullptr);
 	for (;;) {
-		if (GPIO::read(led_pin)) {
-			GPIO::clear(led_pin);
-		} else {
-			GPIO::set(led_pin);
-		}
+		Chip::Idle::idle(MAX_WAKEUP_LATENCY);
 	}
 }